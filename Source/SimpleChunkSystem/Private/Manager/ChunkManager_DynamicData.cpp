@@ -74,8 +74,10 @@ void UChunkManager_DynamicData::SetChannelDataByLocation(const FName InChannelNa
 		return;
 	}
 
-	FInstancedStruct& Target = ChunkSystem_DynamicData->FindOrAddChannel(InChannelName, InLocation, MutableStructType);
-	Target = InCellData;
+	const FCellChannelHandle Handle = TChunkSystem_DynamicData<>::ResolveChannel(InChannelName, MutableStructType);
+
+	// Rejected and logged by the system when the cell is outside of the chunk grid bounds.
+	ChunkSystem_DynamicData->SetChannelValue(Handle, InLocation, InCellData);
 }
 
 void UChunkManager_DynamicData::SetChannelDataByGridPoint(const FName InChannelName, const FIntPoint InGridPoint,
@@ -100,8 +102,10 @@ void UChunkManager_DynamicData::SetChannelDataByGridPoint(const FName InChannelN
 		return;
 	}
 
-	FInstancedStruct& Target = ChunkSystem_DynamicData->FindOrAddChannel(InChannelName, InGridPoint, MutableStructType);
-	Target = InCellData;
+	const FCellChannelHandle Handle = TChunkSystem_DynamicData<>::ResolveChannel(InChannelName, MutableStructType);
+
+	// Rejected and logged by the system when the cell is outside of the chunk grid bounds.
+	ChunkSystem_DynamicData->SetChannelValue(Handle, InGridPoint, InCellData);
 }
 
 FInstancedStruct UChunkManager_DynamicData::GetChannelDataByLocation(const FName InChannelName,
@@ -123,7 +127,8 @@ FInstancedStruct UChunkManager_DynamicData::GetChannelDataByLocation(const FName
 		return FInstancedStruct();
 	}
 
-	FInstancedStruct* InstancedPtr = ChunkSystem_DynamicData->GetChannel(InChannelName, InLocation, InExpectedStruct);
+	const FInstancedStruct* InstancedPtr = ChunkSystem_DynamicData->FindExistingChannel(InChannelName, InLocation,
+	                                                                                    InExpectedStruct);
 	if (!InstancedPtr)
 	{
 		SCHUNK_LOG(LogSChunkManager_DynamicData, Log,
@@ -155,7 +160,8 @@ FInstancedStruct UChunkManager_DynamicData::GetChannelDataByGridPoint(const FNam
 		return FInstancedStruct();
 	}
 
-	FInstancedStruct* InstancedPtr = ChunkSystem_DynamicData->GetChannel(InChannelName, InGridPoint, InExpectedStruct);
+	const FInstancedStruct* InstancedPtr = ChunkSystem_DynamicData->FindExistingChannel(InChannelName, InGridPoint,
+	                                                                                    InExpectedStruct);
 	if (!InstancedPtr)
 	{
 		SCHUNK_LOG(LogSChunkManager_DynamicData, Log,
@@ -411,6 +417,502 @@ bool UChunkManager_DynamicData::HasChannelByGridPoints(const FName InChannelName
 	return ChunkSystem_DynamicData->HasChannels(InChannelName, InGridPoints, InExpectedStruct);
 }
 
+FCellChannelHandle UChunkManager_DynamicData::ResolveChannelHandle(const FName InChannelName,
+                                                                   UScriptStruct* InExpectedStruct) const
+{
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return FCellChannelHandle();
+	}
+
+	return TChunkSystem_DynamicData<>::ResolveChannel(InChannelName, InExpectedStruct);
+}
+
+void UChunkManager_DynamicData::SetChannelDataByHandle(const FCellChannelHandle InHandle, const FIntPoint InGridPoint,
+                                                       const FInstancedStruct& InCellData)
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return;
+	}
+
+	if (!InHandle.IsValid())
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid Handle provided."));
+		return;
+	}
+
+	const UScriptStruct* HandleType = FCellChannelRegistry::Get().GetType(InHandle);
+	if (!InCellData.IsValid() || InCellData.GetScriptStruct() != HandleType)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("CellData does not match the type of the handle."));
+		return;
+	}
+
+	// Rejected and logged by the system when the cell is outside of the chunk grid bounds.
+	ChunkSystem_DynamicData->SetChannelValue(InHandle, InGridPoint, InCellData);
+}
+
+FInstancedStruct UChunkManager_DynamicData::GetChannelDataByHandle(const FCellChannelHandle InHandle,
+                                                                   const FIntPoint InGridPoint,
+                                                                   bool& bFound) const
+{
+	bFound = false;
+
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return FInstancedStruct();
+	}
+
+	const FInstancedStruct* InstancedPtr = AsConst(*ChunkSystem_DynamicData).GetChannel(InHandle, InGridPoint);
+	if (!InstancedPtr)
+	{
+		return FInstancedStruct();
+	}
+
+	bFound = true;
+	return *InstancedPtr;
+}
+
+bool UChunkManager_DynamicData::TryRemoveChannelByHandle(const FCellChannelHandle InHandle,
+                                                         const FIntPoint InGridPoint)
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return false;
+	}
+
+	return ChunkSystem_DynamicData->TryRemoveChannel(InHandle, InGridPoint);
+}
+
+bool UChunkManager_DynamicData::HasChannelByHandle(const FCellChannelHandle InHandle,
+                                                   const FIntPoint InGridPoint) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return false;
+	}
+
+	return ChunkSystem_DynamicData->HasChannel(InHandle, InGridPoint);
+}
+
+int32 UChunkManager_DynamicData::FillRegion(const FName InChannelName, const FIntRect InGridRegion,
+                                           const FInstancedStruct& InCellData)
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return 0;
+	}
+
+	if (!InCellData.IsValid())
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid CellData provided."));
+		return 0;
+	}
+
+	const UScriptStruct* StructType = InCellData.GetScriptStruct();
+	if (!StructType || !StructType->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Provided CellData is not derived from FCellBaseInfo."));
+		return 0;
+	}
+
+	return ChunkSystem_DynamicData->FillRegion(InChannelName, InGridRegion, InCellData);
+}
+
+int32 UChunkManager_DynamicData::ClearRegion(const FName InChannelName, const FIntRect InGridRegion,
+                                            UScriptStruct* InExpectedStruct)
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return 0;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return 0;
+	}
+
+	return ChunkSystem_DynamicData->ClearRegion(InChannelName, InGridRegion, InExpectedStruct);
+}
+
+TArray<FIntPoint> UChunkManager_DynamicData::QueryRegion(const FName InChannelName, const FIntRect InGridRegion,
+                                                        UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return TArray<FIntPoint>();
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return TArray<FIntPoint>();
+	}
+
+	return ChunkSystem_DynamicData->QueryRegion(InChannelName, InGridRegion, InExpectedStruct);
+}
+
+int32 UChunkManager_DynamicData::CountRegion(const FName InChannelName, const FIntRect InGridRegion,
+                                            UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return 0;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return 0;
+	}
+
+	return ChunkSystem_DynamicData->CountRegion(InChannelName, InGridRegion, InExpectedStruct);
+}
+
+bool UChunkManager_DynamicData::HasAnyInRegion(const FName InChannelName, const FIntRect InGridRegion,
+                                               UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return false;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return false;
+	}
+
+	return ChunkSystem_DynamicData->HasAnyInRegion(InChannelName, InGridRegion, InExpectedStruct);
+}
+
+TArray<FIntPoint> UChunkManager_DynamicData::QueryRadiusByLocation(const FName InChannelName, const FVector InLocation,
+                                                                  const float InRadius,
+                                                                  UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return TArray<FIntPoint>();
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return TArray<FIntPoint>();
+	}
+
+	return ChunkSystem_DynamicData->QueryRadius(InChannelName, InLocation, InRadius, InExpectedStruct);
+}
+
+TArray<FIntPoint> UChunkManager_DynamicData::QueryRadiusByGridPoint(const FName InChannelName,
+                                                                   const FIntPoint InGridPoint, const int32 InRadius,
+                                                                   UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return TArray<FIntPoint>();
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return TArray<FIntPoint>();
+	}
+
+	return ChunkSystem_DynamicData->QueryRadius(InChannelName, InGridPoint, InRadius, InExpectedStruct);
+}
+
+bool UChunkManager_DynamicData::RaycastByLocation(const FName InChannelName, const FVector InStart,
+                                                  const FVector InEnd, UScriptStruct* InExpectedStruct,
+                                                  FIntPoint& OutCell) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return false;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return false;
+	}
+
+	const FChunkRayHit Hit = ChunkSystem_DynamicData->Raycast(InChannelName, InStart, InEnd, InExpectedStruct);
+	OutCell = Hit.Cell;
+
+	return Hit.IsHit();
+}
+
+bool UChunkManager_DynamicData::RaycastByGridPoint(const FName InChannelName, const FIntPoint InStart,
+                                                   const FIntPoint InEnd, UScriptStruct* InExpectedStruct,
+                                                   FIntPoint& OutCell) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return false;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return false;
+	}
+
+	const FChunkRay Ray = TChunkSystem_DynamicData<>::MakeRay(InStart, InEnd);
+	const FChunkRayHit Hit = ChunkSystem_DynamicData->Raycast(InChannelName, Ray, InExpectedStruct);
+	OutCell = Hit.Cell;
+
+	return Hit.IsHit();
+}
+
+TArray<FIntPoint> UChunkManager_DynamicData::RaycastAllByLocation(const FName InChannelName, const FVector InStart,
+                                                                const FVector InEnd,
+                                                                UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return TArray<FIntPoint>();
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return TArray<FIntPoint>();
+	}
+
+	TArray<FIntPoint> Cells;
+	for (const FChunkRayHit& Hit : ChunkSystem_DynamicData->RaycastAll(InChannelName, InStart, InEnd, InExpectedStruct))
+	{
+		Cells.Add(Hit.Cell);
+	}
+
+	return Cells;
+}
+
+TArray<FIntPoint> UChunkManager_DynamicData::RaycastAllByGridPoint(const FName InChannelName,
+                                                                 const FIntPoint InStart, const FIntPoint InEnd,
+                                                                 UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return TArray<FIntPoint>();
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return TArray<FIntPoint>();
+	}
+
+	const FChunkRay Ray = TChunkSystem_DynamicData<>::MakeRay(InStart, InEnd);
+
+	TArray<FIntPoint> Cells;
+	for (const FChunkRayHit& Hit : ChunkSystem_DynamicData->RaycastAll(InChannelName, Ray, InExpectedStruct))
+	{
+		Cells.Add(Hit.Cell);
+	}
+
+	return Cells;
+}
+
+bool UChunkManager_DynamicData::FindNearestByLocation(const FName InChannelName, const FVector InLocation,
+                                                      UScriptStruct* InExpectedStruct, FIntPoint& OutCell) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return false;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return false;
+	}
+
+	const FChunkNearestCell Nearest = ChunkSystem_DynamicData->FindNearest(InChannelName, InLocation, InExpectedStruct);
+	OutCell = Nearest.Cell;
+
+	return Nearest.IsValid();
+}
+
+bool UChunkManager_DynamicData::FindNearestByGridPoint(const FName InChannelName, const FIntPoint InGridPoint,
+                                                       UScriptStruct* InExpectedStruct, FIntPoint& OutCell) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return false;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return false;
+	}
+
+	const FChunkNearestCell Nearest = ChunkSystem_DynamicData->FindNearest(InChannelName, InGridPoint, InExpectedStruct);
+	OutCell = Nearest.Cell;
+
+	return Nearest.IsValid();
+}
+
+TArray<FIntPoint> UChunkManager_DynamicData::FindKNearestByLocation(const FName InChannelName,
+                                                                  const FVector InLocation, const int32 InCount,
+                                                                  UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return TArray<FIntPoint>();
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return TArray<FIntPoint>();
+	}
+
+	const TArray<FChunkNearestCell> Nearest = ChunkSystem_DynamicData->FindKNearest(InChannelName, InLocation, InCount,
+	                                                                                InExpectedStruct);
+
+	TArray<FIntPoint> Cells;
+	Cells.Reserve(Nearest.Num());
+	for (const FChunkNearestCell& Cell : Nearest)
+	{
+		Cells.Add(Cell.Cell);
+	}
+
+	return Cells;
+}
+
+TArray<FIntPoint> UChunkManager_DynamicData::FindKNearestByGridPoint(const FName InChannelName,
+                                                                   const FIntPoint InGridPoint, const int32 InCount,
+                                                                   UScriptStruct* InExpectedStruct) const
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return TArray<FIntPoint>();
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return TArray<FIntPoint>();
+	}
+
+	const TArray<FChunkNearestCell> Nearest = ChunkSystem_DynamicData->FindKNearest(InChannelName, InGridPoint, InCount,
+	                                                                                InExpectedStruct);
+
+	TArray<FIntPoint> Cells;
+	Cells.Reserve(Nearest.Num());
+	for (const FChunkNearestCell& Cell : Nearest)
+	{
+		Cells.Add(Cell.Cell);
+	}
+
+	return Cells;
+}
+
+int32 UChunkManager_DynamicData::LabelComponents(const FName InChannelName, UScriptStruct* InExpectedStruct,
+                                                TMap<FIntPoint, int32>& OutCellComponents,
+                                                TArray<int32>& OutSizes) const
+{
+	OutCellComponents.Reset();
+	OutSizes.Reset();
+
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return 0;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return 0;
+	}
+
+	FChunkChannelComponents Components = ChunkSystem_DynamicData->LabelComponents(InChannelName, InExpectedStruct);
+	Components.ForEachCell([&OutCellComponents](const FIntPoint& Cell, const int32 Component)
+	{
+		OutCellComponents.Add(Cell, Component);
+	});
+
+	OutSizes = MoveTemp(Components.Sizes);
+	return OutSizes.Num();
+}
+
+bool UChunkManager_DynamicData::AddAggregateField(const FName InChannelName, UScriptStruct* InExpectedStruct,
+                                                  const FName InFieldName)
+{
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return false;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return false;
+	}
+
+	return ChunkSystem_DynamicData->AddAggregateField(InChannelName, InFieldName, InExpectedStruct);
+}
+
+int32 UChunkManager_DynamicData::AggregateRegion(const FName InChannelName, const FIntRect InGridRegion,
+                                                UScriptStruct* InExpectedStruct, double& OutSum, double& OutMin,
+                                                double& OutMax)
+{
+	OutSum = 0.0;
+	OutMin = 0.0;
+	OutMax = 0.0;
+
+	if (!ChunkSystem_DynamicData)
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Chunk system not initialized."));
+		return 0;
+	}
+
+	if (!InExpectedStruct || !InExpectedStruct->IsChildOf(FCellBaseInfo::StaticStruct()))
+	{
+		SCHUNK_LOG(LogSChunkManager_DynamicData, Warning, TEXT("Invalid ExpectedType provided."));
+		return 0;
+	}
+
+	const FChunkChannelAggregate Aggregate = ChunkSystem_DynamicData->AggregateRegion(InChannelName, InGridRegion,
+	                                                                                  InExpectedStruct);
+	if (Aggregate.IsEmpty())
+	{
+		return 0;
+	}
+
+	OutSum = Aggregate.Sum;
+	OutMin = Aggregate.Min;
+	OutMax = Aggregate.Max;
+	return Aggregate.Count;
+}
+
 bool UChunkManager_DynamicData::IsEmpty() const
 {
 	if (!ChunkSystem_DynamicData)
@@ -484,7 +986,10 @@ void UChunkManager_DynamicData::CreateChunkSystem()
 		ChunkSystem_DynamicData.Reset();
 	}
 
-	ChunkSystem_DynamicData = MakeShared<TChunkSystem_DynamicData<>>(StoredParams.WorldContext, StoredParams.ChunkSize);
+	ChunkSystem_DynamicData = MakeShared<TChunkSystem_DynamicData<>>(StoredParams.WorldContext, StoredParams.ChunkSize,
+	                                                                 CellStorageSettings);
+	ChunkSystem_DynamicData->SetChunkPoolSize(StoredParams.ChunkPoolSize);
+	ChunkSystem_DynamicData->SetChunkGridBounds(StoredParams.ChunkGridBounds);
 }
 
 void UChunkManager_DynamicData::OnInitialized()
@@ -4,6 +4,11 @@
 #include "System/Chunk/ChunkBase.h"
 
 FChunkBase::FChunkBase(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight)
+{
+	FChunkBase::Reset(InTopLeft, InBottomRight);
+}
+
+void FChunkBase::Reset(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight)
 {
 	const int32 MinX = FMath::Min(InTopLeft.X, InBottomRight.X);
 	const int32 MaxX = FMath::Max(InTopLeft.X, InBottomRight.X);
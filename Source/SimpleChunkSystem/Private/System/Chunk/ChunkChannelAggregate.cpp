@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/Chunk/ChunkChannelAggregate.h"
+
+#include "UObject/UnrealType.h"
+
+bool FChunkAggregateField::Make(const UScriptStruct* Type, const FName FieldName, FChunkAggregateField& OutField)
+{
+	OutField = FChunkAggregateField();
+
+	if (!Type)
+	{
+		return false;
+	}
+
+	if (FieldName.IsNone())
+	{
+		return true;
+	}
+
+	OutField.Property = FindFProperty<FNumericProperty>(Type, FieldName);
+	return OutField.Property != nullptr;
+}
+
+double FChunkAggregateField::GetValue(const void* StructMemory) const
+{
+	if (!Property || !StructMemory)
+	{
+		return 0.0;
+	}
+
+	const void* const ValuePtr = Property->ContainerPtrToValuePtr<void>(StructMemory);
+
+	if (Property->IsFloatingPoint())
+	{
+		return Property->GetFloatingPointPropertyValue(ValuePtr);
+	}
+
+	// Signed and unsigned integers as well as enums stored in one.
+	return Property->CanHoldValue(static_cast<int64>(-1))
+		       ? static_cast<double>(Property->GetSignedIntPropertyValue(ValuePtr))
+		       : static_cast<double>(Property->GetUnsignedIntPropertyValue(ValuePtr));
+}
@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/Chunk/ChunkChannelColumn.h"
+
+FChunkChannelColumn::FChunkChannelColumn(const UScriptStruct* InType, const int32 InNumCells)
+	: Type(InType)
+	  , NumCells(FMath::Max(InNumCells, 0))
+	  , Occupancy(FMath::Max(InNumCells, 0))
+{
+	check(Type);
+
+	Alignment = FMath::Max(Type->GetMinAlignment(), 1);
+	Stride = Align(Type->GetStructureSize(), Alignment);
+}
+
+FChunkChannelColumn::FChunkChannelColumn(const FChunkChannelColumn& Other)
+{
+	CopyFrom(Other);
+}
+
+FChunkChannelColumn::FChunkChannelColumn(FChunkChannelColumn&& Other) noexcept
+	: Type(Other.Type)
+	  , Stride(Other.Stride)
+	  , Alignment(Other.Alignment)
+	  , NumCells(Other.NumCells)
+	  , NumValues(Other.NumValues)
+	  , Data(Other.Data)
+	  , Occupancy(MoveTemp(Other.Occupancy))
+{
+	Other.Data = nullptr;
+	Other.NumValues = 0;
+	Other.Occupancy.Init(Other.NumCells);
+}
+
+FChunkChannelColumn& FChunkChannelColumn::operator=(const FChunkChannelColumn& Other)
+{
+	if (this != &Other)
+	{
+		Release();
+		CopyFrom(Other);
+	}
+
+	return *this;
+}
+
+FChunkChannelColumn& FChunkChannelColumn::operator=(FChunkChannelColumn&& Other) noexcept
+{
+	if (this != &Other)
+	{
+		Release();
+
+		Type = Other.Type;
+		Stride = Other.Stride;
+		Alignment = Other.Alignment;
+		NumCells = Other.NumCells;
+		NumValues = Other.NumValues;
+		Data = Other.Data;
+		Occupancy = MoveTemp(Other.Occupancy);
+
+		Other.Data = nullptr;
+		Other.NumValues = 0;
+		Other.Occupancy.Init(Other.NumCells);
+	}
+
+	return *this;
+}
+
+FChunkChannelColumn::~FChunkChannelColumn()
+{
+	Release();
+}
+
+uint8* FChunkChannelColumn::FindOrAdd(const int32 CellIndex)
+{
+	check(CellIndex >= 0 && CellIndex < NumCells);
+
+	if (!Data)
+	{
+		Allocate();
+	}
+
+	uint8* const Memory = GetMemory(CellIndex);
+	if (!Occupancy.Get(CellIndex))
+	{
+		Type->InitializeStruct(Memory);
+		Occupancy.Set(CellIndex);
+		++NumValues;
+	}
+
+	return Memory;
+}
+
+bool FChunkChannelColumn::Remove(const int32 CellIndex)
+{
+	if (!Contains(CellIndex))
+	{
+		return false;
+	}
+
+	Type->DestroyStruct(GetMemory(CellIndex));
+	Occupancy.Clear(CellIndex);
+	--NumValues;
+
+	return true;
+}
+
+void FChunkChannelColumn::Empty()
+{
+	Release();
+	Occupancy.Init(NumCells);
+}
+
+void FChunkChannelColumn::Allocate()
+{
+	check(!Data);
+
+	const SIZE_T Size = static_cast<SIZE_T>(NumCells) * Stride;
+	Data = static_cast<uint8*>(FMemory::Malloc(FMath::Max<SIZE_T>(Size, 1), Alignment));
+}
+
+void FChunkChannelColumn::Release()
+{
+	if (!Data)
+	{
+		return;
+	}
+
+	for (int32 Index = Occupancy.FindFrom(0); Index != INDEX_NONE; Index = Occupancy.FindFrom(Index + 1))
+	{
+		Type->DestroyStruct(GetMemory(Index));
+	}
+
+	FMemory::Free(Data);
+	Data = nullptr;
+	NumValues = 0;
+	Occupancy.Reset();
+}
+
+void FChunkChannelColumn::CopyFrom(const FChunkChannelColumn& Other)
+{
+	Type = Other.Type;
+	Stride = Other.Stride;
+	Alignment = Other.Alignment;
+	NumCells = Other.NumCells;
+	NumValues = 0;
+	Data = nullptr;
+	Occupancy.Init(NumCells);
+
+	const FChunkCellMask& OtherOccupancy = Other.GetOccupancy();
+	for (int32 Index = OtherOccupancy.FindFrom(0); Index != INDEX_NONE; Index = OtherOccupancy.FindFrom(Index + 1))
+	{
+		Type->CopyScriptStruct(FindOrAdd(Index), Other.GetMemory(Index));
+	}
+}
@@ -2,6 +2,31 @@
 
 #include "ChunkLogCategory.h"
 #include "Manager/ChunkManagerBase.h"
+#include "Misc/ScopeRWLock.h"
+#include "System/ChunkComponents.h"
+
+namespace ChunkDynamicData
+{
+	/**
+	 * Save layouts of FChunk_DynamicData. The baseline layout starts with the non negative cell count,
+	 * later layouts write their negated version in front of it.
+	 */
+	enum class ESaveVersion : int32
+	{
+		Baseline = 0,
+		AddedColumns = 1,
+
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	/** Handles are never released, so a key cached here stays valid for the life of the thread. */
+	TMap<FCellChannelKey, int32>& GetThreadHandleCache()
+	{
+		thread_local TMap<FCellChannelKey, int32> Cache;
+		return Cache;
+	}
+}
 
 void FCellChannelKey::Serialize(FArchive& Ar)
 {
@@ -41,6 +66,76 @@ void FCellChannelKey::Serialize(FArchive& Ar)
 	}
 }
 
+FCellChannelRegistry& FCellChannelRegistry::Get()
+{
+	static FCellChannelRegistry Registry;
+	return Registry;
+}
+
+FCellChannelHandle FCellChannelRegistry::FindOrAdd(const FCellChannelKey& Key)
+{
+	if (!Key.Type)
+	{
+		return FCellChannelHandle();
+	}
+
+	const FCellChannelHandle Found = Find(Key);
+	if (Found.IsValid())
+	{
+		return Found;
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	if (const int32* const Index = Handles.Find(Key))
+	{
+		return FCellChannelHandle(*Index);
+	}
+
+	const int32 Index = NumKeys.load(std::memory_order_relaxed);
+	checkf(Index < MaxPages * PageSize, TEXT("Too many channels resolved, %d"), Index);
+
+	TUniquePtr<FCellChannelKey[]>& Page = Pages[Index >> PageShift];
+	if (!Page)
+	{
+		Page = MakeUnique<FCellChannelKey[]>(PageSize);
+	}
+
+	Page[Index & (PageSize - 1)] = Key;
+	Handles.Add(Key, Index);
+
+	// Publishes the key to lock free readers.
+	NumKeys.store(Index + 1, std::memory_order_release);
+
+	ChunkDynamicData::GetThreadHandleCache().Add(Key, Index);
+	return FCellChannelHandle(Index);
+}
+
+FCellChannelHandle FCellChannelRegistry::Find(const FCellChannelKey& Key) const
+{
+	TMap<FCellChannelKey, int32>& Cache = ChunkDynamicData::GetThreadHandleCache();
+	if (const int32* const Cached = Cache.Find(Key))
+	{
+		return FCellChannelHandle(*Cached);
+	}
+
+	int32 Index;
+	{
+		FReadScopeLock ReadLock(Lock);
+
+		const int32* const Found = Handles.Find(Key);
+		if (!Found)
+		{
+			// Misses are not cached, the key may still be resolved later.
+			return FCellChannelHandle();
+		}
+
+		Index = *Found;
+	}
+
+	Cache.Add(Key, Index);
+	return FCellChannelHandle(Index);
+}
+
 bool FCellBaseInfo::Serialize(FArchive& Ar)
 {
 	return true;
@@ -50,9 +145,31 @@ void FCellBaseInfo::DrawDebug(const UWorld* World, const FVector& CellCenter) co
 {
 }
 
+FCellDynamicInfo::FCellDynamicInfo(const FCellDynamicInfo& Other)
+	: InlineChannels(Other.InlineChannels)
+{
+	if (Other.SpilledChannels)
+	{
+		SpilledChannels = MakeUnique<TMap<FCellChannelHandle, FInstancedStruct>>(*Other.SpilledChannels);
+	}
+}
+
+FCellDynamicInfo& FCellDynamicInfo::operator=(const FCellDynamicInfo& Other)
+{
+	if (this != &Other)
+	{
+		InlineChannels = Other.InlineChannels;
+		SpilledChannels = Other.SpilledChannels
+			                  ? MakeUnique<TMap<FCellChannelHandle, FInstancedStruct>>(*Other.SpilledChannels)
+			                  : nullptr;
+	}
+
+	return *this;
+}
+
 void FCellDynamicInfo::Serialize(FArchive& Ar)
 {
-	int32 Count = Channels.Num();
+	int32 Count = Num();
 	Ar << Count;
 
 	if (Count < 0)
@@ -68,23 +185,18 @@ void FCellDynamicInfo::Serialize(FArchive& Ar)
 
 	if (Ar.IsSaving())
 	{
-		for (TPair<FCellChannelKey, TOptional<FInstancedStruct>>& Iter : Channels)
+		const FCellChannelRegistry& Registry = FCellChannelRegistry::Get();
+		ForEachChannel([&Ar, &Registry](const FCellChannelHandle Handle, FInstancedStruct& Struct)
 		{
-			FCellChannelKey& Key = Iter.Key;
-			TOptional<FInstancedStruct>& OptStruct = Iter.Value;
-
+			FCellChannelKey Key = Registry.GetKey(Handle);
 			Key.Serialize(Ar);
 
-			bool bHasValue = OptStruct.IsSet();
+			// Kept for compatibility with data written while channels could be unset.
+			bool bHasValue = true;
 			Ar << bHasValue;
-			if (!bHasValue)
-			{
-				continue;
-			}
 
 			FName PackageName, AssetName;
 
-			FInstancedStruct& Struct = OptStruct.GetValue();
 			const UScriptStruct* Type = Struct.GetScriptStruct();
 			const FTopLevelAssetPath Path = Type->GetStructPathName();
 			PackageName = Path.GetPackageName();
@@ -95,14 +207,21 @@ void FCellDynamicInfo::Serialize(FArchive& Ar)
 
 			FCellBaseInfo* CellBaseInfoPtr = Struct.GetMutablePtr<FCellBaseInfo>();
 			CellBaseInfoPtr->Serialize(Ar);
-		}
+		});
 
 		return;
 	}
 
 	if (Ar.IsLoading())
 	{
-		Channels.Empty(Count);
+		InlineChannels.Reset();
+		SpilledChannels.Reset();
+
+		if (Count > InlineCapacity)
+		{
+			Spill();
+			SpilledChannels->Reserve(Count);
+		}
 
 		for (int32 Index = 0; Index < Count; ++Index)
 		{
@@ -114,7 +233,6 @@ void FCellDynamicInfo::Serialize(FArchive& Ar)
 
 			if (!bHasValue)
 			{
-				Channels.Add(Key);
 				continue;
 			}
 
@@ -143,80 +261,130 @@ void FCellDynamicInfo::Serialize(FArchive& Ar)
 				continue;
 			}
 
-			FInstancedStruct NewStruct;
-			NewStruct.InitializeAs(Type);
+			const FCellChannelHandle Handle = FCellChannelRegistry::Get().FindOrAdd(Key);
+			if (!Handle.IsValid())
+			{
+				SCHUNK_LOG(LogSChunkLocal, Error, TEXT("Failed to find channel type for channel '%s'"),
+				           *Key.ChannelName.ToString());
+				continue;
+			}
+
+			FInstancedStruct* Struct = FindChannel(Handle);
+			if (!Struct)
+			{
+				Struct = &AddChannel(Handle);
+			}
+
+			Struct->InitializeAs(Type);
 
-			FCellBaseInfo* CellBaseInfoPtr = NewStruct.GetMutablePtr<FCellBaseInfo>();
+			FCellBaseInfo* CellBaseInfoPtr = Struct->GetMutablePtr<FCellBaseInfo>();
 			CellBaseInfoPtr->Serialize(Ar);
-
-			Channels.Add(Key, NewStruct);
 		}
 	}
 }
 
 void FCellDynamicInfo::DrawDebug(const UWorld* World, const FVector& CellCenter) const
 {
-	for (const TPair<FCellChannelKey, TOptional<FInstancedStruct>>& Channel : Channels)
+	ForEachChannel([World, &CellCenter](const FCellChannelHandle, const FInstancedStruct& Struct)
 	{
-		if (!Channel.Value.IsSet())
-		{
-			continue;
-		}
+		Struct.GetPtr<FCellBaseInfo>()->DrawDebug(World, CellCenter);
+	});
+}
+
+FInstancedStruct& FCellDynamicInfo::AddChannel(const FCellChannelHandle Handle)
+{
+	checkf(Handle.IsValid(), TEXT("Channel handle is not valid"));
+
+	if (!SpilledChannels && InlineChannels.Num() < InlineCapacity)
+	{
+		FChannel& Channel = InlineChannels.AddDefaulted_GetRef();
+		Channel.Handle = Handle;
+		return Channel.Value;
+	}
 
-		Channel.Value->GetPtr<FCellBaseInfo>()->DrawDebug(World, CellCenter);
+	if (!SpilledChannels)
+	{
+		Spill();
 	}
+
+	return SpilledChannels->Add(Handle);
 }
 
-FChunk_DynamicData::FChunk_DynamicData(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight)
-	: FChunkBase(InTopLeft, InBottomRight)
+void FCellDynamicInfo::Spill()
 {
-	const FIntPoint& TL = GetTopLeft();
-	const FIntPoint& BR = GetBottomRight();
-
-	const int32 Width = BR.X - TL.X + 1;
-	const int32 Height = BR.Y - TL.Y + 1;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Spill)
 
-	check(Width > 0);
-	check(Height > 0);
+	check(!SpilledChannels);
 
-	Cells.Reserve(FMath::Max(Width, 0) * FMath::Max(Height, 0));
+	SpilledChannels = MakeUnique<TMap<FCellChannelHandle, FInstancedStruct>>();
+	SpilledChannels->Reserve(InlineCapacity + 1);
 
-	for (int32 X = TL.X; X <= BR.X; ++X)
+	for (FChannel& Channel : InlineChannels)
 	{
-		for (int32 Y = TL.Y; Y <= BR.Y; ++Y)
-		{
-			Cells.Emplace(FIntPoint{X, Y});
-		}
+		SpilledChannels->Add(Channel.Handle, MoveTemp(Channel.Value));
 	}
 
-	Cells.Shrink();
+	InlineChannels.Reset();
+}
+
+FChunk_DynamicData::FChunk_DynamicData(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight,
+                                       const FChunkCellStorageSettings& InStorageSettings)
+	: FChunkBase(InTopLeft, InBottomRight)
+	  , StorageSettings(InStorageSettings)
+{
+	InitializeCells();
 }
 
 void FChunk_DynamicData::Serialize(FArchive& Ar)
 {
 	Super::Serialize(Ar);
 
-	int32 Count = Cells.Num();
-	Ar << Count;
+	if (Ar.IsLoading())
+	{
+		// Bounds may have changed, the cell storage has to match them before reading cells back.
+		InitializeCells();
+	}
 
-	if (Count < 0)
+	int32 Count = 0;
+	if (Ar.IsSaving())
 	{
-		SCHUNK_LOG(LogSChunkLocal, Warning, TEXT("Can't serialize FChunk_DynamicData, %d < 0 in chunk at %s"), Count,
-		           *GetTopLeft().ToString());
+		ForEachCell([&Count](const FIntPoint&, const FCellDynamicInfo& CellInfo)
+		{
+			Count += CellInfo.IsEmpty() ? 0 : 1;
+		});
+	}
+
+	int32 VersionMarker = -static_cast<int32>(ChunkDynamicData::ESaveVersion::Latest);
+	Ar << VersionMarker;
+
+	ChunkDynamicData::ESaveVersion Version = ChunkDynamicData::ESaveVersion::Baseline;
+	if (VersionMarker < 0)
+	{
+		Version = static_cast<ChunkDynamicData::ESaveVersion>(-VersionMarker);
+		Ar << Count;
+	}
+	else
+	{
+		Count = VersionMarker;
+	}
+
+	if (Version > ChunkDynamicData::ESaveVersion::Latest)
+	{
+		SCHUNK_LOG(LogSChunkLocal, Error, TEXT("Can't load FChunk_DynamicData, unknown save version %d in chunk at %s"),
+		           -VersionMarker, *GetTopLeft().ToString());
+		Ar.SetError();
 		return;
 	}
 
-	if (Count == 0)
+	if (Count < 0)
 	{
-		Cells.Empty();
-		ChannelIndex.Empty();
+		SCHUNK_LOG(LogSChunkLocal, Warning, TEXT("Can't serialize FChunk_DynamicData, %d < 0 in chunk at %s"), Count,
+		           *GetTopLeft().ToString());
 		return;
 	}
 
 	if (Ar.IsLoading())
 	{
-		Cells.Empty(Count);
-
 		for (int32 Index = 0; Index < Count; ++Index)
 		{
 			FIntPoint Key;
@@ -225,86 +393,878 @@ void FChunk_DynamicData::Serialize(FArchive& Ar)
 			FCellDynamicInfo Value;
 			Value.Serialize(Ar);
 
-			Cells.Add(Key, Value);
+			if (!IsInside(Key))
+			{
+				SCHUNK_LOG(LogSChunkLocal, Warning, TEXT("Cell %s is outside of chunk at %s, skipped"),
+				           *Key.ToString(), *GetTopLeft().ToString());
+				continue;
+			}
+
+			if (Value.IsEmpty())
+			{
+				continue;
+			}
+
+			PrepareCellForWrite(Key);
+			FindOrAddCell(Key) = MoveTemp(Value);
 		}
 	}
 
 	if (Ar.IsSaving())
 	{
-		for (TPair<FIntPoint, FCellDynamicInfo>& Iter : Cells)
+		ForEachCell([&Ar](const FIntPoint& CellPoint, FCellDynamicInfo& CellInfo)
 		{
-			FIntPoint& Key = Iter.Key;
-			FCellDynamicInfo& Value = Iter.Value;
+			if (CellInfo.IsEmpty())
+			{
+				return;
+			}
 
+			FIntPoint Key = CellPoint;
 			Ar << Key;
-			Value.Serialize(Ar);
-		}
+			CellInfo.Serialize(Ar);
+		});
+	}
+
+	if (Version >= ChunkDynamicData::ESaveVersion::AddedColumns)
+	{
+		SerializeColumns(Ar);
 	}
 
 	RebuildChannelIndex();
 }
 
+void FChunk_DynamicData::Reset(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::Reset)
+
+	Super::Reset(InTopLeft, InBottomRight);
+
+	InitializeCells();
+	ChannelMasks.Reset();
+}
+
 void FChunk_DynamicData::DrawDebug(const UWorld* World, const TFunction<FVector(const FIntPoint&)>& Convertor) const
 {
 	Super::DrawDebug(World, Convertor);
 
-	for (const TPair<FIntPoint, FCellDynamicInfo>& Cell : Cells)
+	ForEachCell([World, &Convertor](const FIntPoint& CellPoint, const FCellDynamicInfo& CellInfo)
+	{
+		CellInfo.DrawDebug(World, Convertor(CellPoint));
+	});
+}
+
+void FChunk_DynamicData::InitializeCells()
+{
+	const FIntPoint& TL = GetTopLeft();
+	const FIntPoint& BR = GetBottomRight();
+
+	Width = BR.X - TL.X + 1;
+	Height = BR.Y - TL.Y + 1;
+
+	check(Width > 0);
+	check(Height > 0);
+
+	// Reset keeps the allocations around for chunks that are loaded again or recycled.
+	DenseCells.Reset();
+	MapCells.Reset();
+	Columns.Reset();
+	NumOccupiedCells = 0;
+
+	// Aggregates keep their fields, the summaries are rebuilt on next use.
+	for (FAggregateSummary& Summary : Aggregates)
+	{
+		Summary.bStale = true;
+	}
+
+	bDense = false;
+
+	if (StorageSettings.Storage == EChunkCellStorage::Dense)
 	{
-		Cell.Value.DrawDebug(World, Convertor(Cell.Key));
+		ConvertToDense();
 	}
 }
 
-void FChunk_DynamicData::RegisterChannelLocation(const FCellChannelKey& Key, const FIntPoint& CellPoint)
+void FChunk_DynamicData::PrepareCellForWrite(const FIntPoint& InCellPoint)
 {
-	if (!Key.Type)
+	const FCellDynamicInfo* const CellInfo = FindCell(InCellPoint);
+	if (CellInfo && !CellInfo->IsEmpty())
+	{
+		return;
+	}
+
+	++NumOccupiedCells;
+
+	if (!bDense && StorageSettings.Storage == EChunkCellStorage::Adaptive &&
+		NumOccupiedCells > StorageSettings.PromoteOccupancy * Width * Height)
 	{
+		ConvertToDense();
+	}
+}
+
+void FChunk_DynamicData::ReleaseCell(const FIntPoint& InCellPoint)
+{
+	--NumOccupiedCells;
+	check(NumOccupiedCells >= 0);
+
+	if (!bDense)
+	{
+		MapCells.Remove(GetCellIndex(InCellPoint));
 		return;
 	}
 
-	TSet<FIntPoint>& Locations = ChannelIndex.FindOrAdd(Key);
-	Locations.Add(CellPoint);
+	const float DemoteOccupancy = FMath::Min(StorageSettings.DemoteOccupancy, StorageSettings.PromoteOccupancy);
+	if (StorageSettings.Storage == EChunkCellStorage::Adaptive && NumOccupiedCells < DemoteOccupancy * Width * Height)
+	{
+		ConvertToMap();
+	}
+}
+
+void FChunk_DynamicData::ConvertToDense()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::ConvertToDense)
+
+	DenseCells.SetNum(Width * Height);
+
+	for (TPair<int32, FCellDynamicInfo>& Cell : MapCells)
+	{
+		DenseCells[Cell.Key] = MoveTemp(Cell.Value);
+	}
+
+	MapCells.Empty();
+	bDense = true;
+}
+
+void FChunk_DynamicData::ConvertToMap()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::ConvertToMap)
+
+	MapCells.Empty(NumOccupiedCells);
+
+	for (int32 Index = 0; Index < DenseCells.Num(); ++Index)
+	{
+		if (!DenseCells[Index].IsEmpty())
+		{
+			MapCells.Emplace(Index, MoveTemp(DenseCells[Index]));
+		}
+	}
+
+	DenseCells.Empty();
+	bDense = false;
+}
+
+FChunkChannelColumn& FChunk_DynamicData::FindOrAddColumn(const FCellChannelKey& Key)
+{
+	if (FChunkChannelColumn* const Column = Columns.Find(Key))
+	{
+		return *Column;
+	}
+
+	return Columns.Emplace(Key, FChunkChannelColumn(Key.Type, Width * Height));
 }
 
-void FChunk_DynamicData::UnregisterChannelLocation(const FCellChannelKey& Key, const FIntPoint& CellPoint)
+void FChunk_DynamicData::SerializeColumns(FArchive& Ar)
 {
-	if (TSet<FIntPoint>* const Locations = ChannelIndex.Find(Key))
+	int32 NumColumns = Columns.Num();
+	Ar << NumColumns;
+
+	if (NumColumns < 0)
+	{
+		SCHUNK_LOG(LogSChunkLocal, Warning, TEXT("Can't serialize columns, %d < 0 in chunk at %s"), NumColumns,
+		           *GetTopLeft().ToString());
+		return;
+	}
+
+	if (Ar.IsSaving())
 	{
-		Locations->Remove(CellPoint);
+		for (TPair<FCellChannelKey, FChunkChannelColumn>& Iter : Columns)
+		{
+			Iter.Key.Serialize(Ar);
+
+			FChunkChannelColumn& Column = Iter.Value;
+			int32 NumValues = Column.Num();
+			Ar << NumValues;
+
+			const FChunkCellMask& Occupancy = Column.GetOccupancy();
+			for (int32 Index = Occupancy.FindFrom(0); Index != INDEX_NONE; Index = Occupancy.FindFrom(Index + 1))
+			{
+				FIntPoint CellPoint = GetCellPoint(Index);
+				Ar << CellPoint;
+				reinterpret_cast<FCellBaseInfo*>(Column.GetMemory(Index))->Serialize(Ar);
+			}
+		}
+
+		return;
+	}
 
-		if (Locations->Num() == 0)
+	if (Ar.IsLoading())
+	{
+		for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
 		{
-			ChannelIndex.Remove(Key);
+			FCellChannelKey Key;
+			Key.Serialize(Ar);
+
+			int32 NumValues = 0;
+			Ar << NumValues;
+
+			// Values can't be skipped without knowing their layout, so the remaining data is unreadable.
+			if (!Key.Type || !Key.Type->IsChildOf(FCellBaseInfo::StaticStruct()) || NumValues < 0)
+			{
+				SCHUNK_LOG(LogSChunkLocal, Error, TEXT("Failed to load column '%s' in chunk at %s"),
+				           *Key.ChannelName.ToString(), *GetTopLeft().ToString());
+				Ar.SetError();
+				return;
+			}
+
+			FChunkChannelColumn& Column = FindOrAddColumn(Key);
+			FChunkChannelColumn Discard(Key.Type, 1);
+
+			for (int32 Index = 0; Index < NumValues; ++Index)
+			{
+				FIntPoint CellPoint;
+				Ar << CellPoint;
+
+				uint8* const Memory = IsInside(CellPoint)
+					                      ? Column.FindOrAdd(GetCellIndex(CellPoint))
+					                      : Discard.FindOrAdd(0);
+				reinterpret_cast<FCellBaseInfo*>(Memory)->Serialize(Ar);
+			}
+
+			if (Column.IsEmpty())
+			{
+				Columns.Remove(Key);
+			}
 		}
 	}
 }
 
-const TSet<FIntPoint>* FChunk_DynamicData::FindChannelLocations(const FCellChannelKey& Key) const
+void FChunk_DynamicData::RegisterChannelLocation(const FCellChannelHandle Handle, const FIntPoint& CellPoint)
 {
-	return ChannelIndex.Find(Key);
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	FChunkCellMask* Mask = ChannelMasks.Find(Handle);
+	if (!Mask)
+	{
+		Mask = &ChannelMasks.Emplace(Handle, FChunkCellMask(Width * Height));
+	}
+
+	Mask->Set(GetCellIndex(CellPoint));
 }
 
-TSet<FIntPoint>* FChunk_DynamicData::FindChannelLocations(const FCellChannelKey& Key)
+void FChunk_DynamicData::UnregisterChannelLocation(const FCellChannelHandle Handle, const FIntPoint& CellPoint)
 {
-	return ChannelIndex.Find(Key);
+	if (FChunkCellMask* const Mask = ChannelMasks.Find(Handle))
+	{
+		Mask->Clear(GetCellIndex(CellPoint));
+
+		if (Mask->IsEmpty())
+		{
+			ChannelMasks.Remove(Handle);
+		}
+	}
 }
 
-void FChunk_DynamicData::RebuildChannelIndex()
+bool FChunk_DynamicData::EvaluateQuery(const FChunkChannelQuery& Query, const FIntRect& Region,
+                                       FChunkCellMask& OutMask) const
 {
-	ChannelIndex.Empty();
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::EvaluateQuery)
+
+	const int32 NumCells = Width * Height;
+	OutMask.Init(NumCells);
+
+	const FIntPoint& TL = GetTopLeft();
+	const FIntRect Clipped = ClipRegion(Region);
+	if (Query.IsEmpty() || Clipped.IsEmpty())
+	{
+		return false;
+	}
 
-	for (const TPair<FIntPoint, FCellDynamicInfo>& Cell : Cells)
+	for (const FChunkChannelQuery::FTerm& Term : Query.GetTerms())
 	{
-		const FIntPoint& CellPoint = Cell.Key;
-		const FCellDynamicInfo& CellInfo = Cell.Value;
+		const FChunkCellMask* const Mask = ChannelMasks.Find(Term.Handle);
 
-		for (const TPair<FCellChannelKey, TOptional<FInstancedStruct>>& Channel : CellInfo.GetChannels())
+		switch (Term.Op)
 		{
-			if (!Channel.Value.IsSet())
+		case FChunkChannelQuery::EOp::And:
+			if (!Mask)
 			{
-				continue;
+				OutMask.Reset();
+				break;
+			}
+			OutMask.And(*Mask);
+			break;
+		case FChunkChannelQuery::EOp::Or:
+			if (Mask)
+			{
+				OutMask.Or(*Mask);
+			}
+			break;
+		case FChunkChannelQuery::EOp::AndNot:
+			if (Mask)
+			{
+				OutMask.AndNot(*Mask);
 			}
+			break;
+		}
+	}
 
-			RegisterChannelLocation(Channel.Key, CellPoint);
+	// Cells are X-major, every column of the region is one contiguous run of bits.
+	if (Clipped.Min.X > TL.X || Clipped.Min.Y > TL.Y || Clipped.Max.X < TL.X + Width || Clipped.Max.Y < TL.Y + Height)
+	{
+		FChunkCellMask RegionMask(NumCells);
+		for (int32 X = Clipped.Min.X; X < Clipped.Max.X; ++X)
+		{
+			RegionMask.SetRange(GetCellIndex(FIntPoint(X, Clipped.Min.Y)), Clipped.Max.Y - Clipped.Min.Y);
 		}
+
+		OutMask.And(RegionMask);
 	}
+
+	return !OutMask.IsEmpty();
+}
+
+void FChunk_DynamicData::QueryCells(const FChunkChannelQuery& Query, const FIntRect& Region,
+                                    TArray<FIntPoint>& OutCells) const
+{
+	FChunkCellMask Result;
+	if (!EvaluateQuery(Query, Region, Result))
+	{
+		return;
+	}
+
+	for (int32 Index = Result.FindFrom(0); Index != INDEX_NONE; Index = Result.FindFrom(Index + 1))
+	{
+		OutCells.Add(GetCellPoint(Index));
+	}
+}
+
+void FChunk_DynamicData::SetChannelValue(const FCellChannelHandle Handle, const FIntPoint& InCellPoint,
+                                         const FInstancedStruct& Value)
+{
+	const UScriptStruct* const Type = FCellChannelRegistry::Get().GetType(Handle);
+	checkf(Value.GetScriptStruct() == Type, TEXT("Value does not match the type of the channel"));
+
+	FCellDynamicInfo* const CellInfo = FindCell(InCellPoint);
+	if (FInstancedStruct* const Existing = CellInfo ? CellInfo->FindChannel(Handle) : nullptr)
+	{
+		ReplaceInAggregate(Handle, Existing, Value);
+
+		// Copied in place, the struct memory of the channel stays put.
+		Type->CopyScriptStruct(Existing->GetMutableMemory(), Value.GetMemory());
+		return;
+	}
+
+	PrepareCellForWrite(InCellPoint);
+	RegisterChannelLocation(Handle, InCellPoint);
+
+	FInstancedStruct& Added = FindOrAddCell(InCellPoint).GetOrAddChannel(Handle, Type);
+	Type->CopyScriptStruct(Added.GetMutableMemory(), Value.GetMemory());
+	ReplaceInAggregate(Handle, nullptr, Value);
+}
+
+int32 FChunk_DynamicData::FillRegion(const FCellChannelHandle Handle, const FIntRect& Region,
+                                     const FInstancedStruct& Value)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::FillRegion)
+
+	const FIntRect Clipped = ClipRegion(Region);
+	for (int32 X = Clipped.Min.X; X < Clipped.Max.X; ++X)
+	{
+		for (int32 Y = Clipped.Min.Y; Y < Clipped.Max.Y; ++Y)
+		{
+			SetChannelValue(Handle, FIntPoint(X, Y), Value);
+		}
+	}
+
+	return Clipped.Area();
+}
+
+int32 FChunk_DynamicData::ClearRegion(const FCellChannelHandle Handle, const FIntRect& Region)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::ClearRegion)
+
+	const FIntRect Clipped = ClipRegion(Region);
+
+	int32 Count = 0;
+	for (int32 X = Clipped.Min.X; X < Clipped.Max.X; ++X)
+	{
+		const int32 ColumnEnd = GetCellIndex(FIntPoint(X, Clipped.Max.Y - 1)) + 1;
+
+		// The mask is dropped with the last occurrence of the channel, so it is looked up again per column.
+		const FChunkCellMask* Mask = ChannelMasks.Find(Handle);
+		for (int32 Index = Mask ? Mask->FindFrom(GetCellIndex(FIntPoint(X, Clipped.Min.Y))) : INDEX_NONE;
+		     Index != INDEX_NONE && Index < ColumnEnd;)
+		{
+			TryRemoveChannel(Handle, GetCellPoint(Index));
+			++Count;
+
+			Mask = ChannelMasks.Find(Handle);
+			Index = Mask ? Mask->FindFrom(Index + 1) : INDEX_NONE;
+		}
+
+		if (!Mask)
+		{
+			break;
+		}
+	}
+
+	return Count;
+}
+
+int32 FChunk_DynamicData::CountRegion(const FCellChannelHandle Handle, const FIntRect& Region) const
+{
+	const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+	const FIntRect Clipped = ClipRegion(Region);
+	if (!Mask || Clipped.IsEmpty())
+	{
+		return 0;
+	}
+
+	// Cells are X-major, every column of the region is one contiguous run of bits.
+	int32 Count = 0;
+	for (int32 X = Clipped.Min.X; X < Clipped.Max.X; ++X)
+	{
+		Count += Mask->CountSetBitsInRange(GetCellIndex(FIntPoint(X, Clipped.Min.Y)), Clipped.Height());
+	}
+
+	return Count;
+}
+
+bool FChunk_DynamicData::HasAnyInRegion(const FCellChannelHandle Handle, const FIntRect& Region) const
+{
+	const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+	const FIntRect Clipped = ClipRegion(Region);
+	if (!Mask || Clipped.IsEmpty())
+	{
+		return false;
+	}
+
+	for (int32 X = Clipped.Min.X; X < Clipped.Max.X; ++X)
+	{
+		if (Mask->AnySetBitsInRange(GetCellIndex(FIntPoint(X, Clipped.Min.Y)), Clipped.Height()))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FChunk_DynamicData::QueryDisc(const FCellChannelHandle Handle, const FVector2D& Center, const double Radius,
+                                   TArray<FIntPoint>& OutCells) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::QueryDisc)
+
+	const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+	if (!Mask || Radius < 0.0)
+	{
+		return;
+	}
+
+	const FIntPoint& TL = GetTopLeft();
+	const FIntPoint& BR = GetBottomRight();
+	const double RadiusSquared = Radius * Radius;
+
+	// Every test goes through these offsets of the cell centers, so chunk wide and per cell decisions agree.
+	const auto OffsetX = [&Center](const int64 X) { return static_cast<double>(X) + 0.5 - Center.X; };
+	const auto OffsetY = [&Center](const int64 Y) { return static_cast<double>(Y) + 0.5 - Center.Y; };
+
+	// The nearest cell center rejects the whole chunk, the farthest one accepts it.
+	const double NearX = FMath::Max3(OffsetX(TL.X), 0.0, -OffsetX(BR.X));
+	const double NearY = FMath::Max3(OffsetY(TL.Y), 0.0, -OffsetY(BR.Y));
+	if (NearX * NearX + NearY * NearY > RadiusSquared)
+	{
+		return;
+	}
+
+	const double FarX = FMath::Max(FMath::Abs(OffsetX(TL.X)), FMath::Abs(OffsetX(BR.X)));
+	const double FarY = FMath::Max(FMath::Abs(OffsetY(TL.Y)), FMath::Abs(OffsetY(BR.Y)));
+	if (FarX * FarX + FarY * FarY <= RadiusSquared)
+	{
+		for (int32 Index = Mask->FindFrom(0); Index != INDEX_NONE; Index = Mask->FindFrom(Index + 1))
+		{
+			OutCells.Add(GetCellPoint(Index));
+		}
+
+		return;
+	}
+
+	// Cells are X-major, the disc covers one contiguous run of bits per column.
+	for (int32 X = TL.X; X <= BR.X; ++X)
+	{
+		const double DeltaX = OffsetX(X);
+		const double Remaining = RadiusSquared - DeltaX * DeltaX;
+		if (Remaining < 0.0)
+		{
+			continue;
+		}
+
+		const auto IsInside = [DeltaX, RadiusSquared, &OffsetY](const int64 Y)
+		{
+			const double DeltaY = OffsetY(Y);
+			return DeltaX * DeltaX + DeltaY * DeltaY <= RadiusSquared;
+		};
+
+		// The rounded square root may leave either end of the run one cell off.
+		const double HalfHeight = FMath::Sqrt(Remaining);
+		int64 MinY = static_cast<int64>(FMath::Clamp(FMath::CeilToDouble(Center.Y - 0.5 - HalfHeight),
+		                                             static_cast<double>(TL.Y), static_cast<double>(BR.Y) + 1.0));
+		int64 MaxY = static_cast<int64>(FMath::Clamp(FMath::FloorToDouble(Center.Y - 0.5 + HalfHeight),
+		                                             static_cast<double>(TL.Y) - 1.0, static_cast<double>(BR.Y)));
+
+		while (MinY > TL.Y && IsInside(MinY - 1))
+		{
+			--MinY;
+		}
+		while (MinY <= MaxY && !IsInside(MinY))
+		{
+			++MinY;
+		}
+		while (MaxY < BR.Y && IsInside(MaxY + 1))
+		{
+			++MaxY;
+		}
+		while (MaxY >= MinY && !IsInside(MaxY))
+		{
+			--MaxY;
+		}
+
+		if (MinY > MaxY)
+		{
+			continue;
+		}
+
+		const int32 EndIndex = GetCellIndex(FIntPoint(X, static_cast<int32>(MaxY)));
+		for (int32 Index = Mask->FindFrom(GetCellIndex(FIntPoint(X, static_cast<int32>(MinY))));
+		     Index != INDEX_NONE && Index <= EndIndex; Index = Mask->FindFrom(Index + 1))
+		{
+			OutCells.Add(GetCellPoint(Index));
+		}
+	}
+}
+
+bool FChunk_DynamicData::TraceFirst(const FCellChannelHandle Handle, FChunkGridTraversal& Traversal) const
+{
+	const FIntPoint& TL = GetTopLeft();
+	const FIntPoint& BR = GetBottomRight();
+
+	const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+	if (!Mask)
+	{
+		Traversal.SkipBox(TL, BR);
+		return false;
+	}
+
+	for (; !Traversal.IsDone() && Traversal.IsInBox(TL, BR); Traversal.Step())
+	{
+		if (Mask->Get(GetCellIndex(Traversal.GetCell())))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FChunk_DynamicData::TraceAll(const FCellChannelHandle Handle, FChunkGridTraversal& Traversal,
+                                  TArray<FChunkRayHit>& OutHits) const
+{
+	const FIntPoint& TL = GetTopLeft();
+	const FIntPoint& BR = GetBottomRight();
+
+	const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+	if (!Mask)
+	{
+		Traversal.SkipBox(TL, BR);
+		return;
+	}
+
+	for (; !Traversal.IsDone() && Traversal.IsInBox(TL, BR); Traversal.Step())
+	{
+		if (Mask->Get(GetCellIndex(Traversal.GetCell())))
+		{
+			OutHits.Emplace(Traversal.GetCell(), Traversal.GetEntryTime());
+		}
+	}
+}
+
+int32 FChunk_DynamicData::LabelComponents(const FCellChannelHandle Handle, TArray<int32>& OutLabels,
+                                          TArray<int32>& OutSizes) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::LabelComponents)
+
+	OutLabels.Init(INDEX_NONE, Width * Height);
+	OutSizes.Reset();
+
+	const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+	if (!Mask)
+	{
+		return 0;
+	}
+
+	// Cells are X-major, each cell joins its neighbours at X - 1 and Y - 1.
+	TArray<int32> Parents;
+	Parents.SetNumUninitialized(Width * Height);
+
+	for (int32 Index = Mask->FindFrom(0); Index != INDEX_NONE; Index = Mask->FindFrom(Index + 1))
+	{
+		Parents[Index] = Index;
+
+		if (Index >= Height && Mask->Get(Index - Height))
+		{
+			ChunkComponents::Union(Parents, Index, Index - Height);
+		}
+
+		if (Index % Height != 0 && Mask->Get(Index - 1))
+		{
+			ChunkComponents::Union(Parents, Index, Index - 1);
+		}
+	}
+
+	// Roots are the smallest index of their set, so they are labeled before the rest of it.
+	for (int32 Index = Mask->FindFrom(0); Index != INDEX_NONE; Index = Mask->FindFrom(Index + 1))
+	{
+		const int32 Root = ChunkComponents::FindRoot(Parents, Index);
+		OutLabels[Index] = Root == Index ? OutSizes.Add(0) : OutLabels[Root];
+		++OutSizes[OutLabels[Index]];
+	}
+
+	return OutSizes.Num();
+}
+
+void FChunk_DynamicData::CollectNearest(const FCellChannelHandle Handle, const FIntPoint& Origin, const int32 Count,
+                                        TArray<FChunkNearestCell>& Heap) const
+{
+	const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+	if (!Mask || Count <= 0)
+	{
+		return;
+	}
+
+	const FIntPoint& TL = GetTopLeft();
+	const FIntPoint& BR = GetBottomRight();
+
+	const int64 NearX = FMath::Max3<int64>(static_cast<int64>(TL.X) - Origin.X, 0, static_cast<int64>(Origin.X) - BR.X);
+	const int64 NearY = FMath::Max3<int64>(static_cast<int64>(TL.Y) - Origin.Y, 0, static_cast<int64>(Origin.Y) - BR.Y);
+	if (NearX * NearX + NearY * NearY > ChunkNearest::GetWorstDistanceSquared(Heap, Count))
+	{
+		return;
+	}
+
+	for (int32 Index = Mask->FindFrom(0); Index != INDEX_NONE; Index = Mask->FindFrom(Index + 1))
+	{
+		const FIntPoint Cell = GetCellPoint(Index);
+		const int64 DeltaX = static_cast<int64>(Cell.X) - Origin.X;
+		const int64 DeltaY = static_cast<int64>(Cell.Y) - Origin.Y;
+
+		ChunkNearest::Offer(Heap, Count, FChunkNearestCell(Cell, DeltaX * DeltaX + DeltaY * DeltaY));
+	}
+}
+
+void FChunk_DynamicData::AddAggregateField(const FCellChannelHandle Handle, const FChunkAggregateField& Field)
+{
+	FAggregateSummary* Summary = FindAggregate(Handle);
+	if (!Summary)
+	{
+		Summary = &Aggregates.AddDefaulted_GetRef();
+		Summary->Handle = Handle;
+	}
+
+	Summary->Field = Field;
+	Summary->bStale = true;
+}
+
+FChunkChannelAggregate FChunk_DynamicData::GetAggregate(const FCellChannelHandle Handle)
+{
+	FAggregateSummary* const Summary = FindAggregate(Handle);
+	if (!Summary)
+	{
+		return AsConst(*this).GetAggregate(Handle);
+	}
+
+	if (Summary->bStale)
+	{
+		const FIntRect Whole(GetTopLeft(), GetTopLeft() + FIntPoint(Width, Height));
+		Summary->Value = ComputeAggregate(Handle, Summary->Field, Whole);
+		Summary->bStale = false;
+	}
+
+	return Summary->Value;
+}
+
+FChunkChannelAggregate FChunk_DynamicData::GetAggregate(const FCellChannelHandle Handle) const
+{
+	const FAggregateSummary* const Summary = FindAggregate(Handle);
+	if (Summary && !Summary->bStale)
+	{
+		return Summary->Value;
+	}
+
+	const FIntRect Whole(GetTopLeft(), GetTopLeft() + FIntPoint(Width, Height));
+	return ComputeAggregate(Handle, Summary ? Summary->Field : FChunkAggregateField(), Whole);
+}
+
+FChunkChannelAggregate FChunk_DynamicData::AggregateRegion(const FCellChannelHandle Handle, const FIntRect& Region)
+{
+	const FIntRect Clipped = ClipRegion(Region);
+	if (Clipped.Width() == Width && Clipped.Height() == Height)
+	{
+		return GetAggregate(Handle);
+	}
+
+	return AsConst(*this).AggregateRegion(Handle, Region);
+}
+
+FChunkChannelAggregate FChunk_DynamicData::AggregateRegion(const FCellChannelHandle Handle,
+                                                           const FIntRect& Region) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::AggregateRegion)
+
+	const FIntRect Clipped = ClipRegion(Region);
+	if (Clipped.IsEmpty())
+	{
+		return FChunkChannelAggregate();
+	}
+
+	if (Clipped.Width() == Width && Clipped.Height() == Height)
+	{
+		return GetAggregate(Handle);
+	}
+
+	const FAggregateSummary* const Summary = FindAggregate(Handle);
+	return ComputeAggregate(Handle, Summary ? Summary->Field : FChunkAggregateField(), Clipped);
+}
+
+void FChunk_DynamicData::RemoveFromAggregate(const FCellChannelHandle Handle, const FInstancedStruct* Value)
+{
+	FAggregateSummary* const Summary = FindAggregate(Handle);
+	if (!Summary || Summary->bStale || !Value)
+	{
+		return;
+	}
+
+	FChunkChannelAggregate& Aggregate = Summary->Value;
+
+	if (--Aggregate.Count == 0)
+	{
+		Aggregate = FChunkChannelAggregate();
+		return;
+	}
+
+	if (!Summary->Field.Property)
+	{
+		return;
+	}
+
+	const double FieldValue = Summary->Field.GetValue(Value->GetMemory());
+
+	Aggregate.Sum -= FieldValue;
+
+	// The next extreme is unknown without a scan.
+	if (FieldValue <= Aggregate.Min || FieldValue >= Aggregate.Max)
+	{
+		Summary->bStale = true;
+	}
+}
+
+void FChunk_DynamicData::ReplaceInAggregate(const FCellChannelHandle Handle, const FInstancedStruct* OldValue,
+                                            const FInstancedStruct& NewValue)
+{
+	FAggregateSummary* const Summary = FindAggregate(Handle);
+	if (!Summary || Summary->bStale)
+	{
+		return;
+	}
+
+	FChunkChannelAggregate& Aggregate = Summary->Value;
+
+	if (!Summary->Field.Property)
+	{
+		Aggregate.Count += OldValue ? 0 : 1;
+		return;
+	}
+
+	const double NewFieldValue = Summary->Field.GetValue(NewValue.GetMemory());
+	if (!OldValue)
+	{
+		Aggregate.Add(NewFieldValue);
+		return;
+	}
+
+	if (Aggregate.Count == 1)
+	{
+		Aggregate = FChunkChannelAggregate();
+		Aggregate.Add(NewFieldValue);
+		return;
+	}
+
+	const double OldFieldValue = Summary->Field.GetValue(OldValue->GetMemory());
+
+	Aggregate.Sum += NewFieldValue - OldFieldValue;
+
+	// An extreme moving inwards leaves the next one unknown without a scan.
+	if ((OldFieldValue <= Aggregate.Min && NewFieldValue > OldFieldValue) ||
+		(OldFieldValue >= Aggregate.Max && NewFieldValue < OldFieldValue))
+	{
+		Summary->bStale = true;
+		return;
+	}
+
+	Aggregate.Min = FMath::Min(Aggregate.Min, NewFieldValue);
+	Aggregate.Max = FMath::Max(Aggregate.Max, NewFieldValue);
+}
+
+FChunkChannelAggregate FChunk_DynamicData::ComputeAggregate(const FCellChannelHandle Handle,
+                                                            const FChunkAggregateField& Field,
+                                                            const FIntRect& Clipped) const
+{
+	FChunkChannelAggregate Aggregate;
+
+	const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+	if (!Mask || Clipped.IsEmpty())
+	{
+		return Aggregate;
+	}
+
+	// Cells are X-major, every column of the region is one contiguous run of bits.
+	for (int32 X = Clipped.Min.X; X < Clipped.Max.X; ++X)
+	{
+		const int32 StartIndex = GetCellIndex(FIntPoint(X, Clipped.Min.Y));
+		const int32 EndIndex = StartIndex + Clipped.Height();
+
+		if (!Field.Property)
+		{
+			Aggregate.Count += Mask->CountSetBitsInRange(StartIndex, Clipped.Height());
+			continue;
+		}
+
+		for (int32 Index = Mask->FindFrom(StartIndex); Index != INDEX_NONE && Index < EndIndex;
+		     Index = Mask->FindFrom(Index + 1))
+		{
+			const FInstancedStruct* const Value = FindChannel(Handle, GetCellPoint(Index));
+			Aggregate.Add(Value ? Field.GetValue(Value->GetMemory()) : 0.0);
+		}
+	}
+
+	return Aggregate;
+}
+
+void FChunk_DynamicData::RebuildChannelIndex()
+{
+	ChannelMasks.Empty();
+
+	for (FAggregateSummary& Summary : Aggregates)
+	{
+		Summary.bStale = true;
+	}
+
+	ForEachCell([this](const FIntPoint& CellPoint, const FCellDynamicInfo& CellInfo)
+	{
+		CellInfo.ForEachChannel([this, &CellPoint](const FCellChannelHandle Handle, const FInstancedStruct&)
+		{
+			RegisterChannelLocation(Handle, CellPoint);
+		});
+	});
 }
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/ChunkComponents.h"
+
+int32 FChunkChannelComponents::GetComponent(const FIntPoint& InCell) const
+{
+	if (ChunkSize <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const FIntPoint ChunkPoint(FMath::FloorToInt(static_cast<double>(InCell.X) / ChunkSize),
+	                           FMath::FloorToInt(static_cast<double>(InCell.Y) / ChunkSize));
+
+	const TArray<int32>* const Labels = ChunkLabels.Find(ChunkPoint);
+	if (!Labels)
+	{
+		return INDEX_NONE;
+	}
+
+	const FIntPoint Local = InCell - ChunkPoint * ChunkSize;
+	return (*Labels)[Local.X * ChunkSize + Local.Y];
+}
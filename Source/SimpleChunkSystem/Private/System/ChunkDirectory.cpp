@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/ChunkDirectory.h"
+
+void FChunkPointTable::Add(const FIntPoint& Point, const int32 Value)
+{
+	check(Value != INDEX_NONE);
+
+	if (GetBucketCount(Count + 1) > Buckets.Num())
+	{
+		Rehash(GetBucketCount(Count + 1));
+	}
+
+	FBucket Bucket;
+	Bucket.Key = ChunkDirectory::PackPoint(Point);
+	Bucket.Value = Value;
+
+	Insert(Bucket);
+	++Count;
+}
+
+bool FChunkPointTable::RemoveAndCopyValue(const FIntPoint& Point, int32& OutValue)
+{
+	if (Count == 0)
+	{
+		return false;
+	}
+
+	const uint64 Key = ChunkDirectory::PackPoint(Point);
+	const uint32 Mask = Buckets.Num() - 1;
+
+	uint32 Hole = GetHomeBucket(Key);
+	for (uint32 Distance = 0; ; Hole = (Hole + 1) & Mask, ++Distance)
+	{
+		const FBucket& Bucket = Buckets[Hole];
+		if (Bucket.Value == INDEX_NONE || Bucket.Distance < Distance)
+		{
+			return false;
+		}
+
+		if (Bucket.Key == Key)
+		{
+			break;
+		}
+	}
+
+	OutValue = Buckets[Hole].Value;
+	--Count;
+
+	// Shift the displaced tail of the run back so lookups never stop early at the hole.
+	for (uint32 Next = (Hole + 1) & Mask; Buckets[Next].Value != INDEX_NONE && Buckets[Next].Distance > 0;
+	     Next = (Next + 1) & Mask)
+	{
+		Buckets[Hole] = Buckets[Next];
+		--Buckets[Hole].Distance;
+		Hole = Next;
+	}
+
+	Buckets[Hole] = FBucket();
+	return true;
+}
+
+void FChunkPointTable::Empty(const int32 ExpectedNumElements)
+{
+	Buckets.Empty();
+	Count = 0;
+
+	if (ExpectedNumElements > 0)
+	{
+		Buckets.SetNum(GetBucketCount(ExpectedNumElements));
+	}
+}
+
+void FChunkPointTable::Reserve(const int32 Number)
+{
+	const int32 NumBuckets = GetBucketCount(Number);
+	if (NumBuckets > Buckets.Num())
+	{
+		Rehash(NumBuckets);
+	}
+}
+
+void FChunkPointTable::Shrink()
+{
+	if (Count == 0)
+	{
+		Buckets.Empty();
+		return;
+	}
+
+	const int32 NumBuckets = GetBucketCount(Count);
+	if (NumBuckets < Buckets.Num())
+	{
+		Rehash(NumBuckets);
+	}
+}
+
+int32 FChunkPointTable::GetMaxProbeLength() const
+{
+	int32 MaxLength = 0;
+	for (const FBucket& Bucket : Buckets)
+	{
+		if (Bucket.Value != INDEX_NONE)
+		{
+			MaxLength = FMath::Max<int32>(MaxLength, Bucket.Distance + 1);
+		}
+	}
+
+	return MaxLength;
+}
+
+int32 FChunkPointTable::GetBucketCount(const int32 NumElements)
+{
+	return NumElements > 0 ? FMath::Max(16, static_cast<int32>(FMath::RoundUpToPowerOfTwo(NumElements * 2))) : 0;
+}
+
+void FChunkPointTable::Rehash(const int32 NumBuckets)
+{
+	TArray<FBucket> OldBuckets = MoveTemp(Buckets);
+
+	Buckets.Empty();
+	Buckets.SetNum(NumBuckets);
+
+	for (FBucket& Bucket : OldBuckets)
+	{
+		if (Bucket.Value != INDEX_NONE)
+		{
+			Bucket.Distance = 0;
+			Insert(Bucket);
+		}
+	}
+}
+
+void FChunkPointTable::Insert(FBucket Bucket)
+{
+	const uint32 Mask = Buckets.Num() - 1;
+
+	// Robin Hood: the entry further from its home takes the bucket, the other one moves on.
+	for (uint32 Index = GetHomeBucket(Bucket.Key); ; Index = (Index + 1) & Mask)
+	{
+		FBucket& Resident = Buckets[Index];
+		if (Resident.Value == INDEX_NONE)
+		{
+			Resident = Bucket;
+			return;
+		}
+
+		if (Resident.Distance < Bucket.Distance)
+		{
+			Swap(Resident, Bucket);
+		}
+
+		++Bucket.Distance;
+	}
+}
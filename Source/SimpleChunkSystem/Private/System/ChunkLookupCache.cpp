@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/ChunkLookupCache.h"
+
+#include "HAL/PlatformTLS.h"
+#include "Misc/ScopeLock.h"
+
+uint64 ChunkLookupCache::MakeOwnerId()
+{
+	static std::atomic<uint64> NextOwnerId{1};
+	return NextOwnerId.fetch_add(1, std::memory_order_relaxed);
+}
+
+FChunkLookupCacheThreadCounters& FChunkLookupCacheCounters::GetThreadCounters()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TUniquePtr<FChunkLookupCacheThreadCounters>& Counters = ThreadCounters.FindOrAdd(FPlatformTLS::GetCurrentThreadId());
+	if (!Counters)
+	{
+		Counters = MakeUnique<FChunkLookupCacheThreadCounters>();
+	}
+
+	return *Counters;
+}
+
+FChunkLookupCacheStats FChunkLookupCacheCounters::Get() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FChunkLookupCacheStats Stats;
+	for (const TPair<uint32, TUniquePtr<FChunkLookupCacheThreadCounters>>& Pair : ThreadCounters)
+	{
+		Stats.Hits += Pair.Value->Hits.load(std::memory_order_relaxed);
+		Stats.Misses += Pair.Value->Misses.load(std::memory_order_relaxed);
+	}
+
+	return Stats;
+}
+
+void FChunkLookupCacheCounters::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	// Blocks stay allocated, cache entries of other threads still point at them.
+	for (const TPair<uint32, TUniquePtr<FChunkLookupCacheThreadCounters>>& Pair : ThreadCounters)
+	{
+		Pair.Value->Hits.store(0, std::memory_order_relaxed);
+		Pair.Value->Misses.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/ChunkRaycast.h"
+
+namespace ChunkRaycast
+{
+	constexpr double Never = TNumericLimits<double>::Max();
+}
+
+FChunkGridTraversal::FChunkGridTraversal(const FVector2D& InStart, const FVector2D& InEnd)
+	: Cell(FMath::FloorToInt(InStart.X), FMath::FloorToInt(InStart.Y))
+	  , EndCell(FMath::FloorToInt(InEnd.X), FMath::FloorToInt(InEnd.Y))
+{
+	const FVector2D Direction = InEnd - InStart;
+
+	for (int32 Axis = 0; Axis < 2; ++Axis)
+	{
+		if (Direction[Axis] > 0.0)
+		{
+			StepDir[Axis] = 1;
+			CrossingDelta[Axis] = 1.0 / Direction[Axis];
+			NextCrossing[Axis] = (Cell[Axis] + 1 - InStart[Axis]) / Direction[Axis];
+		}
+		else if (Direction[Axis] < 0.0)
+		{
+			StepDir[Axis] = -1;
+			CrossingDelta[Axis] = -1.0 / Direction[Axis];
+			NextCrossing[Axis] = (Cell[Axis] - InStart[Axis]) / Direction[Axis];
+		}
+		else
+		{
+			StepDir[Axis] = 0;
+			CrossingDelta[Axis] = ChunkRaycast::Never;
+			NextCrossing[Axis] = ChunkRaycast::Never;
+		}
+	}
+}
+
+void FChunkGridTraversal::Step()
+{
+	if (bDone || Cell == EndCell)
+	{
+		bDone = true;
+		return;
+	}
+
+	int32 Axis = NextCrossing.X < NextCrossing.Y ? 0 : 1;
+
+	// Rounding can make an axis look due first after it already reached the end cell.
+	if (Cell[Axis] == EndCell[Axis])
+	{
+		Axis = 1 - Axis;
+	}
+
+	EntryTime = FMath::Min(NextCrossing[Axis], 1.0);
+	Cell[Axis] += StepDir[Axis];
+	NextCrossing[Axis] += CrossingDelta[Axis];
+}
+
+void FChunkGridTraversal::SkipBox(const FIntPoint& InMin, const FIntPoint& InMax)
+{
+	if (bDone || (EndCell.X >= InMin.X && EndCell.X <= InMax.X && EndCell.Y >= InMin.Y && EndCell.Y <= InMax.Y))
+	{
+		bDone = true;
+		return;
+	}
+
+	// Boundaries to cross and the time the segment leaves the box along each axis.
+	int32 Crossings[2];
+	double Exit[2];
+	for (int32 Axis = 0; Axis < 2; ++Axis)
+	{
+		Crossings[Axis] = StepDir[Axis] > 0 ? InMax[Axis] + 1 - Cell[Axis] : Cell[Axis] - InMin[Axis] + 1;
+		Exit[Axis] = StepDir[Axis] != 0
+			             ? NextCrossing[Axis] + (Crossings[Axis] - 1) * CrossingDelta[Axis]
+			             : ChunkRaycast::Never;
+	}
+
+	// Same tie break as Step: on equal times the Y boundary is crossed first.
+	int32 ExitAxis = Exit[0] < Exit[1] ? 0 : 1;
+
+	// The end cell is outside of the box, the segment leaves through an axis on which the end is outside too.
+	if (EndCell[ExitAxis] >= InMin[ExitAxis] && EndCell[ExitAxis] <= InMax[ExitAxis])
+	{
+		ExitAxis = 1 - ExitAxis;
+	}
+
+	const int32 OtherAxis = 1 - ExitAxis;
+	const double ExitTime = FMath::Min(Exit[ExitAxis], 1.0);
+
+	// Boundaries of the other axis crossed before the exit, it stays inside the box.
+	int32 OtherCrossings = 0;
+	if (StepDir[OtherAxis] != 0)
+	{
+		const double Span = (ExitTime - NextCrossing[OtherAxis]) / CrossingDelta[OtherAxis];
+		if (ExitAxis == 0)
+		{
+			OtherCrossings = NextCrossing[OtherAxis] <= ExitTime ? FMath::FloorToInt(Span) + 1 : 0;
+		}
+		else
+		{
+			OtherCrossings = NextCrossing[OtherAxis] < ExitTime ? FMath::CeilToInt(Span) : 0;
+		}
+
+		OtherCrossings = FMath::Clamp(OtherCrossings, 0,
+		                              FMath::Min(Crossings[OtherAxis] - 1, FMath::Abs(EndCell[OtherAxis] - Cell[OtherAxis])));
+	}
+
+	Cell[ExitAxis] += Crossings[ExitAxis] * StepDir[ExitAxis];
+	NextCrossing[ExitAxis] += Crossings[ExitAxis] * CrossingDelta[ExitAxis];
+
+	Cell[OtherAxis] += OtherCrossings * StepDir[OtherAxis];
+	NextCrossing[OtherAxis] += OtherCrossings * CrossingDelta[OtherAxis];
+
+	EntryTime = ExitTime;
+}
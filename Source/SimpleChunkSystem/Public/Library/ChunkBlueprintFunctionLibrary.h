@@ -34,6 +34,24 @@ public:
 		return FIntPoint(X, Y);
 	}
 
+	/** Location in continuous grid space, cell (X, Y) covers [X, X + 1) x [Y, Y + 1). */
+	UFUNCTION(BlueprintCallable, Category = "ChunkSystem")
+	static FVector2D ConvertGlobalLocationToContinuousGrid(const UObject* InWorldContext,
+	                                                       const FVector& InGlobalLocation)
+	{
+		if (!InWorldContext || !InWorldContext->GetWorld())
+		{
+			SCHUNK_LOG(LogChunkLibrary, Warning, TEXT("Invalid world context provided."));
+		}
+
+		const FIntVector Origin = InWorldContext && InWorldContext->GetWorld()
+			                          ? InWorldContext->GetWorld()->OriginLocation
+			                          : FIntVector::ZeroValue;
+		const double CellSize = GetCellSize();
+
+		return FVector2D((InGlobalLocation.X - Origin.X) / CellSize, (InGlobalLocation.Y - Origin.Y) / CellSize);
+	}
+
 	UFUNCTION(BlueprintCallable, Category = "ChunkSystem")
 	static FVector2D ConvertGridToGlobalLocation(const UObject* InWorldContext, const FIntPoint& InGridPoint)
 	{
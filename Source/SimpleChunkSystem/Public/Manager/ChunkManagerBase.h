@@ -24,6 +24,17 @@ struct FChunkInitParameters
 	/** Size of a single chunk in grid cells. */
 	UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite)
 	int32 ChunkSize = 15;
+
+	/** Number of removed chunks kept for reuse by the system, 0 disables pooling. */
+	UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 ChunkPoolSize = 0;
+
+	/**
+	 * Chunk coordinates the world is limited to, Max is exclusive. Lookups inside
+	 * become a flat array index, cells outside are rejected. Empty for an unbounded world.
+	 */
+	UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite)
+	FIntRect ChunkGridBounds;
 };
 
 /**
@@ -104,6 +104,118 @@ public:
 	bool HasChannelByGridPoints(const FName InChannelName, const TSet<FIntPoint>& InGridPoints,
 	                            UScriptStruct* InExpectedStruct) const;
 
+	/** Resolves a channel once, handle based accessors skip hashing the name and type on every call. */
+	UFUNCTION(BlueprintPure, Category = "Chunk Manager")
+	FCellChannelHandle ResolveChannelHandle(const FName InChannelName, UScriptStruct* InExpectedStruct) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	void SetChannelDataByHandle(const FCellChannelHandle InHandle, const FIntPoint InGridPoint,
+	                            const FInstancedStruct& InCellData);
+
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	FInstancedStruct GetChannelDataByHandle(const FCellChannelHandle InHandle, const FIntPoint InGridPoint,
+	                                        bool& bFound) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	bool TryRemoveChannelByHandle(const FCellChannelHandle InHandle, const FIntPoint InGridPoint);
+
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	bool HasChannelByHandle(const FCellChannelHandle InHandle, const FIntPoint InGridPoint) const;
+
+	// Regions, rectangles are in grid cells with Max exclusive
+
+	/** Writes the data to the channel of every cell of the region, returns the number of cells written. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	int32 FillRegion(const FName InChannelName, const FIntRect InGridRegion, const FInstancedStruct& InCellData);
+
+	/** Removes the channel from every cell of the region, returns the number of cells it was removed from. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	int32 ClearRegion(const FName InChannelName, const FIntRect InGridRegion, UScriptStruct* InExpectedStruct);
+
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	TArray<FIntPoint> QueryRegion(const FName InChannelName, const FIntRect InGridRegion,
+	                              UScriptStruct* InExpectedStruct) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	int32 CountRegion(const FName InChannelName, const FIntRect InGridRegion, UScriptStruct* InExpectedStruct) const;
+
+	/** Whether any cell of the region holds the channel, cheaper than CountRegion for large regions. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	bool HasAnyInRegion(const FName InChannelName, const FIntRect InGridRegion, UScriptStruct* InExpectedStruct) const;
+
+	/** Cells holding the channel within the radius of the location, the radius is in world units. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	TArray<FIntPoint> QueryRadiusByLocation(const FName InChannelName, const FVector InLocation, const float InRadius,
+	                                        UScriptStruct* InExpectedStruct) const;
+
+	/** Cells holding the channel within the radius of the grid point, the radius is in cells. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	TArray<FIntPoint> QueryRadiusByGridPoint(const FName InChannelName, const FIntPoint InGridPoint,
+	                                         const int32 InRadius, UScriptStruct* InExpectedStruct) const;
+
+	/** First cell holding the channel on the segment between the locations. Returns false without a hit. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	bool RaycastByLocation(const FName InChannelName, const FVector InStart, const FVector InEnd,
+	                       UScriptStruct* InExpectedStruct, FIntPoint& OutCell) const;
+
+	/** First cell holding the channel on the segment between the centers of the cells. Returns false without a hit. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	bool RaycastByGridPoint(const FName InChannelName, const FIntPoint InStart, const FIntPoint InEnd,
+	                        UScriptStruct* InExpectedStruct, FIntPoint& OutCell) const;
+
+	/** Every cell holding the channel on the segment between the locations, from start to end. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	TArray<FIntPoint> RaycastAllByLocation(const FName InChannelName, const FVector InStart, const FVector InEnd,
+	                                       UScriptStruct* InExpectedStruct) const;
+
+	/** Every cell holding the channel on the segment between the centers of the cells, from start to end. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	TArray<FIntPoint> RaycastAllByGridPoint(const FName InChannelName, const FIntPoint InStart, const FIntPoint InEnd,
+	                                        UScriptStruct* InExpectedStruct) const;
+
+	/** Cell holding the channel nearest to the location. Returns false if no cell has it. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	bool FindNearestByLocation(const FName InChannelName, const FVector InLocation, UScriptStruct* InExpectedStruct,
+	                           FIntPoint& OutCell) const;
+
+	/** Cell holding the channel nearest to the grid point. Returns false if no cell has it. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	bool FindNearestByGridPoint(const FName InChannelName, const FIntPoint InGridPoint, UScriptStruct* InExpectedStruct,
+	                            FIntPoint& OutCell) const;
+
+	/** Up to InCount cells holding the channel nearest to the location, nearest first. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	TArray<FIntPoint> FindKNearestByLocation(const FName InChannelName, const FVector InLocation, const int32 InCount,
+	                                         UScriptStruct* InExpectedStruct) const;
+
+	/** Up to InCount cells holding the channel nearest to the grid point, nearest first. */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	TArray<FIntPoint> FindKNearestByGridPoint(const FName InChannelName, const FIntPoint InGridPoint,
+	                                          const int32 InCount, UScriptStruct* InExpectedStruct) const;
+
+	/**
+	 * Groups the cells holding the channel into 4-connected components. OutCellComponents maps each cell
+	 * to its component and OutSizes holds the cell count of each component. Returns the number of components.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	int32 LabelComponents(const FName InChannelName, UScriptStruct* InExpectedStruct,
+	                      TMap<FIntPoint, int32>& OutCellComponents, TArray<int32>& OutSizes) const;
+
+	/**
+	 * Makes every chunk keep a count/sum/min/max summary of the numeric field over the cells holding the
+	 * channel. None keeps the count only. Returns false if the struct has no numeric property of that name.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	bool AddAggregateField(const FName InChannelName, UScriptStruct* InExpectedStruct, const FName InFieldName);
+
+	/**
+	 * Number of cells holding the channel in the grid region, Max exclusive, with the sum, min and max of the
+	 * field added by AddAggregateField. Min and max are zero when no cell is found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
+	int32 AggregateRegion(const FName InChannelName, const FIntRect InGridRegion, UScriptStruct* InExpectedStruct,
+	                      double& OutSum, double& OutMin, double& OutMax);
+
 	UFUNCTION(BlueprintCallable, Category = "Chunk Manager")
 	bool IsEmpty() const;
 
@@ -122,6 +234,11 @@ public:
 	// Debug
 	void DrawDebug(const TFunction<FVector(const FIntPoint&)>& InConvertor) const;
 
+public:
+	/** Cell storage applied to chunks of the system created by this manager on initialization. */
+	UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Chunk Manager")
+	FChunkCellStorageSettings CellStorageSettings;
+
 protected:
 	FORCEINLINE TSharedPtr<TChunkSystem_DynamicData<>>& GetChunkSystemDynamicData()
 	{
@@ -14,6 +14,9 @@ public:
 
 	virtual void DrawDebug(const UWorld* World, const TFunction<FVector(const FIntPoint&)>& Convertor) const;
 
+	/** Rebinds the chunk to new bounds and clears its data, used when recycling pooled chunks. */
+	virtual void Reset(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight);
+
 protected:
 	FORCEINLINE const FIntPoint& GetTopLeft() const
 	{
@@ -0,0 +1,274 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed size bit set with one bit per cell of a chunk.
+ *
+ * Bits are addressed by the local cell index of the owning chunk and stored
+ * in 64-bit words, so the default 15x15 chunk fits in the inline storage.
+ */
+class FChunkCellMask
+{
+public:
+	FChunkCellMask() = default;
+
+	explicit FChunkCellMask(const int32 InNumBits)
+	{
+		Init(InNumBits);
+	}
+
+	FORCEINLINE void Init(const int32 InNumBits)
+	{
+		NumBits = FMath::Max(InNumBits, 0);
+		Words.Init(0, GetNumWords(NumBits));
+	}
+
+	FORCEINLINE void Reset()
+	{
+		FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+	}
+
+	FORCEINLINE bool Get(const int32 Index) const
+	{
+		checkSlow(Index >= 0 && Index < NumBits);
+		return (Words[Index >> 6] & (1ull << (Index & 63))) != 0;
+	}
+
+	FORCEINLINE void Set(const int32 Index)
+	{
+		checkSlow(Index >= 0 && Index < NumBits);
+		Words[Index >> 6] |= 1ull << (Index & 63);
+	}
+
+	FORCEINLINE void Clear(const int32 Index)
+	{
+		checkSlow(Index >= 0 && Index < NumBits);
+		Words[Index >> 6] &= ~(1ull << (Index & 63));
+	}
+
+	/** Sets Count consecutive bits starting at StartIndex. */
+	FORCEINLINE void SetRange(const int32 StartIndex, const int32 Count)
+	{
+		checkSlow(StartIndex >= 0 && Count >= 0 && StartIndex + Count <= NumBits);
+
+		int32 Index = StartIndex;
+		const int32 EndIndex = StartIndex + Count;
+
+		while (Index < EndIndex)
+		{
+			const int32 Bit = Index & 63;
+			const int32 NumInWord = FMath::Min(64 - Bit, EndIndex - Index);
+			const uint64 Bits = NumInWord == 64 ? ~0ull : ((1ull << NumInWord) - 1) << Bit;
+
+			Words[Index >> 6] |= Bits;
+			Index += NumInWord;
+		}
+	}
+
+	/** Returns the first set bit at or after StartIndex, or INDEX_NONE. */
+	FORCEINLINE int32 FindFrom(const int32 StartIndex) const
+	{
+		if (StartIndex >= NumBits)
+		{
+			return INDEX_NONE;
+		}
+
+		int32 WordIndex = StartIndex >> 6;
+		uint64 Word = Words[WordIndex] & (~0ull << (StartIndex & 63));
+
+		while (true)
+		{
+			if (Word != 0)
+			{
+				const int32 Index = (WordIndex << 6) + static_cast<int32>(FMath::CountTrailingZeros64(Word));
+				return Index < NumBits ? Index : INDEX_NONE;
+			}
+
+			if (++WordIndex >= Words.Num())
+			{
+				return INDEX_NONE;
+			}
+
+			Word = Words[WordIndex];
+		}
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		for (const uint64 Word : Words)
+		{
+			if (Word != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	FORCEINLINE int32 CountSetBits() const
+	{
+		int32 Count = 0;
+		for (const uint64 Word : Words)
+		{
+			Count += static_cast<int32>(FMath::CountBits(Word));
+		}
+
+		return Count;
+	}
+
+	/** Number of set bits among the Count bits starting at StartIndex. */
+	FORCEINLINE int32 CountSetBitsInRange(const int32 StartIndex, const int32 Count) const
+	{
+		checkSlow(StartIndex >= 0 && Count >= 0 && StartIndex + Count <= NumBits);
+
+		int32 Result = 0;
+		int32 Index = StartIndex;
+		const int32 EndIndex = StartIndex + Count;
+
+		while (Index < EndIndex)
+		{
+			const int32 Bit = Index & 63;
+			const int32 NumInWord = FMath::Min(64 - Bit, EndIndex - Index);
+			const uint64 Bits = NumInWord == 64 ? ~0ull : ((1ull << NumInWord) - 1) << Bit;
+
+			Result += static_cast<int32>(FMath::CountBits(Words[Index >> 6] & Bits));
+			Index += NumInWord;
+		}
+
+		return Result;
+	}
+
+	/** Whether any of the Count bits starting at StartIndex is set. */
+	FORCEINLINE bool AnySetBitsInRange(const int32 StartIndex, const int32 Count) const
+	{
+		checkSlow(StartIndex >= 0 && Count >= 0 && StartIndex + Count <= NumBits);
+
+		int32 Index = StartIndex;
+		const int32 EndIndex = StartIndex + Count;
+
+		while (Index < EndIndex)
+		{
+			const int32 Bit = Index & 63;
+			const int32 NumInWord = FMath::Min(64 - Bit, EndIndex - Index);
+			const uint64 Bits = NumInWord == 64 ? ~0ull : ((1ull << NumInWord) - 1) << Bit;
+
+			if (Words[Index >> 6] & Bits)
+			{
+				return true;
+			}
+
+			Index += NumInWord;
+		}
+
+		return false;
+	}
+
+	FORCEINLINE int32 Num() const
+	{
+		return NumBits;
+	}
+
+	FORCEINLINE int32 NumWords() const
+	{
+		return Words.Num();
+	}
+
+	FORCEINLINE const uint64* GetWords() const
+	{
+		return Words.GetData();
+	}
+
+	FORCEINLINE uint64* GetWords()
+	{
+		return Words.GetData();
+	}
+
+	// Set algebra, both masks must have the same size.
+
+	/** this &= Other */
+	FORCEINLINE void And(const FChunkCellMask& Other)
+	{
+		Combine<EOp::And>(Other);
+	}
+
+	/** this |= Other */
+	FORCEINLINE void Or(const FChunkCellMask& Other)
+	{
+		Combine<EOp::Or>(Other);
+	}
+
+	/** this &= ~Other */
+	FORCEINLINE void AndNot(const FChunkCellMask& Other)
+	{
+		Combine<EOp::AndNot>(Other);
+	}
+
+	static FORCEINLINE int32 GetNumWords(const int32 InNumBits)
+	{
+		return (InNumBits + 63) >> 6;
+	}
+
+private:
+	enum class EOp : uint8
+	{
+		And,
+		Or,
+		AndNot
+	};
+
+	/** Processes two words per step with 128-bit integer vector ops, the odd tail word is handled as scalar. */
+	template <EOp Op>
+	FORCEINLINE void Combine(const FChunkCellMask& Other)
+	{
+		check(NumBits == Other.NumBits);
+
+		uint64* Dest = Words.GetData();
+		const uint64* Src = Other.Words.GetData();
+		const int32 Num = Words.Num();
+
+		int32 Index = 0;
+		for (; Index + 2 <= Num; Index += 2)
+		{
+			const VectorRegister4Int A = VectorIntLoad(Dest + Index);
+			const VectorRegister4Int B = VectorIntLoad(Src + Index);
+
+			if constexpr (Op == EOp::And)
+			{
+				VectorIntStore(VectorIntAnd(A, B), Dest + Index);
+			}
+			else if constexpr (Op == EOp::Or)
+			{
+				VectorIntStore(VectorIntOr(A, B), Dest + Index);
+			}
+			else
+			{
+				// VectorIntAndNot(X, Y) computes ~X & Y.
+				VectorIntStore(VectorIntAndNot(B, A), Dest + Index);
+			}
+		}
+
+		for (; Index < Num; ++Index)
+		{
+			if constexpr (Op == EOp::And)
+			{
+				Dest[Index] &= Src[Index];
+			}
+			else if constexpr (Op == EOp::Or)
+			{
+				Dest[Index] |= Src[Index];
+			}
+			else
+			{
+				Dest[Index] &= ~Src[Index];
+			}
+		}
+	}
+
+private:
+	TArray<uint64, TInlineAllocator<4>> Words;
+	int32 NumBits = 0;
+};
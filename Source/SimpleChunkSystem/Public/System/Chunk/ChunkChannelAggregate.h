@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FNumericProperty;
+
+/** Number of cells holding a channel and reductions of one numeric field over them. */
+struct FChunkChannelAggregate
+{
+	FORCEINLINE void Add(const double Value)
+	{
+		++Count;
+		Sum += Value;
+		Min = FMath::Min(Min, Value);
+		Max = FMath::Max(Max, Value);
+	}
+
+	FORCEINLINE void Append(const FChunkChannelAggregate& Other)
+	{
+		Count += Other.Count;
+		Sum += Other.Sum;
+		Min = FMath::Min(Min, Other.Min);
+		Max = FMath::Max(Max, Other.Max);
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Count == 0;
+	}
+
+	FORCEINLINE double GetAverage() const
+	{
+		return Count > 0 ? Sum / Count : 0.0;
+	}
+
+	int32 Count = 0;
+
+	/** Reductions of the field, Min and Max keep their initial values while the aggregate is empty. */
+	double Sum = 0.0;
+	double Min = TNumericLimits<double>::Max();
+	double Max = TNumericLimits<double>::Lowest();
+};
+
+/**
+ * Numeric field of a channel struct reduced into FChunkChannelAggregate.
+ *
+ * An unset property still counts the cells, every value then reads as 0.
+ */
+struct SIMPLECHUNKSYSTEM_API FChunkAggregateField
+{
+	/** Finds the numeric field of the struct, false if there is none with that name. Name_None counts only. */
+	static bool Make(const UScriptStruct* Type, const FName FieldName, FChunkAggregateField& OutField);
+
+	/** Value of the field in an instance of the struct. */
+	double GetValue(const void* StructMemory) const;
+
+	const FNumericProperty* Property = nullptr;
+};
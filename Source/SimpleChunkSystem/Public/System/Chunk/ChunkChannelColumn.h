@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChunkCellMask.h"
+
+/**
+ * Contiguous, type-homogeneous storage for one channel of a chunk.
+ *
+ * Payloads of every cell live in a single buffer in local cell index order
+ * and an occupancy mask marks which entries are constructed. Sweeping a
+ * column is a linear scan and values do not own separate allocations.
+ */
+class SIMPLECHUNKSYSTEM_API FChunkChannelColumn
+{
+public:
+	FChunkChannelColumn(const UScriptStruct* InType, const int32 InNumCells);
+
+	FChunkChannelColumn(const FChunkChannelColumn& Other);
+	FChunkChannelColumn(FChunkChannelColumn&& Other) noexcept;
+
+	FChunkChannelColumn& operator=(const FChunkChannelColumn& Other);
+	FChunkChannelColumn& operator=(FChunkChannelColumn&& Other) noexcept;
+
+	~FChunkChannelColumn();
+
+public:
+	/** Returns the payload of the cell, default constructing it on first access. */
+	uint8* FindOrAdd(const int32 CellIndex);
+
+	FORCEINLINE uint8* Find(const int32 CellIndex)
+	{
+		return Contains(CellIndex) ? GetMemory(CellIndex) : nullptr;
+	}
+
+	FORCEINLINE const uint8* Find(const int32 CellIndex) const
+	{
+		return Contains(CellIndex) ? GetMemory(CellIndex) : nullptr;
+	}
+
+	bool Remove(const int32 CellIndex);
+
+	void Empty();
+
+	FORCEINLINE bool Contains(const int32 CellIndex) const
+	{
+		return CellIndex >= 0 && CellIndex < NumCells && Occupancy.Get(CellIndex);
+	}
+
+	FORCEINLINE int32 Num() const
+	{
+		return NumValues;
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return NumValues == 0;
+	}
+
+	FORCEINLINE int32 GetNumCells() const
+	{
+		return NumCells;
+	}
+
+	FORCEINLINE const UScriptStruct* GetType() const
+	{
+		return Type;
+	}
+
+	FORCEINLINE const FChunkCellMask& GetOccupancy() const
+	{
+		return Occupancy;
+	}
+
+	/** Payload of an occupied cell without any occupancy checks. */
+	FORCEINLINE uint8* GetMemory(const int32 CellIndex)
+	{
+		return const_cast<uint8*>(AsConst(*this).GetMemory(CellIndex));
+	}
+
+	FORCEINLINE const uint8* GetMemory(const int32 CellIndex) const
+	{
+		checkSlow(Data && CellIndex >= 0 && CellIndex < NumCells);
+		return Data + static_cast<SIZE_T>(CellIndex) * Stride;
+	}
+
+private:
+	void Allocate();
+	void Release();
+	void CopyFrom(const FChunkChannelColumn& Other);
+
+private:
+	const UScriptStruct* Type = nullptr;
+
+	int32 Stride = 0;
+	int32 Alignment = 0;
+	int32 NumCells = 0;
+	int32 NumValues = 0;
+
+	/** Lazily allocated payload buffer of NumCells * Stride bytes. */
+	uint8* Data = nullptr;
+
+	FChunkCellMask Occupancy;
+};
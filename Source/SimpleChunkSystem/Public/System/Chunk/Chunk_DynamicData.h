@@ -2,7 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "ChunkBase.h"
+#include "ChunkChannelAggregate.h"
+#include "ChunkChannelColumn.h"
+#include "System/ChunkNearest.h"
+#include "System/ChunkRaycast.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
 #include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
 #include "Chunk_DynamicData.generated.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogSChunkLocal, Log, All)
@@ -25,6 +32,120 @@ FORCEINLINE uint32 GetTypeHash(const FCellChannelKey& Key)
 	return HashCombine(GetTypeHash(Key.ChannelName), GetTypeHash(Key.Type));
 }
 
+/**
+ * Compact runtime id of a channel (name and type) resolved through FCellChannelRegistry.
+ *
+ * Handles are only valid for the running process and are never serialized,
+ * saved data keeps FCellChannelKey.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLECHUNKSYSTEM_API FCellChannelHandle
+{
+	GENERATED_BODY()
+
+	FCellChannelHandle() = default;
+
+	explicit FCellChannelHandle(const int32 InIndex)
+		: Index(InIndex)
+	{
+	}
+
+	FORCEINLINE bool IsValid() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	FORCEINLINE int32 GetIndex() const
+	{
+		return Index;
+	}
+
+	friend bool operator==(const FCellChannelHandle Left, const FCellChannelHandle Right)
+	{
+		return Left.Index == Right.Index;
+	}
+
+	friend bool operator!=(const FCellChannelHandle Left, const FCellChannelHandle Right)
+	{
+		return Left.Index != Right.Index;
+	}
+
+	friend uint32 GetTypeHash(const FCellChannelHandle Handle)
+	{
+		return static_cast<uint32>(Handle.Index);
+	}
+
+private:
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+};
+
+/**
+ * Process wide interning table between channel keys and handles.
+ *
+ * A key is hashed once when resolved, afterwards the handle is compared and
+ * hashed as a plain integer. Handles are never released, so published keys
+ * live in append-only pages and GetKey/GetType read them without locking.
+ * Name lookups of keys a thread has already seen hit a thread local cache,
+ * only the first lookup per thread and key takes the lock.
+ */
+class SIMPLECHUNKSYSTEM_API FCellChannelRegistry
+{
+public:
+	static FCellChannelRegistry& Get();
+
+	template <typename TStruct>
+	static FORCEINLINE FCellChannelHandle Resolve(const FName Name)
+	{
+		return Get().FindOrAdd({Name, TStruct::StaticStruct()});
+	}
+
+	static FORCEINLINE FCellChannelHandle Resolve(const FName Name, UScriptStruct* Type)
+	{
+		return Get().FindOrAdd({Name, Type});
+	}
+
+	FCellChannelHandle FindOrAdd(const FCellChannelKey& Key);
+
+	/** Returns an invalid handle if the key was never resolved. */
+	FCellChannelHandle Find(const FCellChannelKey& Key) const;
+
+	FORCEINLINE FCellChannelKey GetKey(const FCellChannelHandle Handle) const
+	{
+		const int32 Index = Handle.GetIndex();
+		if (Index < 0 || Index >= NumKeys.load(std::memory_order_acquire))
+		{
+			return FCellChannelKey();
+		}
+
+		return Pages[Index >> PageShift][Index & (PageSize - 1)];
+	}
+
+	FORCEINLINE UScriptStruct* GetType(const FCellChannelHandle Handle) const
+	{
+		return GetKey(Handle).Type;
+	}
+
+	FORCEINLINE int32 Num() const
+	{
+		return NumKeys.load(std::memory_order_acquire);
+	}
+
+private:
+	static constexpr int32 PageShift = 8;
+	static constexpr int32 PageSize = 1 << PageShift;
+	static constexpr int32 MaxPages = 4096;
+
+	/** Guards Handles and the writes of new keys, readers of published keys go through NumKeys. */
+	mutable FRWLock Lock;
+
+	TMap<FCellChannelKey, int32> Handles;
+
+	/** Pages are never moved or freed while the registry lives, a key is readable once NumKeys covers it. */
+	TUniquePtr<FCellChannelKey[]> Pages[MaxPages];
+	std::atomic<int32> NumKeys{0};
+};
+
 USTRUCT()
 struct SIMPLECHUNKSYSTEM_API FCellBaseInfo
 {
@@ -45,357 +166,1201 @@ struct TStructOpsTypeTraits<FCellBaseInfo> : public TStructOpsTypeTraitsBase2<FC
 	};
 };
 
+/**
+ * Layout used by FChunk_DynamicData to store its cells.
+ */
+UENUM(BlueprintType)
+enum class EChunkCellStorage : uint8
+{
+	/** Cells are allocated lazily on first write and kept in a hash map keyed by their local index. */
+	Map,
+	/** Cells are kept in a flat array addressed by their local coordinates. */
+	Dense,
+	/** Cells start in the map layout and switch between map and dense layouts based on occupancy. */
+	Adaptive
+};
+
+/**
+ * Storage settings applied to every chunk created by a dynamic data system.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLECHUNKSYSTEM_API FChunkCellStorageSettings
+{
+	GENERATED_BODY()
+
+	/** Layout used for the cells of each chunk. */
+	UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Chunk Storage")
+	EChunkCellStorage Storage = EChunkCellStorage::Adaptive;
+
+	/** Fraction of occupied cells above which an adaptive chunk switches to the dense layout. */
+	UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Chunk Storage",
+		meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "Storage == EChunkCellStorage::Adaptive"))
+	float PromoteOccupancy = 0.5f;
+
+	/** Fraction of occupied cells below which an adaptive chunk switches back to the map layout. */
+	UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Chunk Storage",
+		meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "Storage == EChunkCellStorage::Adaptive"))
+	float DemoteOccupancy = 0.25f;
+};
+
+/**
+ * Channels stored in a single cell.
+ *
+ * Cells rarely hold more than a few channels, so the first InlineCapacity
+ * channels are kept inline and looked up by a linear scan over their handles.
+ * A cell that grows past that moves all of its channels into a hash map.
+ *
+ * The FInstancedStruct wrappers of the channels are not address stable: they
+ * move when a channel is added to or removed from the cell, and with the
+ * cell itself when its chunk rehashes or changes layout. The struct memory a
+ * wrapper owns is heap allocated and moves with it by pointer, so
+ * GetMutableMemory and GetMutable<T>() stay valid until the channel is removed.
+ */
 class SIMPLECHUNKSYSTEM_API FCellDynamicInfo
 {
 public:
+	static constexpr int32 InlineCapacity = 3;
+
+	struct FChannel
+	{
+		FCellChannelHandle Handle;
+		FInstancedStruct Value;
+	};
+
+public:
+	FCellDynamicInfo() = default;
+
+	FCellDynamicInfo(const FCellDynamicInfo& Other);
+	FCellDynamicInfo(FCellDynamicInfo&& Other) = default;
+
+	FCellDynamicInfo& operator=(const FCellDynamicInfo& Other);
+	FCellDynamicInfo& operator=(FCellDynamicInfo&& Other) = default;
+
 	void Serialize(FArchive& Ar);
 
 public:
+	/** The reference is invalidated by the next channel added to or removed from the cell. */
 	template <typename TStruct>
 	FORCEINLINE FInstancedStruct& GetOrAddChannel(const FName Name)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_GetOrAddChannel)
 
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		TOptional<FInstancedStruct>& OptStruct = Channels.FindOrAdd(Key);
-		if (!OptStruct.IsSet())
+		return GetOrAddChannel(FCellChannelRegistry::Resolve<TStruct>(Name), TStruct::StaticStruct());
+	}
+
+	/** The reference is invalidated by the next channel added to or removed from the cell. */
+	FORCEINLINE FInstancedStruct& GetOrAddChannel(const FName Name, UScriptStruct* Type)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::GetOrAddChannel)
+
+		return GetOrAddChannel(FCellChannelRegistry::Resolve(Name, Type), Type);
+	}
+
+	/**
+	 * Type must be the type the handle was resolved with, it initializes a newly added channel.
+	 * The reference is invalidated by the next channel added to or removed from the cell, the
+	 * struct memory it points to stays valid until this channel is removed.
+	 */
+	FORCEINLINE FInstancedStruct& GetOrAddChannel(const FCellChannelHandle Handle, const UScriptStruct* Type)
+	{
+		if (FInstancedStruct* const Found = FindChannel(Handle))
+		{
+			return *Found;
+		}
+
+		FInstancedStruct& NewStruct = AddChannel(Handle);
+		NewStruct.InitializeAs(Type);
+
+		return NewStruct;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool RemoveChannel(const FName Name)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_RemoveChannel)
+
+		return RemoveChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+	}
+
+	FORCEINLINE bool RemoveChannel(const FName Name, UScriptStruct* Type)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::RemoveChannel)
+
+		return RemoveChannel(FCellChannelRegistry::Get().Find({Name, Type}));
+	}
+
+	FORCEINLINE bool RemoveChannel(const FCellChannelHandle Handle)
+	{
+		if (SpilledChannels)
+		{
+			return SpilledChannels->Remove(Handle) > 0;
+		}
+
+		for (int32 Index = 0; Index < InlineChannels.Num(); ++Index)
+		{
+			if (InlineChannels[Index].Handle == Handle)
+			{
+				InlineChannels.RemoveAt(Index, 1, EAllowShrinking::No);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool HasChannel(const FName Name) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_HasChannel)
+
+		return HasChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+	}
+
+	FORCEINLINE bool HasChannel(const FName Name, UScriptStruct* Type) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::HasChannel)
+
+		return HasChannel(FCellChannelRegistry::Get().Find({Name, Type}));
+	}
+
+	FORCEINLINE bool HasChannel(const FCellChannelHandle Handle) const
+	{
+		return FindChannel(Handle) != nullptr;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE FInstancedStruct* FindChannel(const FName Name)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_FindChannel)
+
+		return FindChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+	}
+
+	template <typename TStruct>
+	FORCEINLINE const FInstancedStruct* FindChannel(const FName Name) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_FindChannel)
+
+		return FindChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+	}
+
+	FORCEINLINE FInstancedStruct* FindChannel(const FName Name, UScriptStruct* Type)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::FindChannel);
+
+		return FindChannel(FCellChannelRegistry::Get().Find({Name, Type}));
+	}
+
+	FORCEINLINE const FInstancedStruct* FindChannel(const FName Name, UScriptStruct* Type) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::FindChannel_Const);
+
+		return FindChannel(FCellChannelRegistry::Get().Find({Name, Type}));
+	}
+
+	FORCEINLINE FInstancedStruct* FindChannel(const FCellChannelHandle Handle)
+	{
+		return const_cast<FInstancedStruct*>(AsConst(*this).FindChannel(Handle));
+	}
+
+	FORCEINLINE const FInstancedStruct* FindChannel(const FCellChannelHandle Handle) const
+	{
+		if (SpilledChannels)
+		{
+			return SpilledChannels->Find(Handle);
+		}
+
+		for (const FChannel& Channel : InlineChannels)
+		{
+			if (Channel.Handle == Handle)
+			{
+				return &Channel.Value;
+			}
+		}
+
+		return nullptr;
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Num() == 0;
+	}
+
+	FORCEINLINE int32 Num() const
+	{
+		return SpilledChannels ? SpilledChannels->Num() : InlineChannels.Num();
+	}
+
+	/** True once the cell outgrew its inline storage. */
+	FORCEINLINE bool IsSpilled() const
+	{
+		return SpilledChannels.IsValid();
+	}
+
+	/** Calls Func(FCellChannelHandle, FInstancedStruct&) for every channel of the cell. */
+	template <typename FuncType>
+	void ForEachChannel(FuncType&& Func)
+	{
+		if (SpilledChannels)
+		{
+			for (TPair<FCellChannelHandle, FInstancedStruct>& Channel : *SpilledChannels)
+			{
+				Func(Channel.Key, Channel.Value);
+			}
+
+			return;
+		}
+
+		for (FChannel& Channel : InlineChannels)
+		{
+			Func(Channel.Handle, Channel.Value);
+		}
+	}
+
+	template <typename FuncType>
+	void ForEachChannel(FuncType&& Func) const
+	{
+		if (SpilledChannels)
+		{
+			for (const TPair<FCellChannelHandle, FInstancedStruct>& Channel : *SpilledChannels)
+			{
+				Func(Channel.Key, Channel.Value);
+			}
+
+			return;
+		}
+
+		for (const FChannel& Channel : InlineChannels)
+		{
+			Func(Channel.Handle, Channel.Value);
+		}
+	}
+
+	void DrawDebug(const UWorld* World, const FVector& CellCenter) const;
+
+private:
+	/** Adds an uninitialized channel, the handle must not be present yet. */
+	FInstancedStruct& AddChannel(const FCellChannelHandle Handle);
+
+	void Spill();
+
+private:
+	TArray<FChannel, TInlineAllocator<InlineCapacity>> InlineChannels;
+
+	/** Set when the cell holds more than InlineCapacity channels, InlineChannels is empty then. */
+	TUniquePtr<TMap<FCellChannelHandle, FInstancedStruct>> SpilledChannels;
+};
+
+/**
+ * Combination of channels evaluated over the occupancy masks of a chunk.
+ *
+ * Terms are folded left to right: the first term seeds the result and every
+ * following term is combined with it, e.g. Where(A).And(B).AndNot(C) matches
+ * cells that have A and B but not C. Cell payloads are never touched.
+ */
+class SIMPLECHUNKSYSTEM_API FChunkChannelQuery
+{
+public:
+	enum class EOp : uint8
+	{
+		And,
+		Or,
+		AndNot
+	};
+
+	struct FTerm
+	{
+		EOp Op = EOp::Or;
+		FCellChannelHandle Handle;
+	};
+
+public:
+	template <typename TStruct>
+	FORCEINLINE FChunkChannelQuery& Where(const FName Name)
+	{
+		return Where(Name, TStruct::StaticStruct());
+	}
+
+	FORCEINLINE FChunkChannelQuery& Where(const FName Name, UScriptStruct* Type)
+	{
+		return Where(FCellChannelRegistry::Resolve(Name, Type));
+	}
+
+	FORCEINLINE FChunkChannelQuery& Where(const FCellChannelHandle Handle)
+	{
+		Terms.Reset();
+		return AddTerm(EOp::Or, Handle);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE FChunkChannelQuery& And(const FName Name)
+	{
+		return AddTerm(EOp::And, FCellChannelRegistry::Resolve<TStruct>(Name));
+	}
+
+	FORCEINLINE FChunkChannelQuery& And(const FName Name, UScriptStruct* Type)
+	{
+		return AddTerm(EOp::And, FCellChannelRegistry::Resolve(Name, Type));
+	}
+
+	FORCEINLINE FChunkChannelQuery& And(const FCellChannelHandle Handle)
+	{
+		return AddTerm(EOp::And, Handle);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE FChunkChannelQuery& Or(const FName Name)
+	{
+		return AddTerm(EOp::Or, FCellChannelRegistry::Resolve<TStruct>(Name));
+	}
+
+	FORCEINLINE FChunkChannelQuery& Or(const FName Name, UScriptStruct* Type)
+	{
+		return AddTerm(EOp::Or, FCellChannelRegistry::Resolve(Name, Type));
+	}
+
+	FORCEINLINE FChunkChannelQuery& Or(const FCellChannelHandle Handle)
+	{
+		return AddTerm(EOp::Or, Handle);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE FChunkChannelQuery& AndNot(const FName Name)
+	{
+		return AddTerm(EOp::AndNot, FCellChannelRegistry::Resolve<TStruct>(Name));
+	}
+
+	FORCEINLINE FChunkChannelQuery& AndNot(const FName Name, UScriptStruct* Type)
+	{
+		return AddTerm(EOp::AndNot, FCellChannelRegistry::Resolve(Name, Type));
+	}
+
+	FORCEINLINE FChunkChannelQuery& AndNot(const FCellChannelHandle Handle)
+	{
+		return AddTerm(EOp::AndNot, Handle);
+	}
+
+	FORCEINLINE const TArray<FTerm, TInlineAllocator<4>>& GetTerms() const
+	{
+		return Terms;
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Terms.IsEmpty();
+	}
+
+private:
+	FORCEINLINE FChunkChannelQuery& AddTerm(const EOp Op, const FCellChannelHandle Handle)
+	{
+		Terms.Add({Op, Handle});
+		return *this;
+	}
+
+private:
+	TArray<FTerm, TInlineAllocator<4>> Terms;
+};
+
+/**
+ * Chunk implementation that stores per-cell dynamic data channels.
+ *
+ * Each cell within the chunk can hold arbitrary user defined structures
+ * wrapped in FInstancedStruct and can be serialized to or from an archive.
+ */
+class SIMPLECHUNKSYSTEM_API FChunk_DynamicData : public FChunkBase
+{
+	using Super = FChunkBase;
+
+	template <typename TStruct, bool bConst>
+	class TChannelIteratorRangeImpl;
+
+	template <typename TStruct>
+	using TChannelIteratorRange = TChannelIteratorRangeImpl<TStruct, false>;
+
+	template <typename TStruct>
+	using TConstChannelIteratorRange = TChannelIteratorRangeImpl<TStruct, true>;
+
+	template <typename TStruct, bool bConst>
+	class TColumnIteratorRangeImpl;
+
+	template <typename TStruct>
+	using TColumnIteratorRange = TColumnIteratorRangeImpl<TStruct, false>;
+
+	template <typename TStruct>
+	using TConstColumnIteratorRange = TColumnIteratorRangeImpl<TStruct, true>;
+
+public:
+	FChunk_DynamicData(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight,
+	                   const FChunkCellStorageSettings& InStorageSettings = FChunkCellStorageSettings());
+
+public:
+	virtual void Serialize(FArchive& Ar) override;
+
+	/** Drops every channel and column, the cell and index storage is kept for the new bounds. */
+	virtual void Reset(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight) override;
+
+public:
+	template <typename TStruct>
+	TChannelIteratorRange<TStruct> IterateChannel(const FName Name);
+
+	template <typename TStruct>
+	TConstChannelIteratorRange<TStruct> IterateChannel(const FName Name) const;
+
+	template <typename TStruct>
+	TChannelIteratorRange<TStruct> IterateChannel(const FCellChannelHandle Handle);
+
+	template <typename TStruct>
+	TConstChannelIteratorRange<TStruct> IterateChannel(const FCellChannelHandle Handle) const;
+
+	/** Invalidated by the next channel added to or removed from any cell of the chunk. */
+	template <typename TStruct>
+	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FName Name, const FIntPoint& InCellPoint)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::Template_FindOrAddChannel)
+
+		return FindOrAddChannel(FCellChannelRegistry::Resolve<TStruct>(Name), InCellPoint, TStruct::StaticStruct());
+	}
+
+	/** Invalidated by the next channel added to or removed from any cell of the chunk. */
+	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::FindOrAddChannel)
+
+		return FindOrAddChannel(FCellChannelRegistry::Resolve(Name, Type), InCellPoint, Type);
+	}
+
+	/**
+	 * Type must be the type the handle was resolved with.
+	 *
+	 * The returned reference lives inside the cell storage and is invalidated by the next channel
+	 * added to or removed from any cell of the chunk: map cells move when the map grows, and every
+	 * cell moves when an adaptive chunk switches layout. Hold the handle and point, or the struct
+	 * memory of the channel, which stays put until the channel is removed.
+	 */
+	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FCellChannelHandle Handle, const FIntPoint& InCellPoint,
+	                                               const UScriptStruct* Type)
+	{
+		if (!HasChannel(Handle, InCellPoint))
+		{
+			PrepareCellForWrite(InCellPoint);
+			RegisterChannelLocation(Handle, InCellPoint);
+		}
+
+		MarkAggregateStale(Handle);
+		return FindOrAddCell(InCellPoint).GetOrAddChannel(Handle, Type);
+	}
+
+	/** Invalidated by the next channel added to or removed from any cell of the chunk. */
+	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FCellChannelHandle Handle, const FIntPoint& InCellPoint)
+	{
+		return FindOrAddChannel(Handle, InCellPoint, FCellChannelRegistry::Get().GetType(Handle));
+	}
+
+	/**
+	 * Copies Value into the channel of the cell, adding the channel if missing. The type of Value must be
+	 * the type the handle was resolved with. Unlike writing through FindOrAddChannel, the summary of the
+	 * channel is updated in place instead of being rebuilt on next use.
+	 */
+	void SetChannelValue(const FCellChannelHandle Handle, const FIntPoint& InCellPoint, const FInstancedStruct& Value);
+
+	template <typename TStruct>
+	FORCEINLINE bool TryRemoveChannel(const FName Name, const FIntPoint& InCellPoint)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::Template_TryRemoveChannel)
+
+		return TryRemoveChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InCellPoint);
+	}
+
+	FORCEINLINE bool TryRemoveChannel(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::TryRemoveChannel)
+
+		return TryRemoveChannel(FCellChannelRegistry::Get().Find({Name, Type}), InCellPoint);
+	}
+
+	FORCEINLINE bool TryRemoveChannel(const FCellChannelHandle Handle, const FIntPoint& InCellPoint)
+	{
+		FCellDynamicInfo* const CellInfo = FindCell(InCellPoint);
+		if (CellInfo && !Aggregates.IsEmpty())
+		{
+			RemoveFromAggregate(Handle, CellInfo->FindChannel(Handle));
+		}
+
+		const bool bRemoved = CellInfo && CellInfo->RemoveChannel(Handle);
+		if (bRemoved)
 		{
-			FInstancedStruct NewStruct;
-			NewStruct.InitializeAs(TStruct::StaticStruct());
+			UnregisterChannelLocation(Handle, InCellPoint);
+
+			if (CellInfo->IsEmpty())
+			{
+				ReleaseCell(InCellPoint);
+			}
+		}
+
+		return bRemoved;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool HasChannel(const FName Name, const FIntPoint& InCellPoint) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::Template_HasChannel)
+
+		return HasChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InCellPoint);
+	}
+
+	FORCEINLINE bool HasChannel(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::HasChannel)
+
+		return HasChannel(FCellChannelRegistry::Get().Find({Name, Type}), InCellPoint);
+	}
+
+	FORCEINLINE bool HasChannel(const FCellChannelHandle Handle, const FIntPoint& InCellPoint) const
+	{
+		const FChunkCellMask* const Mask = ChannelMasks.Find(Handle);
+		return Mask && IsInside(InCellPoint) && Mask->Get(GetCellIndex(InCellPoint));
+	}
+
+	/** True if at least one cell of the chunk has the channel. */
+	FORCEINLINE bool HasAnyChannel(const FCellChannelHandle Handle) const
+	{
+		return ChannelMasks.Contains(Handle);
+	}
+
+	/** Occupancy of the channel in local cell index order, null if no cell has it. */
+	FORCEINLINE const FChunkCellMask* FindChannelMask(const FCellChannelHandle Handle) const
+	{
+		return ChannelMasks.Find(Handle);
+	}
+
+	/**
+	 * Evaluates the query over the channel masks, restricted to the cells of Region (Max exclusive).
+	 * Returns false if no cell matches. OutMask is sized to the chunk.
+	 */
+	bool EvaluateQuery(const FChunkChannelQuery& Query, const FIntRect& Region, FChunkCellMask& OutMask) const;
+
+	/** Appends the cells of Region matching the query. */
+	void QueryCells(const FChunkChannelQuery& Query, const FIntRect& Region, TArray<FIntPoint>& OutCells) const;
+
+	/**
+	 * Writes a copy of Value to the channel of every cell of Region (Max exclusive) inside the chunk.
+	 * Value must be of the type the handle was resolved with. Returns the number of cells written.
+	 */
+	int32 FillRegion(const FCellChannelHandle Handle, const FIntRect& Region, const FInstancedStruct& Value);
+
+	/** Removes the channel from every cell of Region inside the chunk, returns the number of cells it was removed from. */
+	int32 ClearRegion(const FCellChannelHandle Handle, const FIntRect& Region);
+
+	/** Number of cells of Region inside the chunk holding the channel. */
+	int32 CountRegion(const FCellChannelHandle Handle, const FIntRect& Region) const;
+
+	/** Whether any cell of Region inside the chunk holds the channel, stops at the first column with one. */
+	bool HasAnyInRegion(const FCellChannelHandle Handle, const FIntRect& Region) const;
+
+	/**
+	 * Appends the cells holding the channel whose center lies within Radius of Center, both in continuous
+	 * grid space. Chunks entirely inside or outside of the disc are decided at once.
+	 */
+	void QueryDisc(const FCellChannelHandle Handle, const FVector2D& Center, const double Radius,
+	               TArray<FIntPoint>& OutCells) const;
+
+	/**
+	 * Walks the traversal through the chunk, which must hold its current cell, and stops on the first cell
+	 * holding the channel. Without a hit the traversal is left past the chunk, in a single step if no cell
+	 * has the channel.
+	 */
+	bool TraceFirst(const FCellChannelHandle Handle, FChunkGridTraversal& Traversal) const;
+
+	/** Like TraceFirst but walks through the whole chunk and appends every hit. */
+	void TraceAll(const FCellChannelHandle Handle, FChunkGridTraversal& Traversal,
+	              TArray<FChunkRayHit>& OutHits) const;
+
+	/**
+	 * Labels the 4-connected groups of cells holding the channel inside the chunk. OutLabels gets a label
+	 * per local cell, INDEX_NONE where the channel is absent, and OutSizes the number of cells of each label.
+	 * Returns the number of labels.
+	 */
+	int32 LabelComponents(const FCellChannelHandle Handle, TArray<int32>& OutLabels, TArray<int32>& OutSizes) const;
+
+	/**
+	 * Offers the cells holding the channel to the heap of the Count cells nearest to Origin, see
+	 * ChunkNearest::Offer. The chunk is skipped at once if its nearest cell cannot enter the heap.
+	 */
+	void CollectNearest(const FCellChannelHandle Handle, const FIntPoint& Origin, const int32 Count,
+	                    TArray<FChunkNearestCell>& Heap) const;
+
+	template <typename TStruct>
+	FORCEINLINE FInstancedStruct* FindChannel(const FName Name, const FIntPoint& InCellPoint)
+	{
+		return FindChannel(Name, InCellPoint, TStruct::StaticStruct());
+	}
 
-			OptStruct = NewStruct;
+	template <typename TStruct>
+	FORCEINLINE const FInstancedStruct* FindChannel(const FName Name, const FIntPoint& InCellPoint) const
+	{
+		return FindChannel(Name, InCellPoint, TStruct::StaticStruct());
+	}
+
+	FORCEINLINE FInstancedStruct* FindChannel(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
+	{
+		return FindChannel(FCellChannelRegistry::Get().Find({Name, Type}), InCellPoint);
+	}
+
+	FORCEINLINE const FInstancedStruct* FindChannel(const FName Name, const FIntPoint& InCellPoint,
+	                                                UScriptStruct* Type) const
+	{
+		return FindChannel(FCellChannelRegistry::Get().Find({Name, Type}), InCellPoint);
+	}
+
+	/** The value may be written through the pointer, so the summary of the channel is rebuilt on next use. */
+	FORCEINLINE FInstancedStruct* FindChannel(const FCellChannelHandle Handle, const FIntPoint& InCellPoint)
+	{
+		MarkAggregateStale(Handle);
+		return const_cast<FInstancedStruct*>(AsConst(*this).FindChannel(Handle, InCellPoint));
+	}
+
+	FORCEINLINE const FInstancedStruct* FindChannel(const FCellChannelHandle Handle,
+	                                                const FIntPoint& InCellPoint) const
+	{
+		const FCellDynamicInfo* const CellInfo = FindCell(InCellPoint);
+		return CellInfo ? CellInfo->FindChannel(Handle) : nullptr;
+	}
+
+	FORCEINLINE const TMap<FCellChannelHandle, FChunkCellMask>& GetChannelMasks() const
+	{
+		return ChannelMasks;
+	}
+
+	// Aggregates
+	// Summaries of a numeric field over the cells holding a channel. Removals and SetChannelValue update
+	// them in place. Mutable access to a value marks them stale and they are rebuilt from the cells on next
+	// use, const lookups leave them untouched.
+
+	/** Keeps a summary of the field for the channel, replacing the previous field. Kept through Reset. */
+	void AddAggregateField(const FCellChannelHandle Handle, const FChunkAggregateField& Field);
+
+	FORCEINLINE bool HasAggregateField(const FCellChannelHandle Handle) const
+	{
+		return FindAggregate(Handle) != nullptr;
+	}
+
+	/**
+	 * Summary of the channel over the whole chunk. A stale summary is rebuilt and kept. Without a field
+	 * for the channel only the count is set.
+	 */
+	FChunkChannelAggregate GetAggregate(const FCellChannelHandle Handle);
+
+	/** Like GetAggregate but a stale summary is rebuilt without being kept, safe to call from several threads. */
+	FChunkChannelAggregate GetAggregate(const FCellChannelHandle Handle) const;
+
+	/** Summary of the channel over the cells of Region (Max exclusive), the kept one if Region covers the chunk. */
+	FChunkChannelAggregate AggregateRegion(const FCellChannelHandle Handle, const FIntRect& Region);
+
+	FChunkChannelAggregate AggregateRegion(const FCellChannelHandle Handle, const FIntRect& Region) const;
+
+	// Columns
+	// Column channels keep their values unboxed in one contiguous buffer per (name, type) instead of
+	// an FInstancedStruct per cell. They are a separate store from the boxed channels above: columns
+	// have no channel mask and are not seen by HasChannel, FindChannel, IterateChannel or the queries.
+
+	template <typename TStruct>
+	TColumnIteratorRange<TStruct> IterateColumn(const FName Name);
+
+	template <typename TStruct>
+	TConstColumnIteratorRange<TStruct> IterateColumn(const FName Name) const;
+
+	template <typename TStruct>
+	FORCEINLINE TStruct& FindOrAddColumnValue(const FName Name, const FIntPoint& InCellPoint)
+	{
+		static_assert(TIsDerivedFrom<TStruct, FCellBaseInfo>::Value, "TStruct must be derived from FCellBaseInfo");
+
+		return *reinterpret_cast<TStruct*>(FindOrAddColumnValue(Name, InCellPoint, TStruct::StaticStruct()).
+			GetMemory());
+	}
+
+	FORCEINLINE FStructView FindOrAddColumnValue(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::FindOrAddColumnValue)
+
+		checkf(IsInside(InCellPoint), TEXT("Cell %s is outside of chunk [%s, %s]"), *InCellPoint.ToString(),
+		       *GetTopLeft().ToString(), *GetBottomRight().ToString());
+		checkf(Type && Type->IsChildOf(FCellBaseInfo::StaticStruct()), TEXT("Column type must derive from FCellBaseInfo"));
+
+		FChunkChannelColumn& Column = FindOrAddColumn({Name, Type});
+		return FStructView(Type, Column.FindOrAdd(GetCellIndex(InCellPoint)));
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TStruct* FindColumnValue(const FName Name, const FIntPoint& InCellPoint)
+	{
+		return reinterpret_cast<TStruct*>(FindColumnValue(Name, InCellPoint, TStruct::StaticStruct()).GetMemory());
+	}
+
+	template <typename TStruct>
+	FORCEINLINE const TStruct* FindColumnValue(const FName Name, const FIntPoint& InCellPoint) const
+	{
+		return reinterpret_cast<const TStruct*>(FindColumnValue(Name, InCellPoint, TStruct::StaticStruct()).
+			GetMemory());
+	}
+
+	FORCEINLINE FStructView FindColumnValue(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
+	{
+		FChunkChannelColumn* const Column = Columns.Find({Name, Type});
+		if (!Column || !IsInside(InCellPoint))
+		{
+			return FStructView();
 		}
 
-		return *OptStruct;
+		return FStructView(Type, Column->Find(GetCellIndex(InCellPoint)));
 	}
 
-	FORCEINLINE FInstancedStruct& GetOrAddChannel(const FName Name, UScriptStruct* Type)
+	FORCEINLINE FConstStructView FindColumnValue(const FName Name, const FIntPoint& InCellPoint,
+	                                             UScriptStruct* Type) const
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::GetOrAddChannel)
-
-		const FCellChannelKey Key{Name, Type};
-		TOptional<FInstancedStruct>& OptStruct = Channels.FindOrAdd(Key);
-		if (!OptStruct.IsSet())
+		const FChunkChannelColumn* const Column = Columns.Find({Name, Type});
+		if (!Column || !IsInside(InCellPoint))
 		{
-			FInstancedStruct NewStruct;
-			NewStruct.InitializeAs(Type);
-
-			OptStruct = NewStruct;
+			return FConstStructView();
 		}
 
-		return *OptStruct;
+		return FConstStructView(Type, Column->Find(GetCellIndex(InCellPoint)));
 	}
 
 	template <typename TStruct>
-	FORCEINLINE bool RemoveChannel(const FName Name)
+	FORCEINLINE bool TryRemoveColumnValue(const FName Name, const FIntPoint& InCellPoint)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_RemoveChannel)
-
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		if (!Channels.Contains(Key))
-		{
-			return false;
-		}
-
-		Channels.Remove(Key);
-		return true;
+		return TryRemoveColumnValue(Name, InCellPoint, TStruct::StaticStruct());
 	}
 
-	FORCEINLINE bool RemoveChannel(const FName Name, UScriptStruct* Type)
+	FORCEINLINE bool TryRemoveColumnValue(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::RemoveChannel)
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::TryRemoveColumnValue)
 
 		const FCellChannelKey Key{Name, Type};
-		if (!Channels.Contains(Key))
+		FChunkChannelColumn* const Column = Columns.Find(Key);
+		if (!Column || !IsInside(InCellPoint) || !Column->Remove(GetCellIndex(InCellPoint)))
 		{
 			return false;
 		}
 
-		Channels.Remove(Key);
+		if (Column->IsEmpty())
+		{
+			Columns.Remove(Key);
+		}
+
 		return true;
 	}
 
 	template <typename TStruct>
-	FORCEINLINE bool HasChannel(const FName Name) const
+	FORCEINLINE bool HasColumnValue(const FName Name, const FIntPoint& InCellPoint) const
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_HasChannel)
+		return HasColumnValue(Name, InCellPoint, TStruct::StaticStruct());
+	}
 
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		return Channels.Contains(Key);
+	FORCEINLINE bool HasColumnValue(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type) const
+	{
+		const FChunkChannelColumn* const Column = Columns.Find({Name, Type});
+		return Column && IsInside(InCellPoint) && Column->Contains(GetCellIndex(InCellPoint));
 	}
 
-	FORCEINLINE bool HasChannel(const FName Name, UScriptStruct* Type) const
+	FORCEINLINE const TMap<FCellChannelKey, FChunkChannelColumn>& GetColumns() const
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::HasChannel)
+		return Columns;
+	}
 
-		const FCellChannelKey Key{Name, Type};
-		return Channels.Contains(Key);
+	FORCEINLINE const FChunkCellStorageSettings& GetStorageSettings() const
+	{
+		return StorageSettings;
 	}
 
-	template <typename TStruct>
-	FORCEINLINE FInstancedStruct* FindChannel(const FName Name)
+	/** Whether the cells are currently kept in the dense layout. */
+	FORCEINLINE bool IsDense() const
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_FindChannel)
+		return bDense;
+	}
 
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		TOptional<FInstancedStruct>* const OptStruct = Channels.Find(Key);
-		if (!OptStruct || !OptStruct->IsSet())
-		{
-			return nullptr;
-		}
+	/** Number of cells holding at least one channel. */
+	FORCEINLINE int32 GetNumOccupiedCells() const
+	{
+		return NumOccupiedCells;
+	}
+
+	virtual void DrawDebug(const UWorld* World, const TFunction<FVector(const FIntPoint&)>& Convertor) const override;
+
+private:
+	FORCEINLINE bool IsInside(const FIntPoint& InCellPoint) const
+	{
+		const FIntPoint& TL = GetTopLeft();
+		const FIntPoint& BR = GetBottomRight();
 
-		return &OptStruct->GetValue();
+		return InCellPoint.X >= TL.X && InCellPoint.X <= BR.X && InCellPoint.Y >= TL.Y && InCellPoint.Y <= BR.Y;
 	}
 
-	template <typename TStruct>
-	FORCEINLINE const FInstancedStruct* FindChannel(const FName Name) const
+	FORCEINLINE int32 GetCellIndex(const FIntPoint& InCellPoint) const
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::Template_FindChannel)
+		const FIntPoint& TL = GetTopLeft();
+		return (InCellPoint.X - TL.X) * Height + (InCellPoint.Y - TL.Y);
+	}
 
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		const TOptional<FInstancedStruct>* const OptStruct = Channels.Find(Key);
-		if (!OptStruct || !OptStruct->IsSet())
-		{
-			return nullptr;
-		}
+	FORCEINLINE FIntPoint GetCellPoint(const int32 InCellIndex) const
+	{
+		const FIntPoint& TL = GetTopLeft();
+		return FIntPoint(TL.X + InCellIndex / Height, TL.Y + InCellIndex % Height);
+	}
 
-		return &OptStruct->GetValue();
+	/** Region (Max exclusive) clipped to the cells of the chunk, empty if they do not overlap. */
+	FORCEINLINE FIntRect ClipRegion(const FIntRect& Region) const
+	{
+		const FIntPoint& TL = GetTopLeft();
+		const FIntRect Clipped(FIntPoint(FMath::Max(Region.Min.X, TL.X), FMath::Max(Region.Min.Y, TL.Y)),
+		                       FIntPoint(FMath::Min(Region.Max.X, TL.X + Width), FMath::Min(Region.Max.Y, TL.Y + Height)));
+
+		return Clipped.Min.X < Clipped.Max.X && Clipped.Min.Y < Clipped.Max.Y ? Clipped : FIntRect();
 	}
 
-	FORCEINLINE FInstancedStruct* FindChannel(const FName Name, UScriptStruct* Type)
+	FORCEINLINE FCellDynamicInfo* FindCell(const FIntPoint& InCellPoint)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::FindChannel);
+		return IsInside(InCellPoint) ? FindCellAt(GetCellIndex(InCellPoint)) : nullptr;
+	}
 
-		const FCellChannelKey Key{Name, Type};
-		TOptional<FInstancedStruct>* const OptionalStruct = Channels.Find(Key);
-		if (!OptionalStruct || !OptionalStruct->IsSet())
-		{
-			return nullptr;
-		}
+	FORCEINLINE const FCellDynamicInfo* FindCell(const FIntPoint& InCellPoint) const
+	{
+		return IsInside(InCellPoint) ? FindCellAt(GetCellIndex(InCellPoint)) : nullptr;
+	}
 
-		return &OptionalStruct->GetValue();
+	/** Cell at a local index, null if the map layout has nothing written there. */
+	FORCEINLINE FCellDynamicInfo* FindCellAt(const int32 CellIndex)
+	{
+		return bDense ? &DenseCells[CellIndex] : MapCells.Find(CellIndex);
 	}
 
-	FORCEINLINE const FInstancedStruct* FindChannel(const FName Name, UScriptStruct* Type) const
+	FORCEINLINE const FCellDynamicInfo* FindCellAt(const int32 CellIndex) const
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCellDynamicInfo::FindChannel_Const);
+		return bDense ? &DenseCells[CellIndex] : MapCells.Find(CellIndex);
+	}
 
-		const FCellChannelKey Key{Name, Type};
-		const TOptional<FInstancedStruct>* const OptionalStruct = Channels.Find(Key);
-		if (!OptionalStruct || !OptionalStruct->IsSet())
-		{
-			return nullptr;
-		}
+	FORCEINLINE FCellDynamicInfo& FindOrAddCell(const FIntPoint& InCellPoint)
+	{
+		checkf(IsInside(InCellPoint), TEXT("Cell %s is outside of chunk [%s, %s]"), *InCellPoint.ToString(),
+		       *GetTopLeft().ToString(), *GetBottomRight().ToString());
 
-		return &OptionalStruct->GetValue();
+		const int32 CellIndex = GetCellIndex(InCellPoint);
+		return bDense ? DenseCells[CellIndex] : MapCells.FindOrAdd(CellIndex);
 	}
 
-	FORCEINLINE bool IsEmpty() const
+	/** Accounts for a channel about to be added to the cell, switching layout before any reference is handed out. */
+	void PrepareCellForWrite(const FIntPoint& InCellPoint);
+
+	/** Accounts for a cell that lost its last channel. */
+	void ReleaseCell(const FIntPoint& InCellPoint);
+
+	void ConvertToDense();
+	void ConvertToMap();
+
+	template <typename FuncType>
+	void ForEachCell(FuncType&& Func);
+
+	template <typename FuncType>
+	void ForEachCell(FuncType&& Func) const;
+
+	void InitializeCells();
+
+	struct FAggregateSummary
+	{
+		FCellChannelHandle Handle;
+		FChunkAggregateField Field;
+		FChunkChannelAggregate Value;
+		bool bStale = true;
+	};
+
+	FORCEINLINE const FAggregateSummary* FindAggregate(const FCellChannelHandle Handle) const
 	{
-		return Channels.IsEmpty();
+		return Aggregates.FindByPredicate([Handle](const FAggregateSummary& Summary)
+		{
+			return Summary.Handle == Handle;
+		});
 	}
 
-	FORCEINLINE int32 Num() const
+	FORCEINLINE FAggregateSummary* FindAggregate(const FCellChannelHandle Handle)
 	{
-		return Channels.Num();
+		return const_cast<FAggregateSummary*>(AsConst(*this).FindAggregate(Handle));
 	}
 
-	FORCEINLINE const TMap<FCellChannelKey, TOptional<FInstancedStruct>>& GetChannels() const
+	FORCEINLINE void MarkAggregateStale(const FCellChannelHandle Handle)
 	{
-		return Channels;
+		if (Aggregates.IsEmpty())
+		{
+			return;
+		}
+
+		if (FAggregateSummary* const Summary = FindAggregate(Handle))
+		{
+			Summary->bStale = true;
+		}
 	}
 
-	void DrawDebug(const UWorld* World, const FVector& CellCenter) const;
+	/** Takes a value about to be removed out of the summary of the channel. */
+	void RemoveFromAggregate(const FCellChannelHandle Handle, const FInstancedStruct* Value);
 
-private:
-	TMap<FCellChannelKey, TOptional<FInstancedStruct>> Channels;
-};
+	/** Replaces OldValue, nullptr for a new channel, by NewValue in the summary of the channel. */
+	void ReplaceInAggregate(const FCellChannelHandle Handle, const FInstancedStruct* OldValue,
+	                        const FInstancedStruct& NewValue);
 
-/**
- * Chunk implementation that stores per-cell dynamic data channels.
- *
- * Each cell within the chunk can hold arbitrary user defined structures
- * wrapped in FInstancedStruct and can be serialized to or from an archive.
- */
-class SIMPLECHUNKSYSTEM_API FChunk_DynamicData : public FChunkBase
-{
-	using Super = FChunkBase;
+	/** Reduces the field over the cells of the clipped region holding the channel. */
+	FChunkChannelAggregate ComputeAggregate(const FCellChannelHandle Handle, const FChunkAggregateField& Field,
+	                                        const FIntRect& Clipped) const;
 
-	template <typename TStruct, bool bConst>
-	class TChannelIteratorRangeImpl;
+	FChunkChannelColumn& FindOrAddColumn(const FCellChannelKey& Key);
+	void SerializeColumns(FArchive& Ar);
 
-	template <typename TStruct>
-	using TChannelIteratorRange = TChannelIteratorRangeImpl<TStruct, false>;
+	void RegisterChannelLocation(const FCellChannelHandle Handle, const FIntPoint& CellPoint);
+	void UnregisterChannelLocation(const FCellChannelHandle Handle, const FIntPoint& CellPoint);
 
-	template <typename TStruct>
-	using TConstChannelIteratorRange = TChannelIteratorRangeImpl<TStruct, true>;
+	void RebuildChannelIndex();
 
-public:
-	FChunk_DynamicData(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight);
+private:
+	FChunkCellStorageSettings StorageSettings;
 
-public:
-	virtual void Serialize(FArchive& Ar) override;
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 NumOccupiedCells = 0;
 
-public:
-	template <typename TStruct>
-	TChannelIteratorRange<TStruct> IterateChannel(const FName Name);
+	/** Current layout, only changes at runtime for EChunkCellStorage::Adaptive. */
+	bool bDense = false;
 
-	template <typename TStruct>
-	TConstChannelIteratorRange<TStruct> IterateChannel(const FName Name) const;
+	/** Cells of the chunk in X-major order, used by the dense layout. */
+	TArray<FCellDynamicInfo> DenseCells;
 
-	template <typename TStruct>
-	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FName Name, const FIntPoint& InCellPoint)
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::Template_FindOrAddChannel)
+	/** Written cells of the chunk keyed by local index, used by the map layout. */
+	TMap<int32, FCellDynamicInfo> MapCells;
+
+	/** One bit per cell for every channel present in the chunk. */
+	TMap<FCellChannelHandle, FChunkCellMask> ChannelMasks;
 
-		if (!HasChannel<TStruct>(Name, InCellPoint))
+	TMap<FCellChannelKey, FChunkChannelColumn> Columns;
+
+	/** Channels with a summary, usually few so they are searched linearly. */
+	TArray<FAggregateSummary> Aggregates;
+};
+
+template <typename FuncType>
+void FChunk_DynamicData::ForEachCell(FuncType&& Func)
+{
+	if (bDense)
+	{
+		for (int32 Index = 0; Index < DenseCells.Num(); ++Index)
 		{
-			RegisterChannelLocation({Name, TStruct::StaticStruct()}, InCellPoint);
+			Func(GetCellPoint(Index), DenseCells[Index]);
 		}
 
-		return Cells[InCellPoint].GetOrAddChannel<TStruct>(Name);
+		return;
 	}
 
-	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
+	for (TPair<int32, FCellDynamicInfo>& Cell : MapCells)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::FindOrAddChannel)
+		Func(GetCellPoint(Cell.Key), Cell.Value);
+	}
+}
 
-		if (!HasChannel(Name, InCellPoint, Type))
+template <typename FuncType>
+void FChunk_DynamicData::ForEachCell(FuncType&& Func) const
+{
+	if (bDense)
+	{
+		for (int32 Index = 0; Index < DenseCells.Num(); ++Index)
 		{
-			RegisterChannelLocation({Name, Type}, InCellPoint);
+			Func(GetCellPoint(Index), DenseCells[Index]);
 		}
 
-		return Cells[InCellPoint].GetOrAddChannel(Name, Type);
+		return;
 	}
 
-	template <typename TStruct>
-	FORCEINLINE bool TryRemoveChannel(const FName Name, const FIntPoint& InCellPoint)
+	for (const TPair<int32, FCellDynamicInfo>& Cell : MapCells)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::Template_TryRemoveChannel)
+		Func(GetCellPoint(Cell.Key), Cell.Value);
+	}
+}
 
-		const bool bRemoved = Cells[InCellPoint].RemoveChannel<TStruct>(Name);
-		if (bRemoved)
+template <typename TStruct, bool bConst>
+class FChunk_DynamicData::TChannelIteratorRangeImpl
+{
+	using OwnerType = std::conditional_t<bConst, const FChunk_DynamicData*, FChunk_DynamicData*>;
+	using StructType = std::conditional_t<bConst, const TStruct, TStruct>;
+
+	class FIterator
+	{
+		using FReturnType = TPair<FIntPoint, StructType&>;
+
+	public:
+		FIterator() = default;
+
+		FIterator(OwnerType InOwner, const FCellChannelHandle InHandle, const FChunkCellMask* InMask,
+		          const int32 InStartIndex)
+			: Owner(InOwner)
+			  , Handle(InHandle)
+			  , Mask(InMask)
+			  , Index(InMask ? InMask->FindFrom(InStartIndex) : INDEX_NONE)
 		{
-			UnregisterChannelLocation({Name, TStruct::StaticStruct()}, InCellPoint);
 		}
 
-		return bRemoved;
-	}
+		FIterator& operator++()
+		{
+			if (Index != INDEX_NONE)
+			{
+				Index = Mask->FindFrom(Index + 1);
+			}
 
-	FORCEINLINE bool TryRemoveChannel(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::TryRemoveChannel)
+			return *this;
+		}
 
-		const bool bRemoved = Cells[InCellPoint].RemoveChannel(Name, Type);
-		if (bRemoved)
+		bool operator==(const FIterator& Other) const
 		{
-			UnregisterChannelLocation({Name, Type}, InCellPoint);
+			return Mask == Other.Mask && Index == Other.Index;
 		}
 
-		return bRemoved;
-	}
+		bool operator!=(const FIterator& Other) const
+		{
+			return !(*this == Other);
+		}
 
-	template <typename TStruct>
-	FORCEINLINE bool HasChannel(const FName Name, const FIntPoint& InCellPoint) const
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::Template_HasChannel)
+		bool IsValid() const
+		{
+			return Index != INDEX_NONE;
+		}
 
-		return Cells[InCellPoint].HasChannel<TStruct>(Name);
-	}
+		explicit operator bool() const
+		{
+			return IsValid();
+		}
 
-	FORCEINLINE bool HasChannel(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type) const
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FChunk_DynamicData::HasChannel)
+		FReturnType operator*() const
+		{
+			check(Owner && Mask && Index != INDEX_NONE);
 
-		return Cells[InCellPoint].HasChannel(Name, Type);
-	}
+			// The cell is addressed by its local index, no point to index round trip.
+			auto* const CellInfo = Owner->FindCellAt(Index);
+			check(CellInfo != nullptr);
 
-	template <typename TStruct>
-	FORCEINLINE FInstancedStruct* FindChannel(const FName Name, const FIntPoint& InCellPoint)
+			auto* const Struct = CellInfo->FindChannel(Handle);
+			check(Struct != nullptr);
+			checkSlow(Struct->GetScriptStruct() && Struct->GetScriptStruct()->IsChildOf(TStruct::StaticStruct()));
+
+			if constexpr (bConst)
+			{
+				return {Owner->GetCellPoint(Index), *reinterpret_cast<StructType*>(Struct->GetMemory())};
+			}
+			else
+			{
+				return {Owner->GetCellPoint(Index), *reinterpret_cast<StructType*>(Struct->GetMutableMemory())};
+			}
+		}
+
+	private:
+		OwnerType Owner = nullptr;
+		FCellChannelHandle Handle;
+		const FChunkCellMask* Mask = nullptr;
+		int32 Index = INDEX_NONE;
+	};
+
+public:
+	/**
+	 * Walks the channel mask of the chunk in place, nothing is copied. Channels must not be added to or
+	 * removed from the chunk while iterating, values may be written.
+	 */
+	TChannelIteratorRangeImpl(OwnerType InOwner, const FCellChannelHandle InHandle, const FChunkCellMask* InMask)
+		: Owner(InOwner)
+		  , Handle(InHandle)
+		  , Mask(InMask)
 	{
-		return FindChannel(Name, InCellPoint, TStruct::StaticStruct());
 	}
 
-	template <typename TStruct>
-	FORCEINLINE const FInstancedStruct* FindChannel(const FName Name, const FIntPoint& InCellPoint) const
+	FIterator begin() const
 	{
-		return FindChannel(Name, InCellPoint, TStruct::StaticStruct());
+		return FIterator(Owner, Handle, Mask, 0);
 	}
 
-	FORCEINLINE FInstancedStruct* FindChannel(const FName Name, const FIntPoint& InCellPoint, UScriptStruct* Type)
+	FIterator end() const
 	{
-		FCellDynamicInfo* const CellInfo = Cells.Find(InCellPoint);
-		if (!CellInfo)
-		{
-			return nullptr;
-		}
-
-		return CellInfo->FindChannel(Name, Type);
+		return FIterator(Owner, Handle, Mask, Mask ? Mask->Num() : 0);
 	}
 
-	FORCEINLINE const FInstancedStruct* FindChannel(const FName Name, const FIntPoint& InCellPoint,
-	                                                UScriptStruct* Type) const
+	bool IsEmpty() const
 	{
-		const FCellDynamicInfo* const CellInfo = Cells.Find(InCellPoint);
-		if (!CellInfo)
-		{
-			return nullptr;
-		}
-
-		return CellInfo->FindChannel(Name, Type);
+		return !Mask || Mask->IsEmpty();
 	}
 
-	FORCEINLINE const TMap<FCellChannelKey, TSet<FIntPoint>>& GetChannelIndex() const
+	int32 Num() const
 	{
-		return ChannelIndex;
+		return Mask ? Mask->CountSetBits() : 0;
 	}
 
-	virtual void DrawDebug(const UWorld* World, const TFunction<FVector(const FIntPoint&)>& Convertor) const override;
-
 private:
-	void RegisterChannelLocation(const FCellChannelKey& Key, const FIntPoint& CellPoint);
-	void UnregisterChannelLocation(const FCellChannelKey& Key, const FIntPoint& CellPoint);
+	OwnerType Owner = nullptr;
+	FCellChannelHandle Handle;
+	const FChunkCellMask* Mask = nullptr;
+};
+
+template <typename TStruct>
+FChunk_DynamicData::TChannelIteratorRange<TStruct> FChunk_DynamicData::IterateChannel(const FName Name)
+{
+	return IterateChannel<TStruct>(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+}
 
-	const TSet<FIntPoint>* FindChannelLocations(const FCellChannelKey& Key) const;
-	TSet<FIntPoint>* FindChannelLocations(const FCellChannelKey& Key);
+template <typename TStruct>
+FChunk_DynamicData::TConstChannelIteratorRange<TStruct> FChunk_DynamicData::IterateChannel(const FName Name) const
+{
+	return IterateChannel<TStruct>(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+}
 
-	void RebuildChannelIndex();
+template <typename TStruct>
+FChunk_DynamicData::TChannelIteratorRange<TStruct> FChunk_DynamicData::IterateChannel(const FCellChannelHandle Handle)
+{
+	// Values may be written through the range.
+	MarkAggregateStale(Handle);
+	return TChannelIteratorRangeImpl<TStruct, false>(this, Handle, FindChannelMask(Handle));
+}
 
-private:
-	TMap<FIntPoint, FCellDynamicInfo> Cells;
-	TMap<FCellChannelKey, TSet<FIntPoint>> ChannelIndex;
-};
+template <typename TStruct>
+FChunk_DynamicData::TConstChannelIteratorRange<TStruct> FChunk_DynamicData::IterateChannel(
+	const FCellChannelHandle Handle) const
+{
+	return TChannelIteratorRangeImpl<TStruct, true>(this, Handle, FindChannelMask(Handle));
+}
 
 template <typename TStruct, bool bConst>
-class FChunk_DynamicData::TChannelIteratorRangeImpl
+class FChunk_DynamicData::TColumnIteratorRangeImpl
 {
 	using OwnerType = std::conditional_t<bConst, const FChunk_DynamicData*, FChunk_DynamicData*>;
-	using StructRefType = std::conditional_t<bConst, const TStruct&, TStruct&>;
+	using ColumnType = std::conditional_t<bConst, const FChunkChannelColumn*, FChunkChannelColumn*>;
+	using StructType = std::conditional_t<bConst, const TStruct, TStruct>;
 
 	class FIterator
 	{
-		using FReturnType = TPair<FIntPoint, StructRefType>;
+		using FReturnType = TPair<FIntPoint, StructType&>;
 
 	public:
 		FIterator() = default;
 
-		FIterator(OwnerType InOwner, const FCellChannelKey* InKey, const TArray<FIntPoint>* InLocations, int32 InIndex)
+		FIterator(OwnerType InOwner, ColumnType InColumn, const int32 InStartIndex)
 			: Owner(InOwner)
-			  , Key(InKey)
-			  , Locations(InLocations)
-			  , Index(InIndex)
+			  , Column(InColumn)
+			  , Index(InColumn ? InColumn->GetOccupancy().FindFrom(InStartIndex) : INDEX_NONE)
 		{
 		}
 
 		FIterator& operator++()
 		{
-			++Index;
+			if (Index != INDEX_NONE)
+			{
+				Index = Column->GetOccupancy().FindFrom(Index + 1);
+			}
+
 			return *this;
 		}
 
 		bool operator==(const FIterator& Other) const
 		{
-			return Locations == Other.Locations && Index == Other.Index;
+			return Column == Other.Column && Index == Other.Index;
 		}
 
 		bool operator!=(const FIterator& Other) const
@@ -405,7 +1370,7 @@ class FChunk_DynamicData::TChannelIteratorRangeImpl
 
 		bool IsValid() const
 		{
-			return Index < Locations->Num();
+			return Index != INDEX_NONE;
 		}
 
 		explicit operator bool() const
@@ -415,83 +1380,56 @@ class FChunk_DynamicData::TChannelIteratorRangeImpl
 
 		FReturnType operator*() const
 		{
-			check(Locations && Key && Owner);
-			check(Index >= 0 && Index < Locations->Num());
-
-			const FIntPoint& CellPoint = (*Locations)[Index];
-
-			if constexpr (bConst)
-			{
-				const FInstancedStruct* const Struct = Owner->FindChannel(Key->ChannelName, CellPoint, Key->Type);
-				check(Struct != nullptr);
-				return {CellPoint, *Struct->GetPtr<TStruct>()};
-			}
-			else
-			{
-				FInstancedStruct* const Struct = Owner->FindChannel(Key->ChannelName, CellPoint, Key->Type);
-				check(Struct != nullptr);
-				return {CellPoint, *Struct->GetMutablePtr<TStruct>()};
-			}
+			check(Owner && Column && Index != INDEX_NONE);
+			return {Owner->GetCellPoint(Index), *reinterpret_cast<StructType*>(Column->GetMemory(Index))};
 		}
 
 	private:
 		OwnerType Owner = nullptr;
-		const FCellChannelKey* Key = nullptr;
-		const TArray<FIntPoint>* Locations = nullptr;
-		int32 Index = 0;
+		ColumnType Column = nullptr;
+		int32 Index = INDEX_NONE;
 	};
 
 public:
-	TChannelIteratorRangeImpl(OwnerType InOwner, const FCellChannelKey& InKey, const TSet<FIntPoint>* InLocations)
+	TColumnIteratorRangeImpl(OwnerType InOwner, ColumnType InColumn)
 		: Owner(InOwner)
-		  , Key(InKey)
+		  , Column(InColumn)
 	{
-		if (InLocations)
-		{
-			Locations.Reserve(InLocations->Num());
-			for (const FIntPoint& Location : *InLocations)
-			{
-				Locations.Emplace(Location);
-			}
-		}
 	}
 
 	FIterator begin() const
 	{
-		return FIterator(Owner, &Key, &Locations, 0);
+		return FIterator(Owner, Column, 0);
 	}
 
 	FIterator end() const
 	{
-		return FIterator(Owner, &Key, &Locations, Locations.Num());
+		return FIterator(Owner, Column, Column ? Column->GetNumCells() : 0);
 	}
 
 	bool IsEmpty() const
 	{
-		return Locations.Num() == 0;
+		return !Column || Column->IsEmpty();
 	}
 
 	int32 Num() const
 	{
-		return Locations.Num();
+		return Column ? Column->Num() : 0;
 	}
 
 private:
 	OwnerType Owner = nullptr;
-	FCellChannelKey Key;
-	TArray<FIntPoint> Locations;
+	ColumnType Column = nullptr;
 };
 
 template <typename TStruct>
-FChunk_DynamicData::TChannelIteratorRange<TStruct> FChunk_DynamicData::IterateChannel(const FName Name)
+FChunk_DynamicData::TColumnIteratorRange<TStruct> FChunk_DynamicData::IterateColumn(const FName Name)
 {
-	const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-	return TChannelIteratorRangeImpl<TStruct, false>(this, Key, FindChannelLocations(Key));
+	return TColumnIteratorRangeImpl<TStruct, false>(this, Columns.Find({Name, TStruct::StaticStruct()}));
 }
 
 template <typename TStruct>
-FChunk_DynamicData::TConstChannelIteratorRange<TStruct> FChunk_DynamicData::IterateChannel(const FName Name) const
+FChunk_DynamicData::TConstColumnIteratorRange<TStruct> FChunk_DynamicData::IterateColumn(const FName Name) const
 {
-	const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-	return TChannelIteratorRangeImpl<TStruct, true>(this, Key, FindChannelLocations(Key));
+	return TColumnIteratorRangeImpl<TStruct, true>(this, Columns.Find({Name, TStruct::StaticStruct()}));
 }
@@ -0,0 +1,266 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChunkBase.h"
+#include "ChunkCellMask.h"
+
+/**
+ * Chunk that stores a compile time list of channel types.
+ *
+ * Every channel type gets a plain TArray with one value per cell, allocated
+ * on the first write, and an occupancy mask. Channels are addressed by type
+ * so access resolves to an array index without any reflection or boxing.
+ * Values are serialized with operator<<(FArchive&, TStruct&).
+ *
+ * @tparam TStructs Channel types, each type may appear once.
+ */
+template <typename... TStructs>
+class TChunk_Typed : public FChunkBase
+{
+	using Super = FChunkBase;
+
+	static_assert(sizeof...(TStructs) > 0, "TChunk_Typed needs at least one channel type");
+
+	template <typename TStruct>
+	static constexpr bool TIsChannel = (std::is_same_v<TStruct, TStructs> || ...);
+
+	template <typename TStruct>
+	struct TChannel
+	{
+		/** Empty until the first value is written, NumCells values afterwards. */
+		TArray<TStruct> Values;
+		FChunkCellMask Occupancy;
+	};
+
+public:
+	TChunk_Typed(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight)
+		: FChunkBase(InTopLeft, InBottomRight)
+	{
+		InitializeChannels();
+	}
+
+public:
+	virtual void Serialize(FArchive& Ar) override
+	{
+		Super::Serialize(Ar);
+
+		if (Ar.IsLoading())
+		{
+			InitializeChannels();
+		}
+
+		VisitChannels([this, &Ar](auto& Channel)
+		{
+			SerializeChannel(Ar, Channel);
+		});
+	}
+
+	virtual void Reset(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight) override
+	{
+		Super::Reset(InTopLeft, InBottomRight);
+		InitializeChannels();
+	}
+
+public:
+	template <typename TStruct>
+	FORCEINLINE TStruct& FindOrAdd(const FIntPoint& InCellPoint)
+	{
+		checkf(IsInside(InCellPoint), TEXT("Cell %s is outside of chunk [%s, %s]"), *InCellPoint.ToString(),
+		       *GetTopLeft().ToString(), *GetBottomRight().ToString());
+
+		TChannel<TStruct>& Channel = GetChannel<TStruct>();
+		if (Channel.Values.IsEmpty())
+		{
+			Channel.Values.SetNum(NumCells);
+		}
+
+		const int32 CellIndex = GetCellIndex(InCellPoint);
+		Channel.Occupancy.Set(CellIndex);
+		return Channel.Values[CellIndex];
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TStruct* Find(const FIntPoint& InCellPoint)
+	{
+		return const_cast<TStruct*>(AsConst(*this).template Find<TStruct>(InCellPoint));
+	}
+
+	template <typename TStruct>
+	FORCEINLINE const TStruct* Find(const FIntPoint& InCellPoint) const
+	{
+		const TChannel<TStruct>& Channel = GetChannel<TStruct>();
+		if (!IsInside(InCellPoint))
+		{
+			return nullptr;
+		}
+
+		const int32 CellIndex = GetCellIndex(InCellPoint);
+		return Channel.Occupancy.Get(CellIndex) ? &Channel.Values[CellIndex] : nullptr;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool Contains(const FIntPoint& InCellPoint) const
+	{
+		return IsInside(InCellPoint) && GetChannel<TStruct>().Occupancy.Get(GetCellIndex(InCellPoint));
+	}
+
+	/** Resets the value to its default and marks the cell as empty. */
+	template <typename TStruct>
+	FORCEINLINE bool Remove(const FIntPoint& InCellPoint)
+	{
+		if (!Contains<TStruct>(InCellPoint))
+		{
+			return false;
+		}
+
+		TChannel<TStruct>& Channel = GetChannel<TStruct>();
+		const int32 CellIndex = GetCellIndex(InCellPoint);
+
+		Channel.Values[CellIndex] = TStruct();
+		Channel.Occupancy.Clear(CellIndex);
+		return true;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool HasAny() const
+	{
+		return !GetChannel<TStruct>().Occupancy.IsEmpty();
+	}
+
+	template <typename TStruct>
+	FORCEINLINE int32 Num() const
+	{
+		return GetChannel<TStruct>().Occupancy.CountSetBits();
+	}
+
+	/** Calls Func(const FIntPoint&, TStruct&) for every cell holding the channel, in local cell order. */
+	template <typename TStruct, typename FuncType>
+	void ForEach(FuncType&& Func)
+	{
+		TChannel<TStruct>& Channel = GetChannel<TStruct>();
+		const FChunkCellMask& Occupancy = Channel.Occupancy;
+
+		for (int32 Index = Occupancy.FindFrom(0); Index != INDEX_NONE; Index = Occupancy.FindFrom(Index + 1))
+		{
+			Func(GetCellPoint(Index), Channel.Values[Index]);
+		}
+	}
+
+	template <typename TStruct, typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		const TChannel<TStruct>& Channel = GetChannel<TStruct>();
+		const FChunkCellMask& Occupancy = Channel.Occupancy;
+
+		for (int32 Index = Occupancy.FindFrom(0); Index != INDEX_NONE; Index = Occupancy.FindFrom(Index + 1))
+		{
+			Func(GetCellPoint(Index), Channel.Values[Index]);
+		}
+	}
+
+	template <typename TStruct>
+	FORCEINLINE const FChunkCellMask& GetOccupancy() const
+	{
+		return GetChannel<TStruct>().Occupancy;
+	}
+
+private:
+	template <typename TStruct>
+	FORCEINLINE TChannel<TStruct>& GetChannel()
+	{
+		static_assert(TIsChannel<TStruct>, "TStruct is not a channel of this chunk");
+		return Channels.template Get<TTupleIndex<TStruct, TTuple<TStructs...>>::Value>();
+	}
+
+	template <typename TStruct>
+	FORCEINLINE const TChannel<TStruct>& GetChannel() const
+	{
+		static_assert(TIsChannel<TStruct>, "TStruct is not a channel of this chunk");
+		return Channels.template Get<TTupleIndex<TStruct, TTuple<TStructs...>>::Value>();
+	}
+
+	template <typename FuncType>
+	FORCEINLINE void VisitChannels(FuncType&& Func)
+	{
+		VisitTupleElements(Func, Channels);
+	}
+
+	void InitializeChannels()
+	{
+		const FIntPoint& TL = GetTopLeft();
+		const FIntPoint& BR = GetBottomRight();
+
+		Height = BR.Y - TL.Y + 1;
+		NumCells = (BR.X - TL.X + 1) * Height;
+
+		// Reset keeps the value arrays allocated for recycled chunks of the same size.
+		VisitChannels([this](auto& Channel)
+		{
+			Channel.Values.Reset();
+			Channel.Occupancy.Init(NumCells);
+		});
+	}
+
+	template <typename TStruct>
+	void SerializeChannel(FArchive& Ar, TChannel<TStruct>& Channel)
+	{
+		int32 Count = Channel.Occupancy.CountSetBits();
+		Ar << Count;
+
+		if (Ar.IsSaving())
+		{
+			const FChunkCellMask& Occupancy = Channel.Occupancy;
+			for (int32 Index = Occupancy.FindFrom(0); Index != INDEX_NONE; Index = Occupancy.FindFrom(Index + 1))
+			{
+				int32 CellIndex = Index;
+				Ar << CellIndex;
+				Ar << Channel.Values[Index];
+			}
+		}
+
+		if (Ar.IsLoading())
+		{
+			for (int32 Index = 0; Index < Count && !Ar.IsError(); ++Index)
+			{
+				int32 CellIndex = INDEX_NONE;
+				Ar << CellIndex;
+
+				if (CellIndex < 0 || CellIndex >= NumCells)
+				{
+					Ar.SetError();
+					return;
+				}
+
+				Ar << FindOrAdd<TStruct>(GetCellPoint(CellIndex));
+			}
+		}
+	}
+
+	FORCEINLINE bool IsInside(const FIntPoint& InCellPoint) const
+	{
+		const FIntPoint& TL = GetTopLeft();
+		const FIntPoint& BR = GetBottomRight();
+
+		return InCellPoint.X >= TL.X && InCellPoint.X <= BR.X && InCellPoint.Y >= TL.Y && InCellPoint.Y <= BR.Y;
+	}
+
+	FORCEINLINE int32 GetCellIndex(const FIntPoint& InCellPoint) const
+	{
+		const FIntPoint& TL = GetTopLeft();
+		return (InCellPoint.X - TL.X) * Height + (InCellPoint.Y - TL.Y);
+	}
+
+	FORCEINLINE FIntPoint GetCellPoint(const int32 InCellIndex) const
+	{
+		const FIntPoint& TL = GetTopLeft();
+		return FIntPoint(TL.X + InCellIndex / Height, TL.Y + InCellIndex % Height);
+	}
+
+private:
+	int32 Height = 0;
+	int32 NumCells = 0;
+
+	TTuple<TChannel<TStructs>...> Channels;
+};
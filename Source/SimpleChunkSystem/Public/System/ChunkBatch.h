@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Point of a batch tagged with its chunk, see TChunkSystemBase::ForEachChunkGroup. */
+struct FChunkBatchItem
+{
+	/** Packed chunk point, items are sorted by it so each chunk is one contiguous group. */
+	uint64 ChunkKey = 0;
+
+	/** Index of the point in the batch passed by the caller. */
+	int32 PointIndex = INDEX_NONE;
+
+	FORCEINLINE bool operator<(const FChunkBatchItem& Other) const
+	{
+		return ChunkKey < Other.ChunkKey || (ChunkKey == Other.ChunkKey && PointIndex < Other.PointIndex);
+	}
+};
+
+/**
+ * Reusable buffer for grouping batch points by chunk.
+ *
+ * Keep one around and pass it to the batch overloads to run any number of
+ * batches without allocating once it has grown to the largest batch.
+ */
+struct FChunkBatchScratch
+{
+	TArray<FChunkBatchItem> Items;
+};
+
+namespace ChunkBatch
+{
+	/** Scratch of the calling thread, used by the batch overloads without an explicit scratch. */
+	FORCEINLINE FChunkBatchScratch& GetThreadScratch()
+	{
+		static thread_local FChunkBatchScratch Scratch;
+		return Scratch;
+	}
+}
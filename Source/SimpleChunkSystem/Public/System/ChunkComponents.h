@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Groups of 4-connected cells holding a channel, see TChunkSystem_DynamicData::LabelComponents.
+ *
+ * Labels are kept per chunk in local cell order, so reading them back needs
+ * no hashing of cells. Component ids go from 0 to Num() - 1.
+ */
+struct SIMPLECHUNKSYSTEM_API FChunkChannelComponents
+{
+	/** Component of the cell, INDEX_NONE if it does not hold the channel. */
+	int32 GetComponent(const FIntPoint& InCell) const;
+
+	FORCEINLINE int32 GetComponentSize(const int32 InComponent) const
+	{
+		return Sizes.IsValidIndex(InComponent) ? Sizes[InComponent] : 0;
+	}
+
+	FORCEINLINE int32 Num() const
+	{
+		return Sizes.Num();
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Sizes.IsEmpty();
+	}
+
+	/** Calls Func(const FIntPoint& Cell, int32 Component) for every cell holding the channel. */
+	template <typename FuncType>
+	void ForEachCell(FuncType&& Func) const
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Pair : ChunkLabels)
+		{
+			const FIntPoint TopLeft = Pair.Key * ChunkSize;
+			const TArray<int32>& Labels = Pair.Value;
+
+			for (int32 Index = 0; Index < Labels.Num(); ++Index)
+			{
+				if (Labels[Index] != INDEX_NONE)
+				{
+					Func(FIntPoint(TopLeft.X + Index / ChunkSize, TopLeft.Y + Index % ChunkSize), Labels[Index]);
+				}
+			}
+		}
+	}
+
+	int32 ChunkSize = 0;
+
+	/** Component of each local cell of the chunks holding the channel, INDEX_NONE where it is absent. */
+	TMap<FIntPoint, TArray<int32>> ChunkLabels;
+
+	/** Number of cells of each component. */
+	TArray<int32> Sizes;
+};
+
+namespace ChunkComponents
+{
+	/** Root of the set of Index in a union-find forest, halves the path on the way. */
+	FORCEINLINE int32 FindRoot(TArray<int32>& Parents, int32 Index)
+	{
+		while (Parents[Index] != Index)
+		{
+			Parents[Index] = Parents[Parents[Index]];
+			Index = Parents[Index];
+		}
+
+		return Index;
+	}
+
+	/** Merges the sets of A and B, the smaller root becomes the root of both. */
+	FORCEINLINE void Union(TArray<int32>& Parents, const int32 A, const int32 B)
+	{
+		const int32 RootA = FindRoot(Parents, A);
+		const int32 RootB = FindRoot(Parents, B);
+
+		if (RootA < RootB)
+		{
+			Parents[RootB] = RootA;
+		}
+		else if (RootB < RootA)
+		{
+			Parents[RootA] = RootB;
+		}
+	}
+}
@@ -0,0 +1,593 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/Sort.h"
+
+namespace ChunkDirectory
+{
+	/** Both coordinates in one key, X in the high half. */
+	FORCEINLINE uint64 PackPoint(const FIntPoint& Point)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(Point.X)) << 32) | static_cast<uint32>(Point.Y);
+	}
+
+	FORCEINLINE FIntPoint UnpackPoint(const uint64 Key)
+	{
+		return FIntPoint(static_cast<int32>(static_cast<uint32>(Key >> 32)), static_cast<int32>(static_cast<uint32>(Key)));
+	}
+
+	/** Spreads the 32 bits of Value to the even bits of the result. */
+	FORCEINLINE uint64 SpreadBits(const uint32 Value)
+	{
+		uint64 Bits = Value;
+		Bits = (Bits | (Bits << 16)) & 0x0000FFFF0000FFFFull;
+		Bits = (Bits | (Bits << 8)) & 0x00FF00FF00FF00FFull;
+		Bits = (Bits | (Bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		Bits = (Bits | (Bits << 2)) & 0x3333333333333333ull;
+		Bits = (Bits | (Bits << 1)) & 0x5555555555555555ull;
+		return Bits;
+	}
+
+	/** MurmurHash3 64 bit finalizer, every input bit affects every output bit. */
+	FORCEINLINE uint64 MixKey(uint64 Key)
+	{
+		Key ^= Key >> 33;
+		Key *= 0xFF51AFD7ED558CCDull;
+		Key ^= Key >> 33;
+		Key *= 0xC4CEB93FE53A2A63ull;
+		Key ^= Key >> 33;
+		return Key;
+	}
+
+	/**
+	 * Z-order code of a point. The sign bit is flipped so negative coordinates
+	 * sort before positive ones and neighbours around the origin stay close.
+	 */
+	FORCEINLINE uint64 MortonEncode(const FIntPoint& Point)
+	{
+		return SpreadBits(static_cast<uint32>(Point.X) ^ 0x80000000u) |
+			(SpreadBits(static_cast<uint32>(Point.Y) ^ 0x80000000u) << 1);
+	}
+}
+
+/**
+ * Open addressing table from chunk point to an int32 value.
+ *
+ * Keys are packed into a uint64 and the home bucket comes from the key run
+ * through a 64 bit finalizer, so strips, clusters and other structured
+ * layouts spread evenly over the table instead of piling into long runs.
+ * Spatial order is left to TChunkDirectory::SortByMortonOrder. Collisions
+ * are resolved by Robin Hood linear probing, and removal shifts entries back
+ * instead of leaving tombstones.
+ */
+class SIMPLECHUNKSYSTEM_API FChunkPointTable
+{
+public:
+	FORCEINLINE int32 Num() const
+	{
+		return Count;
+	}
+
+	FORCEINLINE bool Contains(const FIntPoint& Point) const
+	{
+		return Find(Point) != nullptr;
+	}
+
+	FORCEINLINE const int32* Find(const FIntPoint& Point) const
+	{
+		if (Count == 0)
+		{
+			return nullptr;
+		}
+
+		const uint64 Key = ChunkDirectory::PackPoint(Point);
+		const uint32 Mask = Buckets.Num() - 1;
+
+		for (uint32 Index = GetHomeBucket(Key), Distance = 0; ; Index = (Index + 1) & Mask, ++Distance)
+		{
+			// A resident closer to its home than we are to ours means the key would have displaced it.
+			const FBucket& Bucket = Buckets[Index];
+			if (Bucket.Value == INDEX_NONE || Bucket.Distance < Distance)
+			{
+				return nullptr;
+			}
+
+			if (Bucket.Key == Key)
+			{
+				return &Bucket.Value;
+			}
+		}
+	}
+
+	/** Adds the point, it must not be in the table yet. */
+	void Add(const FIntPoint& Point, const int32 Value);
+
+	bool RemoveAndCopyValue(const FIntPoint& Point, int32& OutValue);
+
+	void Empty(const int32 ExpectedNumElements = 0);
+	void Reserve(const int32 Number);
+	void Shrink();
+
+	/** Longest probe sequence of the current contents, for diagnostics. */
+	int32 GetMaxProbeLength() const;
+
+private:
+	struct FBucket
+	{
+		uint64 Key = 0;
+
+		/** INDEX_NONE marks an empty bucket. */
+		int32 Value = INDEX_NONE;
+
+		/** Probe distance from the home bucket. */
+		uint32 Distance = 0;
+	};
+
+	FORCEINLINE uint32 GetHomeBucket(const uint64 Key) const
+	{
+		return static_cast<uint32>(ChunkDirectory::MixKey(Key)) & (Buckets.Num() - 1);
+	}
+
+	/** Smallest power of two bucket count keeping the load factor at or below 1/2. */
+	static int32 GetBucketCount(const int32 NumElements);
+
+	void Rehash(const int32 NumBuckets);
+
+	void Insert(FBucket Bucket);
+
+private:
+	TArray<FBucket> Buckets;
+	int32 Count = 0;
+};
+
+/**
+ * Stable reference to a chunk of a system.
+ *
+ * A handle stays cheap to copy and compare and can be validated against its
+ * system: once the chunk is removed the slot generation changes and the
+ * handle no longer resolves, even if the slot is reused by another chunk.
+ */
+struct FChunkHandle
+{
+	FChunkHandle() = default;
+
+	FChunkHandle(const int32 InIndex, const uint32 InGeneration)
+		: Index(InIndex)
+		  , Generation(InGeneration)
+	{
+	}
+
+	FORCEINLINE bool IsSet() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	FORCEINLINE int32 GetIndex() const
+	{
+		return Index;
+	}
+
+	FORCEINLINE uint32 GetGeneration() const
+	{
+		return Generation;
+	}
+
+	friend bool operator==(const FChunkHandle Left, const FChunkHandle Right)
+	{
+		return Left.Index == Right.Index && Left.Generation == Right.Generation;
+	}
+
+	friend bool operator!=(const FChunkHandle Left, const FChunkHandle Right)
+	{
+		return !(Left == Right);
+	}
+
+	friend uint32 GetTypeHash(const FChunkHandle Handle)
+	{
+		return HashCombineFast(static_cast<uint32>(Handle.Index), Handle.Generation);
+	}
+
+private:
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+};
+
+/**
+ * Generational slot map of chunks keyed by chunk grid point.
+ *
+ * Entries are packed in one array so sweeps over all chunks are linear,
+ * removal swaps the last entry into the hole. Slots translate handles to
+ * entries and the point lookup only maps a chunk point to its slot.
+ * Iterating yields TPair<FIntPoint, ValueType>& like a TMap would, the
+ * order can be made spatial with SortByMortonOrder. Values move when the
+ * entries grow or are swapped, so systems store chunk pointers here, see
+ * TChunkSystemBase::FChunkPtr.
+ *
+ * With dense bounds the point lookup is a flat array over a fixed rectangle
+ * of chunk points instead of the hash table, points outside of it are
+ * rejected by a range check.
+ */
+template <typename ValueType>
+class TChunkDirectory
+{
+public:
+	using FEntry = TPair<FIntPoint, ValueType>;
+
+	FORCEINLINE int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return Entries.IsEmpty();
+	}
+
+	FORCEINLINE bool Contains(const FIntPoint& Point) const
+	{
+		return FindSlotIndex(Point) != nullptr;
+	}
+
+	FORCEINLINE ValueType* Find(const FIntPoint& Point)
+	{
+		const int32* const SlotIndex = FindSlotIndex(Point);
+		return SlotIndex ? &Entries[Slots[*SlotIndex].EntryIndex].Value : nullptr;
+	}
+
+	FORCEINLINE const ValueType* Find(const FIntPoint& Point) const
+	{
+		const int32* const SlotIndex = FindSlotIndex(Point);
+		return SlotIndex ? &Entries[Slots[*SlotIndex].EntryIndex].Value : nullptr;
+	}
+
+	FORCEINLINE ValueType* Find(const FChunkHandle Handle)
+	{
+		return IsValid(Handle) ? &Entries[Slots[Handle.GetIndex()].EntryIndex].Value : nullptr;
+	}
+
+	FORCEINLINE const ValueType* Find(const FChunkHandle Handle) const
+	{
+		return IsValid(Handle) ? &Entries[Slots[Handle.GetIndex()].EntryIndex].Value : nullptr;
+	}
+
+	FORCEINLINE ValueType& operator[](const FIntPoint& Point)
+	{
+		ValueType* const Value = Find(Point);
+		checkf(Value, TEXT("Chunk %s is not in the directory"), *Point.ToString());
+		return *Value;
+	}
+
+	FORCEINLINE const ValueType& operator[](const FIntPoint& Point) const
+	{
+		const ValueType* const Value = Find(Point);
+		checkf(Value, TEXT("Chunk %s is not in the directory"), *Point.ToString());
+		return *Value;
+	}
+
+	FORCEINLINE FChunkHandle FindHandle(const FIntPoint& Point) const
+	{
+		const int32* const SlotIndex = FindSlotIndex(Point);
+		return SlotIndex ? FChunkHandle(*SlotIndex, Slots[*SlotIndex].Generation) : FChunkHandle();
+	}
+
+	/** True while the chunk the handle was taken from is still in the directory. */
+	FORCEINLINE bool IsValid(const FChunkHandle Handle) const
+	{
+		return Slots.IsValidIndex(Handle.GetIndex()) && Slots[Handle.GetIndex()].Generation == Handle.GetGeneration()
+			&& Slots[Handle.GetIndex()].EntryIndex != INDEX_NONE;
+	}
+
+	/** Chunk point of a valid handle. */
+	FORCEINLINE const FIntPoint* FindPoint(const FChunkHandle Handle) const
+	{
+		return IsValid(Handle) ? &Entries[Slots[Handle.GetIndex()].EntryIndex].Key : nullptr;
+	}
+
+	/** Adds a chunk, the point must not be in the directory yet. */
+	FChunkHandle Emplace(const FIntPoint& Point, ValueType&& Value)
+	{
+		checkf(!IsLocked(), TEXT("Chunk directory changed while locked"));
+		checkf(!Contains(Point), TEXT("Chunk %s is already in the directory"), *Point.ToString());
+		checkf(IsInBounds(Point), TEXT("Chunk %s is outside of the directory bounds"), *Point.ToString());
+
+		int32 SlotIndex;
+		if (!FreeSlots.IsEmpty())
+		{
+			SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+		}
+		else
+		{
+			SlotIndex = Slots.AddDefaulted();
+		}
+
+		FSlot& Slot = Slots[SlotIndex];
+		Slot.EntryIndex = Entries.Emplace(Point, MoveTemp(Value));
+		EntrySlots.Add(SlotIndex);
+
+		if (bDense)
+		{
+			DenseSlots[GetDenseIndex(Point)] = SlotIndex;
+		}
+		else
+		{
+			SlotLookup.Add(Point, SlotIndex);
+		}
+
+		return FChunkHandle(SlotIndex, Slot.Generation);
+	}
+
+	bool RemoveAndCopyValue(const FIntPoint& Point, ValueType& OutValue)
+	{
+		checkf(!IsLocked(), TEXT("Chunk directory changed while locked"));
+
+		int32 SlotIndex;
+		if (bDense)
+		{
+			const int32 DenseIndex = GetDenseIndex(Point);
+			if (DenseIndex == INDEX_NONE || DenseSlots[DenseIndex] == INDEX_NONE)
+			{
+				return false;
+			}
+
+			SlotIndex = DenseSlots[DenseIndex];
+			DenseSlots[DenseIndex] = INDEX_NONE;
+		}
+		else if (!SlotLookup.RemoveAndCopyValue(Point, SlotIndex))
+		{
+			return false;
+		}
+
+		FSlot& Slot = Slots[SlotIndex];
+		const int32 EntryIndex = Slot.EntryIndex;
+		OutValue = MoveTemp(Entries[EntryIndex].Value);
+
+		Entries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+		EntrySlots.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+		if (EntryIndex < Entries.Num())
+		{
+			Slots[EntrySlots[EntryIndex]].EntryIndex = EntryIndex;
+		}
+
+		ReleaseSlot(SlotIndex);
+		return true;
+	}
+
+	bool Remove(const FIntPoint& Point)
+	{
+		ValueType Removed;
+		return RemoveAndCopyValue(Point, Removed);
+	}
+
+	/** Removes every chunk, handles taken before stay invalid. */
+	void Empty(const int32 ExpectedNumElements = 0)
+	{
+		checkf(!IsLocked(), TEXT("Chunk directory changed while locked"));
+
+		for (const int32 SlotIndex : EntrySlots)
+		{
+			ReleaseSlot(SlotIndex);
+		}
+
+		Entries.Empty(ExpectedNumElements);
+		EntrySlots.Empty(ExpectedNumElements);
+
+		if (bDense)
+		{
+			// The dense array covers the bounds, not the contents, so it keeps its size.
+			for (int32& SlotIndex : DenseSlots)
+			{
+				SlotIndex = INDEX_NONE;
+			}
+		}
+		else
+		{
+			SlotLookup.Empty(ExpectedNumElements);
+		}
+	}
+
+	void Reserve(const int32 Number)
+	{
+		checkf(!IsLocked(), TEXT("Chunk directory changed while locked"));
+
+		Entries.Reserve(Number);
+		EntrySlots.Reserve(Number);
+
+		if (!bDense)
+		{
+			SlotLookup.Reserve(Number);
+		}
+	}
+
+	void Shrink()
+	{
+		checkf(!IsLocked(), TEXT("Chunk directory changed while locked"));
+
+		Entries.Shrink();
+		EntrySlots.Shrink();
+		SlotLookup.Shrink();
+	}
+
+	/**
+	 * Switches the point lookup to a flat array over the bounds, Max is exclusive.
+	 * An empty rectangle goes back to the hash table. The directory must be empty.
+	 */
+	void SetDenseBounds(const FIntRect& InBounds)
+	{
+		checkf(IsEmpty(), TEXT("Dense bounds can only be changed on an empty directory"));
+
+		const int64 Width = FMath::Max<int64>(static_cast<int64>(InBounds.Max.X) - InBounds.Min.X, 0);
+		const int64 Height = FMath::Max<int64>(static_cast<int64>(InBounds.Max.Y) - InBounds.Min.Y, 0);
+
+		if (Width * Height == 0)
+		{
+			bDense = false;
+			DenseBounds = FIntRect();
+			DenseHeight = 0;
+			DenseSlots.Empty();
+			return;
+		}
+
+		checkf(Width * Height <= MAX_int32, TEXT("Dense bounds %s are too large"), *InBounds.ToString());
+
+		bDense = true;
+		DenseBounds = InBounds;
+		DenseHeight = static_cast<int32>(Height);
+		DenseSlots.Init(INDEX_NONE, static_cast<int32>(Width * Height));
+		SlotLookup.Empty();
+	}
+
+	FORCEINLINE bool HasDenseBounds() const
+	{
+		return bDense;
+	}
+
+	FORCEINLINE const FIntRect& GetDenseBounds() const
+	{
+		return DenseBounds;
+	}
+
+	/** True if the point can be stored, always true without dense bounds. */
+	FORCEINLINE bool IsInBounds(const FIntPoint& Point) const
+	{
+		return !bDense || GetDenseIndex(Point) != INDEX_NONE;
+	}
+
+	/** Reorders the entries along the Z-order curve so neighbouring chunks are visited together. Handles stay valid. */
+	void SortByMortonOrder()
+	{
+		checkf(!IsLocked(), TEXT("Chunk directory changed while locked"));
+
+		const int32 NumEntries = Entries.Num();
+
+		TArray<int32> Order;
+		Order.SetNumUninitialized(NumEntries);
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			Order[Index] = Index;
+		}
+
+		Algo::SortBy(Order, [this](const int32 Index)
+		{
+			return ChunkDirectory::MortonEncode(Entries[Index].Key);
+		});
+
+		TArray<FEntry> SortedEntries;
+		TArray<int32> SortedSlots;
+		SortedEntries.Reserve(NumEntries);
+		SortedSlots.Reserve(NumEntries);
+
+		for (int32 NewIndex = 0; NewIndex < NumEntries; ++NewIndex)
+		{
+			const int32 OldIndex = Order[NewIndex];
+			SortedEntries.Add(MoveTemp(Entries[OldIndex]));
+			SortedSlots.Add(EntrySlots[OldIndex]);
+			Slots[EntrySlots[OldIndex]].EntryIndex = NewIndex;
+		}
+
+		Entries = MoveTemp(SortedEntries);
+		EntrySlots = MoveTemp(SortedSlots);
+	}
+
+	/**
+	 * While locked the set and order of the entries must not change, values stay writable. Held during
+	 * parallel sweeps over the chunks so entries and their addresses stay put. Locks nest.
+	 */
+	FORCEINLINE void Lock()
+	{
+		++NumLocks;
+	}
+
+	FORCEINLINE void Unlock()
+	{
+		checkf(NumLocks > 0, TEXT("Chunk directory unlocked more often than locked"));
+		--NumLocks;
+	}
+
+	FORCEINLINE bool IsLocked() const
+	{
+		return NumLocks > 0;
+	}
+
+	FORCEINLINE const FChunkPointTable& GetLookup() const
+	{
+		return SlotLookup;
+	}
+
+	FORCEINLINE TArrayView<FEntry> GetEntries()
+	{
+		return Entries;
+	}
+
+	FORCEINLINE TConstArrayView<FEntry> GetEntries() const
+	{
+		return Entries;
+	}
+
+	// Entries are packed, ranged for loops run over contiguous memory.
+	FORCEINLINE auto begin() { return Entries.begin(); }
+	FORCEINLINE auto begin() const { return Entries.begin(); }
+	FORCEINLINE auto end() { return Entries.end(); }
+	FORCEINLINE auto end() const { return Entries.end(); }
+
+private:
+	struct FSlot
+	{
+		int32 EntryIndex = INDEX_NONE;
+		uint32 Generation = 0;
+	};
+
+	FORCEINLINE int32 GetDenseIndex(const FIntPoint& Point) const
+	{
+		// Unsigned compares reject both sides of the range at once.
+		const uint32 X = static_cast<uint32>(Point.X) - static_cast<uint32>(DenseBounds.Min.X);
+		const uint32 Y = static_cast<uint32>(Point.Y) - static_cast<uint32>(DenseBounds.Min.Y);
+		if (X >= static_cast<uint32>(DenseBounds.Max.X - DenseBounds.Min.X) || Y >= static_cast<uint32>(DenseHeight))
+		{
+			return INDEX_NONE;
+		}
+
+		return static_cast<int32>(X) * DenseHeight + static_cast<int32>(Y);
+	}
+
+	FORCEINLINE const int32* FindSlotIndex(const FIntPoint& Point) const
+	{
+		if (bDense)
+		{
+			const int32 DenseIndex = GetDenseIndex(Point);
+			return DenseIndex != INDEX_NONE && DenseSlots[DenseIndex] != INDEX_NONE ? &DenseSlots[DenseIndex] : nullptr;
+		}
+
+		return SlotLookup.Find(Point);
+	}
+
+	FORCEINLINE void ReleaseSlot(const int32 SlotIndex)
+	{
+		FSlot& Slot = Slots[SlotIndex];
+		Slot.EntryIndex = INDEX_NONE;
+		++Slot.Generation;
+
+		FreeSlots.Add(SlotIndex);
+	}
+
+private:
+	TArray<FEntry> Entries;
+
+	/** Slot of each entry, parallel to Entries. */
+	TArray<int32> EntrySlots;
+
+	TArray<FSlot> Slots;
+	TArray<int32> FreeSlots;
+
+	/** Thin side index from chunk point to slot. */
+	FChunkPointTable SlotLookup;
+
+	/** Slot per chunk point inside DenseBounds, replaces SlotLookup when bDense is set. */
+	TArray<int32> DenseSlots;
+	FIntRect DenseBounds;
+	int32 DenseHeight = 0;
+	bool bDense = false;
+
+	int32 NumLocks = 0;
+};
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/** Counters of the last accessed chunk cache of a system. */
+struct FChunkLookupCacheStats
+{
+	/** Lookups served by the cached chunk. */
+	int64 Hits = 0;
+
+	/** Lookups that went through the chunk directory. */
+	int64 Misses = 0;
+
+	FORCEINLINE double GetHitRate() const
+	{
+		const int64 Total = Hits + Misses;
+		return Total > 0 ? static_cast<double>(Hits) / Total : 0.0;
+	}
+};
+
+/** Hit and miss counts of one thread for one system. Only that thread writes them, so no update contends. */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FChunkLookupCacheThreadCounters
+{
+	std::atomic<int64> Hits{0};
+	std::atomic<int64> Misses{0};
+
+	FORCEINLINE void AddHit()
+	{
+		Hits.store(Hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	FORCEINLINE void AddMiss()
+	{
+		Misses.store(Misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+};
+
+/**
+ * Entry of the per thread cache of the chunk a system resolved last.
+ *
+ * It stores the cell bounds of the chunk, so a lookup for a cell of the
+ * same chunk is four compares instead of the chunk grid division and the
+ * directory lookup. Systems bump their epoch whenever a chunk is removed,
+ * which invalidates the entries of every thread at once.
+ */
+struct FChunkLookupCacheEntry
+{
+	uint64 OwnerId = 0;
+	uint32 Epoch = 0;
+
+	FIntPoint ChunkPoint = FIntPoint::ZeroValue;
+	FIntPoint TopLeft = FIntPoint::ZeroValue;
+	FIntPoint BottomRight = FIntPoint::ZeroValue;
+	void* Chunk = nullptr;
+
+	/** Counters of this thread for the owner, kept while the entry belongs to the same system. */
+	FChunkLookupCacheThreadCounters* Counters = nullptr;
+
+	FORCEINLINE bool Matches(const uint64 InOwnerId, const uint32 InEpoch, const FIntPoint& InCellPoint) const
+	{
+		return OwnerId == InOwnerId && Epoch == InEpoch
+			&& InCellPoint.X >= TopLeft.X && InCellPoint.X <= BottomRight.X
+			&& InCellPoint.Y >= TopLeft.Y && InCellPoint.Y <= BottomRight.Y;
+	}
+};
+
+namespace ChunkLookupCache
+{
+	/** Entries per thread, a system picks one by its id. */
+	constexpr int32 NumEntries = 4;
+
+	/** Unique for the process lifetime, so a new system never matches entries of a destroyed one. Never 0. */
+	SIMPLECHUNKSYSTEM_API uint64 MakeOwnerId();
+
+	FORCEINLINE FChunkLookupCacheEntry& GetEntry(const uint64 InOwnerId)
+	{
+		static thread_local FChunkLookupCacheEntry Entries[NumEntries];
+		return Entries[InOwnerId & (NumEntries - 1)];
+	}
+}
+
+/**
+ * Hit and miss counters of a system. Every thread counts into its own
+ * block, which is looked up once per thread and kept in its cache entry,
+ * and the blocks are only summed when the stats are read.
+ */
+class SIMPLECHUNKSYSTEM_API FChunkLookupCacheCounters
+{
+public:
+	/** Counters of the calling thread, created on its first lookup. */
+	FChunkLookupCacheThreadCounters& GetThreadCounters();
+
+	FChunkLookupCacheStats Get() const;
+
+	void Reset();
+
+private:
+	mutable FCriticalSection Lock;
+
+	TMap<uint32, TUniquePtr<FChunkLookupCacheThreadCounters>> ThreadCounters;
+};
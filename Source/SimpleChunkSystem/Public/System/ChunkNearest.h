@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Cell found by a nearest search, see TChunkSystem_DynamicData::FindNearest. */
+struct FChunkNearestCell
+{
+	FChunkNearestCell() = default;
+
+	FChunkNearestCell(const FIntPoint& InCell, const int64 InDistanceSquared)
+		: Cell(InCell)
+		  , DistanceSquared(InDistanceSquared)
+	{
+	}
+
+	FORCEINLINE bool IsValid() const
+	{
+		return DistanceSquared >= 0;
+	}
+
+	/** Nearer first, cells at the same distance are ordered by X then Y. */
+	FORCEINLINE bool operator<(const FChunkNearestCell& Other) const
+	{
+		if (DistanceSquared != Other.DistanceSquared)
+		{
+			return DistanceSquared < Other.DistanceSquared;
+		}
+
+		return Cell.X < Other.Cell.X || (Cell.X == Other.Cell.X && Cell.Y < Other.Cell.Y);
+	}
+
+	FIntPoint Cell = FIntPoint::NoneValue;
+
+	/** Squared distance to the origin in whole cells. Negative if nothing was found. */
+	int64 DistanceSquared = -1;
+};
+
+namespace ChunkNearest
+{
+	/** Orders the heap with the farthest kept cell on top. */
+	struct FFartherFirst
+	{
+		FORCEINLINE bool operator()(const FChunkNearestCell& A, const FChunkNearestCell& B) const
+		{
+			return B < A;
+		}
+	};
+
+	/** Squared distance a cell must not exceed to enter a heap of the Count nearest cells. */
+	FORCEINLINE int64 GetWorstDistanceSquared(const TArray<FChunkNearestCell>& Heap, const int32 Count)
+	{
+		return Heap.Num() < Count ? TNumericLimits<int64>::Max() : Heap.HeapTop().DistanceSquared;
+	}
+
+	/** Keeps the candidate if it is among the Count nearest cells seen so far. */
+	FORCEINLINE void Offer(TArray<FChunkNearestCell>& Heap, const int32 Count, const FChunkNearestCell& Candidate)
+	{
+		if (Heap.Num() < Count)
+		{
+			Heap.HeapPush(Candidate, FFartherFirst());
+		}
+		else if (Candidate < Heap.HeapTop())
+		{
+			Heap.HeapPopDiscard(FFartherFirst(), EAllowShrinking::No);
+			Heap.HeapPush(Candidate, FFartherFirst());
+		}
+	}
+}
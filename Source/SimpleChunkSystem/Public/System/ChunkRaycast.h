@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Segment in continuous grid space, cell (X, Y) covers [X, X + 1) x [Y, Y + 1). */
+struct FChunkRay
+{
+	FChunkRay() = default;
+
+	FChunkRay(const FVector2D& InStart, const FVector2D& InEnd)
+		: Start(InStart)
+		  , End(InEnd)
+	{
+	}
+
+	FVector2D Start = FVector2D::ZeroVector;
+	FVector2D End = FVector2D::ZeroVector;
+};
+
+/** Cell hit by a ray. */
+struct FChunkRayHit
+{
+	FChunkRayHit() = default;
+
+	FChunkRayHit(const FIntPoint& InCell, const double InTime)
+		: Cell(InCell)
+		  , Time(InTime)
+	{
+	}
+
+	FORCEINLINE bool IsHit() const
+	{
+		return Time >= 0.0;
+	}
+
+	FIntPoint Cell = FIntPoint::NoneValue;
+
+	/** Where the ray enters the cell, 0 at the start of the segment and 1 at its end. Negative without a hit. */
+	double Time = -1.0;
+};
+
+/**
+ * Walks the cells crossed by a segment in grid space, in order from the start
+ * cell to the end cell (Amanatides and Woo). Each step is one cell, SkipBox
+ * leaves a whole rectangle of cells in a single step.
+ */
+class SIMPLECHUNKSYSTEM_API FChunkGridTraversal
+{
+public:
+	FChunkGridTraversal(const FVector2D& InStart, const FVector2D& InEnd);
+
+	FORCEINLINE const FIntPoint& GetCell() const
+	{
+		return Cell;
+	}
+
+	/** Where the segment enters the current cell, from 0 to 1. */
+	FORCEINLINE double GetEntryTime() const
+	{
+		return EntryTime;
+	}
+
+	/** True once the end cell was left. */
+	FORCEINLINE bool IsDone() const
+	{
+		return bDone;
+	}
+
+	FORCEINLINE bool IsInBox(const FIntPoint& InMin, const FIntPoint& InMax) const
+	{
+		return Cell.X >= InMin.X && Cell.X <= InMax.X && Cell.Y >= InMin.Y && Cell.Y <= InMax.Y;
+	}
+
+	/** Moves to the next cell crossed by the segment. */
+	void Step();
+
+	/** Moves to the first cell crossed after leaving the box, Max inclusive. The current cell must be inside. */
+	void SkipBox(const FIntPoint& InMin, const FIntPoint& InMax);
+
+private:
+	FIntPoint Cell;
+	FIntPoint EndCell;
+	FIntPoint StepDir;
+
+	/** Time of the next crossing of a cell boundary along each axis. */
+	FVector2D NextCrossing;
+
+	/** Time between two boundary crossings along each axis. */
+	FVector2D CrossingDelta;
+
+	double EntryTime = 0.0;
+	bool bDone = false;
+};
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "ChunkLogCategory.h"
 
+#include "ChunkBatch.h"
+#include "ChunkDirectory.h"
+#include "ChunkLookupCache.h"
 #include "Chunk/ChunkBase.h"
 #include "Library/ChunkBlueprintFunctionLibrary.h"
 
@@ -12,6 +15,22 @@ DEFINE_LOG_CATEGORY_STATIC(LogSChunkSystemLocal, Log, All)
 
 using FConvertWorldToGrid = FIntPoint(*)(const UObject*, const FVector&);
 
+/** Counters of the chunk pool of a system. */
+struct FChunkPoolStats
+{
+	/** Chunks taken from the pool instead of being allocated. */
+	int32 Hits = 0;
+
+	/** Chunks allocated because the pool was empty. */
+	int32 Misses = 0;
+
+	/** Removed chunks that were kept in the pool. */
+	int32 Recycled = 0;
+
+	/** Removed chunks that were destroyed because the pool was full. */
+	int32 Discarded = 0;
+};
+
 /**
  * Template base class that manages a collection of chunks.
  *
@@ -22,33 +41,67 @@ using FConvertWorldToGrid = FIntPoint(*)(const UObject*, const FVector&);
  * @tparam Type               Chunk class stored inside the system. Must derive from FChunkBase.
  * @tparam bIsSerialize       Enables or disables serialization support.
  * @tparam FuncConv           Function used to convert world locations to grid coordinates.
+ * @tparam StaticChunkSize    Power of two chunk size fixed at compile time, coordinate math then uses
+ *                            shifts and masks. 0 keeps the runtime chunk size.
  */
 template <typename Type, bool bIsSerialize = true, FConvertWorldToGrid FuncConv =
-	          UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToGrid>
+	          UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToGrid, int32 StaticChunkSize = 0>
 class TChunkSystemBase
 {
 	static_assert(TIsDerivedFrom<Type, FChunkBase>::Value, "Type must be derived from FChunkBase");
+	static_assert(StaticChunkSize >= 0 && (StaticChunkSize & (StaticChunkSize - 1)) == 0,
+	              "StaticChunkSize must be a power of two");
 
 	friend class FChunk_DivFloorTest;
+	friend class FChunk_ChunkSizeBenchmarkTest;
 	friend class FChunk_ChunkSystem_SystemIteratorTest;
 	friend class FChunk_ChunkSystem_ChannelIndexRebuildTest;
 
-	using FChunkPtr = TSharedPtr<Type, ESPMode::ThreadSafe>;
-
 protected:
+	/**
+	 * Chunks are boxed rather than stored by value in the directory entries. Chunk addresses have to
+	 * survive the entries array growing: the per thread lookup cache keeps raw chunk pointers and is
+	 * only invalidated on removal, and channel references handed out for one chunk stay valid while
+	 * other chunks are created. MakeChunk may also return a type derived from Type, and the pool
+	 * recycles chunks with their cell storage. A sweep pays one pointer hop per chunk, which is small
+	 * next to the cells it walks; SortByMortonOrder keeps the visiting order spatial.
+	 */
+	using FChunkPtr = TUniquePtr<Type>;
+
+	static constexpr bool bStaticChunkSize = StaticChunkSize > 0;
+
+	static constexpr int32 GetStaticChunkShift()
+	{
+		int32 Shift = 0;
+		while ((1 << Shift) < StaticChunkSize)
+		{
+			++Shift;
+		}
+		return Shift;
+	}
+
+	static constexpr int32 ChunkShift = GetStaticChunkShift();
+	static constexpr int32 ChunkMask = StaticChunkSize - 1;
+
 	TFunction<FIntPoint(const UObject*, const FVector&)> ConvertWorldToGridFunc = FuncConv;
 
 public:
 	TChunkSystemBase(const UObject* InWorldContext, const int32 InChunkSize)
 		: World(InWorldContext ? InWorldContext->GetWorld() : nullptr)
-		  , ChunkSize(FMath::Max(InChunkSize, DefaultChunkSize))
+		  , ChunkSize(bStaticChunkSize ? StaticChunkSize : FMath::Max(InChunkSize, DefaultChunkSize))
 	{
 		if (!World)
 		{
 			SCHUNK_LOG(LogSChunkSystemLocal, Log, TEXT("World context is null."));
 		}
 
-		if (InChunkSize < DefaultChunkSize)
+		if (bStaticChunkSize && InChunkSize != StaticChunkSize)
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal, Log,
+			           TEXT("Chunk size %d is ignored, the system uses the compile time size %d."), InChunkSize,
+			           StaticChunkSize);
+		}
+		else if (InChunkSize < DefaultChunkSize)
 		{
 			SCHUNK_LOG(LogSChunkSystemLocal, Log,
 			           TEXT("Chunk size %d is less than default %d, using default size instead."), InChunkSize,
@@ -66,25 +119,52 @@ public:
 			return;
 		}
 
-		Ar << ChunkSize;
+		int32 SerializedChunkSize = ChunkSize;
+		Ar << SerializedChunkSize;
+
+		if (Ar.IsLoading())
+		{
+			if (bStaticChunkSize && SerializedChunkSize != StaticChunkSize)
+			{
+				SCHUNK_LOG(LogSChunkSystemLocal, Error,
+				           TEXT("Saved chunk size %d does not match the compile time size %d."), SerializedChunkSize,
+				           StaticChunkSize);
+				Ar.SetError();
+				return;
+			}
+
+			ChunkSize = SerializedChunkSize;
+		}
 
 		int32 Count = Chunks.Num();
 		Ar << Count;
 
 		if (Ar.IsLoading())
 		{
+			RecycleAllChunks();
 			Chunks.Empty(Count);
+			InvalidateChunkLookupCache();
 
 			for (int32 Index = 0; Index < Count; ++Index)
 			{
 				FIntPoint Key;
 				Ar << Key;
 
-				Type Value(FIntPoint::ZeroValue, FIntPoint::ZeroValue);
-				Value.Serialize(Ar);
+				FChunkPtr Value = AcquireChunk(FIntPoint::ZeroValue, FIntPoint::ZeroValue);
+				Value->Serialize(Ar);
+
+				if (!Chunks.IsInBounds(Key))
+				{
+					SCHUNK_LOG(LogSChunkSystemLocal, Warning, TEXT("Dropping loaded chunk %s outside of the grid bounds."),
+					           *Key.ToString());
+					RecycleChunk(Key, MoveTemp(Value));
+					continue;
+				}
 
-				Chunks.Emplace(Key, MakeShared<Type, ESPMode::ThreadSafe>(Value));
+				Chunks.Emplace(Key, MoveTemp(Value));
 			}
+
+			Chunks.SortByMortonOrder();
 		}
 
 		if (Ar.IsSaving())
@@ -143,7 +223,9 @@ public:
 
 	FORCEINLINE virtual void Empty(const int32 ExpectedNumElements = 0)
 	{
+		RecycleAllChunks();
 		Chunks.Empty(ExpectedNumElements);
+		InvalidateChunkLookupCache();
 	}
 
 	FORCEINLINE bool IsEmpty() const
@@ -151,18 +233,236 @@ public:
 		return Chunks.IsEmpty();
 	}
 
+	// Bounds
+	/**
+	 * Limits the system to a fixed rectangle of chunk coordinates, Max is exclusive.
+	 * Chunk lookups become an array index and chunks outside are never created.
+	 * An empty rectangle lifts the limit. Only possible while the system has no chunks.
+	 */
+	bool SetChunkGridBounds(const FIntRect& InChunkBounds)
+	{
+		if (!Chunks.IsEmpty())
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal, Warning, TEXT("Chunk grid bounds can only be set on an empty system."));
+			return false;
+		}
+
+		Chunks.SetDenseBounds(InChunkBounds);
+		return true;
+	}
+
+	FORCEINLINE bool HasChunkGridBounds() const
+	{
+		return Chunks.HasDenseBounds();
+	}
+
+	FORCEINLINE const FIntRect& GetChunkGridBounds() const
+	{
+		return Chunks.GetDenseBounds();
+	}
+
+	FORCEINLINE bool IsInChunkGridBounds(const FVector& InGlobalLocation) const
+	{
+		return Chunks.IsInBounds(ConvertGlobalToChunkGrid(InGlobalLocation));
+	}
+
+	FORCEINLINE bool IsInChunkGridBounds(const FIntPoint& InGlobalGridLocation) const
+	{
+		return Chunks.IsInBounds(ConvertGlobalToChunkGrid(InGlobalGridLocation));
+	}
+
+	/** Reorders the chunk storage along the Z-order curve, sweeps over all chunks then walk neighbours together. */
+	FORCEINLINE void SortChunksByMortonOrder()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystemBase::SortChunksByMortonOrder)
+		Chunks.SortByMortonOrder();
+	}
+
+	// Handles
+	/** Handle of the chunk containing the location, unset if there is none. Cache it to skip the coordinate lookup. */
+	FORCEINLINE FChunkHandle FindChunkHandleByLocation(const FVector& InGlobalLocation) const
+	{
+		return Chunks.FindHandle(ConvertGlobalToChunkGrid(InGlobalLocation));
+	}
+
+	FORCEINLINE FChunkHandle FindChunkHandleByGrid(const FIntPoint& InGlobalGridLocation) const
+	{
+		return Chunks.FindHandle(ConvertGlobalToChunkGrid(InGlobalGridLocation));
+	}
+
+	/** False once the chunk of the handle was removed. */
+	FORCEINLINE bool IsChunkHandleValid(const FChunkHandle InHandle) const
+	{
+		return Chunks.IsValid(InHandle);
+	}
+
+	FORCEINLINE Type* FindChunk(const FChunkHandle InHandle)
+	{
+		FChunkPtr* const ChunkPtr = Chunks.Find(InHandle);
+		return ChunkPtr ? ChunkPtr->Get() : nullptr;
+	}
+
+	FORCEINLINE const Type* FindChunk(const FChunkHandle InHandle) const
+	{
+		const FChunkPtr* const ChunkPtr = Chunks.Find(InHandle);
+		return ChunkPtr ? ChunkPtr->Get() : nullptr;
+	}
+
+	// Pool
+	/**
+	 * Sets how many removed chunks are kept for reuse by TryMakeChunk, 0 disables pooling.
+	 * Pooled chunks are reset but keep their buffers.
+	 */
+	FORCEINLINE void SetChunkPoolSize(const int32 InMaxPooledChunks)
+	{
+		MaxPooledChunks = FMath::Max(InMaxPooledChunks, 0);
+
+		if (ChunkPool.Num() > MaxPooledChunks)
+		{
+			ChunkPool.SetNum(MaxPooledChunks);
+		}
+	}
+
+	FORCEINLINE int32 GetChunkPoolSize() const
+	{
+		return MaxPooledChunks;
+	}
+
+	FORCEINLINE int32 GetNumPooledChunks() const
+	{
+		return ChunkPool.Num();
+	}
+
+	FORCEINLINE const FChunkPoolStats& GetChunkPoolStats() const
+	{
+		return ChunkPoolStats;
+	}
+
+	FORCEINLINE void ResetChunkPoolStats()
+	{
+		ChunkPoolStats = FChunkPoolStats();
+	}
+
+	/** Destroys every pooled chunk. */
+	FORCEINLINE void EmptyChunkPool()
+	{
+		ChunkPool.Empty();
+	}
+
+	// Lookup cache
+	/** Hits and misses of the last accessed chunk cache summed over all threads. */
+	FORCEINLINE FChunkLookupCacheStats GetChunkLookupCacheStats() const
+	{
+		return LookupCacheCounters.Get();
+	}
+
+	FORCEINLINE void ResetChunkLookupCacheStats()
+	{
+		LookupCacheCounters.Reset();
+	}
+
 	// Helper
+	FORCEINLINE int32 GetChunkSize() const
+	{
+		if constexpr (bStaticChunkSize)
+		{
+			return StaticChunkSize;
+		}
+		else
+		{
+			return ChunkSize;
+		}
+	}
+
 	FORCEINLINE const UWorld* GetWorld() const
 	{
 		return World;
 	}
 
 protected:
+	/**
+	 * Chunk containing the cell. Coherent access streams are served from the
+	 * calling thread's last accessed chunk without touching the directory.
+	 */
+	FORCEINLINE const Type* FindChunkCached(const FIntPoint& InGlobalGridLocation,
+	                                        FIntPoint* OutChunkPoint = nullptr) const
+	{
+		FChunkLookupCacheEntry& Entry = ChunkLookupCache::GetEntry(LookupCacheId);
+		if (Entry.Matches(LookupCacheId, ChunkEpoch, InGlobalGridLocation))
+		{
+			Entry.Counters->AddHit();
+
+			if (OutChunkPoint)
+			{
+				*OutChunkPoint = Entry.ChunkPoint;
+			}
+
+			return static_cast<const Type*>(Entry.Chunk);
+		}
+
+		ClaimChunkLookupCache(Entry).AddMiss();
+
+		const FIntPoint ChunkPoint = ConvertGlobalToChunkGrid(InGlobalGridLocation);
+		if (OutChunkPoint)
+		{
+			*OutChunkPoint = ChunkPoint;
+		}
+
+		const FChunkPtr* const ChunkPtr = Chunks.Find(ChunkPoint);
+		if (!ChunkPtr || !ChunkPtr->IsValid())
+		{
+			return nullptr;
+		}
+
+		UpdateChunkLookupCache(Entry, ChunkPoint, ChunkPtr->Get());
+		return ChunkPtr->Get();
+	}
+
+	FORCEINLINE Type* FindChunkCached(const FIntPoint& InGlobalGridLocation, FIntPoint* OutChunkPoint = nullptr)
+	{
+		return const_cast<Type*>(AsConst(*this).FindChunkCached(InGlobalGridLocation, OutChunkPoint));
+	}
+
+	/** Like FindChunkCached but creates the chunk if missing. Null only outside of the chunk grid bounds. */
+	FORCEINLINE Type* FindOrMakeChunkCached(const FIntPoint& InGlobalGridLocation, FIntPoint* OutChunkPoint = nullptr)
+	{
+		FIntPoint ChunkPoint;
+		if (Type* const Chunk = FindChunkCached(InGlobalGridLocation, &ChunkPoint))
+		{
+			if (OutChunkPoint)
+			{
+				*OutChunkPoint = ChunkPoint;
+			}
+
+			return Chunk;
+		}
+
+		if (OutChunkPoint)
+		{
+			*OutChunkPoint = ChunkPoint;
+		}
+
+		if (!TryMakeChunk(ChunkPoint))
+		{
+			return nullptr;
+		}
+
+		Type* const Chunk = Chunks[ChunkPoint].Get();
+		UpdateChunkLookupCache(ChunkLookupCache::GetEntry(LookupCacheId), ChunkPoint, Chunk);
+		return Chunk;
+	}
+
+	/** Drops the cached chunks of every thread, required whenever a chunk is destroyed or recycled. */
+	FORCEINLINE void InvalidateChunkLookupCache()
+	{
+		++ChunkEpoch;
+	}
+
 	FORCEINLINE bool TryMakeChunk(const FIntPoint& InChunkGridLocation)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(FChunkSystemBase::TryMakeChunk)
 
-		if (Chunks.Contains(InChunkGridLocation))
+		if (!Chunks.IsInBounds(InChunkGridLocation) || Chunks.Contains(InChunkGridLocation))
 		{
 			return false;
 		}
@@ -170,20 +470,82 @@ protected:
 		FIntPoint TopLeft, BottomRight;
 		GetChunkBounds(InChunkGridLocation, TopLeft, BottomRight);
 
-		Chunks.Emplace(InChunkGridLocation, MakeShared<Type, ESPMode::ThreadSafe>(TopLeft, BottomRight));
+		Chunks.Emplace(InChunkGridLocation, AcquireChunk(TopLeft, BottomRight));
 		return true;
 	}
 
+	/** Takes a chunk from the pool and rebinds it to the bounds, allocates one if the pool is empty. */
+	FChunkPtr AcquireChunk(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight)
+	{
+		if (ChunkPool.IsEmpty())
+		{
+			++ChunkPoolStats.Misses;
+			return MakeChunk(InTopLeft, InBottomRight);
+		}
+
+		++ChunkPoolStats.Hits;
+
+		FChunkPtr Chunk = ChunkPool.Pop(EAllowShrinking::No);
+		Chunk->Reset(InTopLeft, InBottomRight);
+		return Chunk;
+	}
+
+	/** Keeps a removed chunk for reuse if the pool has room. */
+	void RecycleChunk(const FIntPoint& InChunkGridLocation, FChunkPtr&& InChunk)
+	{
+		if (MaxPooledChunks == 0)
+		{
+			return;
+		}
+
+		if (!InChunk.IsValid() || ChunkPool.Num() >= MaxPooledChunks)
+		{
+			++ChunkPoolStats.Discarded;
+			return;
+		}
+
+		++ChunkPoolStats.Recycled;
+
+		// Clears the data right away so pooled chunks don't hold on to payloads.
+		FIntPoint TopLeft, BottomRight;
+		GetChunkBounds(InChunkGridLocation, TopLeft, BottomRight);
+		InChunk->Reset(TopLeft, BottomRight);
+
+		ChunkPool.Add(MoveTemp(InChunk));
+	}
+
+	void RecycleAllChunks()
+	{
+		if (MaxPooledChunks == 0)
+		{
+			return;
+		}
+
+		for (TPair<FIntPoint, FChunkPtr>& Iter : Chunks)
+		{
+			RecycleChunk(Iter.Key, MoveTemp(Iter.Value));
+		}
+	}
+
+	/** Creates a chunk covering the given cell bounds. Override to pass extra construction arguments. */
+	virtual FChunkPtr MakeChunk(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight) const
+	{
+		return MakeUnique<Type>(InTopLeft, InBottomRight);
+	}
+
 	FORCEINLINE bool TryRemoveChunk(const FIntPoint& InChunkGridLocation)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(FChunkSystemBase::TryRemoveChunk)
 
-		if (!Chunks.Contains(InChunkGridLocation))
+		FChunkPtr Chunk;
+		if (!Chunks.RemoveAndCopyValue(InChunkGridLocation, Chunk))
 		{
 			return false;
 		}
 
-		Chunks.Remove(InChunkGridLocation);
+		InvalidateChunkLookupCache();
+
+		RecycleChunk(InChunkGridLocation, MoveTemp(Chunk));
 		return true;
 	}
 
@@ -202,10 +564,31 @@ protected:
 
 	FORCEINLINE FIntPoint ConvertGlobalToChunkGrid(const FIntPoint& InGlobalGridLocation) const
 	{
-		const int32 ChunkX = DivFloor(InGlobalGridLocation.X, ChunkSize);
-		const int32 ChunkY = DivFloor(InGlobalGridLocation.Y, ChunkSize);
+		if constexpr (bStaticChunkSize)
+		{
+			// Arithmetic shifts round towards negative infinity, which is the floor division we need.
+			return FIntPoint(InGlobalGridLocation.X >> ChunkShift, InGlobalGridLocation.Y >> ChunkShift);
+		}
+		else
+		{
+			const int32 ChunkX = DivFloor(InGlobalGridLocation.X, ChunkSize);
+			const int32 ChunkY = DivFloor(InGlobalGridLocation.Y, ChunkSize);
 
-		return FIntPoint(ChunkX, ChunkY);
+			return FIntPoint(ChunkX, ChunkY);
+		}
+	}
+
+	/** Cell position inside its chunk, from 0 to ChunkSize - 1 on both axes. */
+	FORCEINLINE FIntPoint ConvertGlobalToLocalCell(const FIntPoint& InGlobalGridLocation) const
+	{
+		if constexpr (bStaticChunkSize)
+		{
+			return FIntPoint(InGlobalGridLocation.X & ChunkMask, InGlobalGridLocation.Y & ChunkMask);
+		}
+		else
+		{
+			return InGlobalGridLocation - ConvertGlobalToChunkGrid(InGlobalGridLocation) * ChunkSize;
+		}
 	}
 
 	FORCEINLINE TMap<FIntPoint, TSet<FIntPoint>> SplitGridLocationsToChunks(
@@ -224,21 +607,151 @@ protected:
 		return ChunkToGrid;
 	}
 
+	/**
+	 * Groups the points by chunk without hashing: the points are tagged with their
+	 * chunk in the scratch buffer and sorted, then Func(const FIntPoint& ChunkPoint,
+	 * TConstArrayView<FChunkBatchItem> Group) is called once per chunk. Items of a
+	 * group keep the order of the input. The scratch must not be reused inside Func.
+	 */
+	template <typename FuncType>
+	void ForEachChunkGroup(const TConstArrayView<FIntPoint> InGridLocations, FChunkBatchScratch& Scratch,
+	                       FuncType&& Func) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FChunkSystemBase::ForEachChunkGroup)
+
+		const int32 NumPoints = InGridLocations.Num();
+
+		TArray<FChunkBatchItem>& Items = Scratch.Items;
+		Items.SetNumUninitialized(NumPoints, EAllowShrinking::No);
+
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			Items[Index].ChunkKey = ChunkDirectory::PackPoint(ConvertGlobalToChunkGrid(InGridLocations[Index]));
+			Items[Index].PointIndex = Index;
+		}
+
+		Algo::Sort(Items);
+
+		for (int32 Start = 0; Start < NumPoints;)
+		{
+			const uint64 ChunkKey = Items[Start].ChunkKey;
+
+			int32 End = Start + 1;
+			while (End < NumPoints && Items[End].ChunkKey == ChunkKey)
+			{
+				++End;
+			}
+
+			Func(ChunkDirectory::UnpackPoint(ChunkKey), TConstArrayView<FChunkBatchItem>(Items.GetData() + Start, End - Start));
+			Start = End;
+		}
+	}
+
+	/**
+	 * Chunk points covering the cells of the grid region, both Max exclusive. Clipped to the chunk
+	 * grid bounds if the system has them, empty if no chunk can overlap the region.
+	 */
+	FORCEINLINE FIntRect GetChunkRangeOfRegion(const FIntRect& InGridRegion) const
+	{
+		if (InGridRegion.Min.X >= InGridRegion.Max.X || InGridRegion.Min.Y >= InGridRegion.Max.Y)
+		{
+			return FIntRect();
+		}
+
+		FIntRect Range(ConvertGlobalToChunkGrid(InGridRegion.Min),
+		               ConvertGlobalToChunkGrid(InGridRegion.Max - FIntPoint(1, 1)) + FIntPoint(1, 1));
+
+		if (Chunks.HasDenseBounds())
+		{
+			const FIntRect& Bounds = Chunks.GetDenseBounds();
+			Range.Min = Range.Min.ComponentMax(Bounds.Min);
+			Range.Max = Range.Max.ComponentMin(Bounds.Max);
+
+			if (Range.Min.X >= Range.Max.X || Range.Min.Y >= Range.Max.Y)
+			{
+				return FIntRect();
+			}
+		}
+
+		return Range;
+	}
+
+	/**
+	 * Calls Func(const FIntPoint& ChunkPoint, const Type& Chunk) for every existing chunk overlapping the
+	 * grid region, Max exclusive. Walks whichever is smaller: the chunks covering the region or the existing
+	 * chunks. Func must not add or remove chunks.
+	 */
+	template <typename FuncType>
+	void ForEachChunkInRegion(const FIntRect& InGridRegion, FuncType&& Func) const
+	{
+		const FIntRect Range = GetChunkRangeOfRegion(InGridRegion);
+		if (Range.Min.X >= Range.Max.X)
+		{
+			return;
+		}
+
+		const int64 NumRangeChunks = (static_cast<int64>(Range.Max.X) - Range.Min.X) *
+			(static_cast<int64>(Range.Max.Y) - Range.Min.Y);
+		if (NumRangeChunks <= Chunks.Num())
+		{
+			for (int32 X = Range.Min.X; X < Range.Max.X; ++X)
+			{
+				for (int32 Y = Range.Min.Y; Y < Range.Max.Y; ++Y)
+				{
+					const FIntPoint ChunkPoint(X, Y);
+					const FChunkPtr* const ChunkPtr = Chunks.Find(ChunkPoint);
+					if (ChunkPtr && ChunkPtr->IsValid())
+					{
+						Func(ChunkPoint, AsConst(**ChunkPtr));
+					}
+				}
+			}
+
+			return;
+		}
+
+		for (const TPair<FIntPoint, FChunkPtr>& Chunk : Chunks)
+		{
+			if (Range.Contains(Chunk.Key) && Chunk.Value.IsValid())
+			{
+				Func(Chunk.Key, AsConst(*Chunk.Value));
+			}
+		}
+	}
+
+	/** Like the const overload but passes Type& Chunk, so Func may modify the chunks it visits. */
+	template <typename FuncType>
+	void ForEachChunkInRegion(const FIntRect& InGridRegion, FuncType&& Func)
+	{
+		AsConst(*this).ForEachChunkInRegion(InGridRegion, [&Func](const FIntPoint& ChunkPoint, const Type& Chunk)
+		{
+			Func(ChunkPoint, const_cast<Type&>(Chunk));
+		});
+	}
+
 	FORCEINLINE void GetChunkBounds(const FIntPoint& InChunkGrid, FIntPoint& OutTopLeft,
 	                                FIntPoint& OutBottomRight) const
 	{
-		const int32 MinX = InChunkGrid.X * ChunkSize;
-		const int32 MaxX = (InChunkGrid.X + 1) * ChunkSize - 1;
+		if constexpr (bStaticChunkSize)
+		{
+			OutTopLeft = InChunkGrid * StaticChunkSize;
+			OutBottomRight = OutTopLeft + FIntPoint(ChunkMask, ChunkMask);
+		}
+		else
+		{
+			const int32 MinX = InChunkGrid.X * ChunkSize;
+			const int32 MaxX = (InChunkGrid.X + 1) * ChunkSize - 1;
 
-		const int32 MinY = InChunkGrid.Y * ChunkSize;
-		const int32 MaxY = (InChunkGrid.Y + 1) * ChunkSize - 1;
+			const int32 MinY = InChunkGrid.Y * ChunkSize;
+			const int32 MaxY = (InChunkGrid.Y + 1) * ChunkSize - 1;
 
-		OutTopLeft = FIntPoint(MinX, MinY);
-		OutBottomRight = FIntPoint(MaxX, MaxY);
+			OutTopLeft = FIntPoint(MinX, MinY);
+			OutBottomRight = FIntPoint(MaxX, MaxY);
+		}
 	}
 
 protected:
-	TMap<FIntPoint, FChunkPtr> Chunks;
+	TChunkDirectory<FChunkPtr> Chunks;
 
 private:
 	FORCEINLINE int32 DivFloor(const int32 Value, const int32 Divisor) const
@@ -246,8 +759,48 @@ private:
 		return Value >= 0 ? Value / Divisor : -((-Value + Divisor - 1) / Divisor);
 	}
 
+	/** Makes the entry this system's without caching a chunk yet, other systems' entries get our counters. */
+	FORCEINLINE FChunkLookupCacheThreadCounters& ClaimChunkLookupCache(FChunkLookupCacheEntry& Entry) const
+	{
+		if (Entry.OwnerId != LookupCacheId)
+		{
+			Entry.OwnerId = LookupCacheId;
+			Entry.Counters = &LookupCacheCounters.GetThreadCounters();
+
+			// Empty bounds, the entry only matches once a chunk is cached.
+			Entry.TopLeft = FIntPoint(MAX_int32, MAX_int32);
+			Entry.BottomRight = FIntPoint(MIN_int32, MIN_int32);
+		}
+
+		return *Entry.Counters;
+	}
+
+	FORCEINLINE void UpdateChunkLookupCache(FChunkLookupCacheEntry& Entry, const FIntPoint& InChunkPoint,
+	                                        Type* InChunk) const
+	{
+		ClaimChunkLookupCache(Entry);
+		Entry.Epoch = ChunkEpoch;
+		Entry.ChunkPoint = InChunkPoint;
+		GetChunkBounds(InChunkPoint, Entry.TopLeft, Entry.BottomRight);
+		Entry.Chunk = InChunk;
+	}
+
 	const UWorld* World;
 
 	const int32 DefaultChunkSize = 1;
 	int32 ChunkSize;
+
+	/** Reset chunks ready to be reused by TryMakeChunk. */
+	TArray<FChunkPtr> ChunkPool;
+	int32 MaxPooledChunks = 0;
+
+	FChunkPoolStats ChunkPoolStats;
+
+	/** Picks this system's entry in the per thread lookup cache. */
+	const uint64 LookupCacheId = ChunkLookupCache::MakeOwnerId();
+
+	/** Bumped on chunk removal, cached chunks of older epochs are ignored. */
+	uint32 ChunkEpoch = 0;
+
+	mutable FChunkLookupCacheCounters LookupCacheCounters;
 };
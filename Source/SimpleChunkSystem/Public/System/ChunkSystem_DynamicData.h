@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include "ChunkSystem.h"
+#include "Async/ParallelFor.h"
+#include "ChunkComponents.h"
 #include "Chunk/Chunk_DynamicData.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogSChunkSystemLocal_DynamicData, Log, All)
@@ -13,12 +15,14 @@ DEFINE_LOG_CATEGORY_STATIC(LogSChunkSystemLocal_DynamicData, Log, All)
  * creating and removing data channels identified by name.
  */
 template <bool bIsSerialize = true, FConvertWorldToGrid FuncConv =
-	          UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToGrid>
-class TChunkSystem_DynamicData final : public TChunkSystemBase<FChunk_DynamicData, bIsSerialize, FuncConv>
+	          UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToGrid, int32 StaticChunkSize = 0>
+class TChunkSystem_DynamicData final : public TChunkSystemBase<FChunk_DynamicData, bIsSerialize, FuncConv,
+                                                               StaticChunkSize>
 {
 	friend class FChunk_ChunkSystem_DynamicDataTest;
 
-	using Super = TChunkSystemBase<FChunk_DynamicData, bIsSerialize, FuncConv>;
+	using Super = TChunkSystemBase<FChunk_DynamicData, bIsSerialize, FuncConv, StaticChunkSize>;
+	using FChunkPtr = typename Super::FChunkPtr;
 
 	template <typename TStruct, bool bConst>
 	class TChannelIteratorRangeImpl;
@@ -30,11 +34,14 @@ class TChunkSystem_DynamicData final : public TChunkSystemBase<FChunk_DynamicDat
 	using TConstChannelIteratorRange = TChannelIteratorRangeImpl<TStruct, true>;
 
 public:
-	explicit TChunkSystem_DynamicData(const UObject* InWorldContext, const int32 InChunkSize = 15)
-		: TChunkSystemBase<FChunk_DynamicData, bIsSerialize, FuncConv>(InWorldContext, InChunkSize)
+	explicit TChunkSystem_DynamicData(const UObject* InWorldContext, const int32 InChunkSize = 15,
+	                                  const FChunkCellStorageSettings& InStorageSettings = FChunkCellStorageSettings())
+		: Super(InWorldContext, InChunkSize)
+		  , StorageSettings(InStorageSettings)
 	{
-		SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Log, TEXT("FChunkSystem initialized with chunk size %d"),
-		           InChunkSize);
+		SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Log,
+		           TEXT("FChunkSystem initialized with chunk size %d and cell storage %s"), this->GetChunkSize(),
+		           *UEnum::GetValueAsString(StorageSettings.Storage));
 	}
 
 	virtual void Serialize(FArchive& Ar) override
@@ -51,6 +58,18 @@ public:
 	}
 
 public:
+	/** Resolves a channel once, the handle can be passed to the handle overloads below. */
+	template <typename TStruct>
+	static FORCEINLINE FCellChannelHandle ResolveChannel(const FName Name)
+	{
+		return FCellChannelRegistry::Resolve<TStruct>(Name);
+	}
+
+	static FORCEINLINE FCellChannelHandle ResolveChannel(const FName Name, UScriptStruct* Type)
+	{
+		return FCellChannelRegistry::Resolve(Name, Type);
+	}
+
 	template <typename TStruct>
 	FORCEINLINE FInstancedStruct* GetChannel(const FName Name, const FVector& InLocation)
 	{
@@ -65,14 +84,7 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_GetChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridPoint);
-		TSharedPtr<FChunk_DynamicData> const* ChunkPtr = this->Chunks.Find(ChunkPoint);
-		if (!ChunkPtr || !ChunkPtr->IsValid())
-		{
-			return nullptr;
-		}
-
-		return (*ChunkPtr)->FindChannel<TStruct>(Name, InGridPoint);
+		return GetChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridPoint);
 	}
 
 	FORCEINLINE FInstancedStruct* GetChannel(const FName Name, const FVector& InLocation, UScriptStruct* Type)
@@ -87,16 +99,55 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::GetChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridPoint);
-		TSharedPtr<FChunk_DynamicData> const* ChunkPtr = this->Chunks.Find(ChunkPoint);
-		if (!ChunkPtr || !ChunkPtr->IsValid())
+		return GetChannel(FCellChannelRegistry::Get().Find({Name, Type}), InGridPoint);
+	}
+
+	FORCEINLINE FInstancedStruct* GetChannel(const FCellChannelHandle Handle, const FVector& InLocation)
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return GetChannel(Handle, GridPoint);
+	}
+
+	/** The value may be written through the pointer, so the summary of the channel is rebuilt on next use. */
+	FORCEINLINE FInstancedStruct* GetChannel(const FCellChannelHandle Handle, const FIntPoint& InGridPoint)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Handle_GetChannel)
+
+		if (!Handle.IsValid())
+		{
+			return nullptr;
+		}
+
+		FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridPoint);
+		if (!Chunk)
+		{
+			return nullptr;
+		}
+
+		return Chunk->FindChannel(Handle, InGridPoint);
+	}
+
+	FORCEINLINE const FInstancedStruct* GetChannel(const FCellChannelHandle Handle, const FVector& InLocation) const
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return GetChannel(Handle, GridPoint);
+	}
+
+	/** Read only lookup, leaves the summary of the channel untouched. */
+	FORCEINLINE const FInstancedStruct* GetChannel(const FCellChannelHandle Handle, const FIntPoint& InGridPoint) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Handle_GetChannel_Const)
+
+		if (!Handle.IsValid())
 		{
 			return nullptr;
 		}
 
-		return (*ChunkPtr)->FindChannel(Name, InGridPoint, Type);
+		const FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridPoint);
+		return Chunk ? Chunk->FindChannel(Handle, InGridPoint) : nullptr;
 	}
 
+	/** Invalidated by the next channel added to or removed from the same chunk. */
 	template <typename TStruct>
 	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FName Name, const FVector& InLocation)
 	{
@@ -106,22 +157,16 @@ public:
 		return FindOrAddChannel<TStruct>(Name, GridPoint);
 	}
 
+	/** Invalidated by the next channel added to or removed from the same chunk. */
 	template <typename TStruct>
 	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FName Name, const FIntPoint& InGridPoint)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_FindOrAddChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridPoint);
-		this->TryMakeChunk(ChunkPoint);
-
-		if (!HasChannel<TStruct>(Name, InGridPoint))
-		{
-			RegisterChannelLocation({Name, TStruct::StaticStruct()}, ChunkPoint);
-		}
-
-		return this->Chunks[ChunkPoint]->template FindOrAddChannel<TStruct>(Name, InGridPoint);
+		return FindOrAddChannel(FCellChannelRegistry::Resolve<TStruct>(Name), InGridPoint, TStruct::StaticStruct());
 	}
 
+	/** Invalidated by the next channel added to or removed from the same chunk. */
 	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FName Name, const FVector& InLocation, UScriptStruct* Type)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::FindOrAddChannel)
@@ -130,21 +175,55 @@ public:
 		return FindOrAddChannel(Name, ChunkPoint, Type);
 	}
 
+	/** Invalidated by the next channel added to or removed from the same chunk. */
 	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FName Name, const FIntPoint& InGridPoint, UScriptStruct* Type)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::FindOrAddChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridPoint);
-		this->TryMakeChunk(ChunkPoint);
+		return FindOrAddChannel(FCellChannelRegistry::Resolve(Name, Type), InGridPoint, Type);
+	}
+
+	/** Invalidated by the next channel added to or removed from the same chunk. */
+	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FCellChannelHandle Handle, const FVector& InLocation)
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return FindOrAddChannel(Handle, GridPoint);
+	}
 
-		if (!HasChannel(Name, InGridPoint, Type))
-		{
-			RegisterChannelLocation({Name, Type}, ChunkPoint);
-		}
+	/** Invalidated by the next channel added to or removed from the same chunk. */
+	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FCellChannelHandle Handle, const FIntPoint& InGridPoint)
+	{
+		return FindOrAddChannel(Handle, InGridPoint, FCellChannelRegistry::Get().GetType(Handle));
+	}
 
-		return this->Chunks[ChunkPoint]->FindOrAddChannel(Name, InGridPoint, Type);
+	/** Invalidated by the next channel added to or removed from the same chunk. */
+	template <typename TStruct>
+	FORCEINLINE FInstancedStruct* TryFindOrAddChannel(const FName Name, const FIntPoint& InGridPoint)
+	{
+		return TryFindOrAddChannel(FCellChannelRegistry::Resolve<TStruct>(Name), InGridPoint, TStruct::StaticStruct());
+	}
+
+	/** Invalidated by the next channel added to or removed from the same chunk. */
+	FORCEINLINE FInstancedStruct* TryFindOrAddChannel(const FName Name, const FVector& InLocation, UScriptStruct* Type)
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return TryFindOrAddChannel(Name, GridPoint, Type);
+	}
+
+	/** Invalidated by the next channel added to or removed from the same chunk. */
+	FORCEINLINE FInstancedStruct* TryFindOrAddChannel(const FName Name, const FIntPoint& InGridPoint,
+	                                                  UScriptStruct* Type)
+	{
+		return TryFindOrAddChannel(FCellChannelRegistry::Resolve(Name, Type), InGridPoint, Type);
+	}
+
+	/** Invalidated by the next channel added to or removed from the same chunk. */
+	FORCEINLINE FInstancedStruct* TryFindOrAddChannel(const FCellChannelHandle Handle, const FIntPoint& InGridPoint)
+	{
+		return TryFindOrAddChannel(Handle, InGridPoint, FCellChannelRegistry::Get().GetType(Handle));
 	}
 
+	/** The pointers are invalidated by the next channel added to or removed from their chunks. */
 	template <typename TStruct>
 	FORCEINLINE TArray<FInstancedStruct*> FindOrAddChannels(const FName Name, const TSet<FVector>& InLocations)
 	{
@@ -160,34 +239,17 @@ public:
 		return FindOrAddChannels<TStruct>(Name, GridLocations);
 	}
 
+	/** The pointers are invalidated by the next channel added to or removed from their chunks. */
 	template <typename TStruct>
 	FORCEINLINE TArray<FInstancedStruct*> FindOrAddChannels(const FName Name, const TSet<FIntPoint>& InGridLocations)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_FindOrAddChannels)
 
-		TArray<FInstancedStruct*> Channels;
-
-		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
-		{
-			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
-			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
-
-			this->TryMakeChunk(ChunkPoint);
-
-			for (const FIntPoint& Point : GridPoints)
-			{
-				if (!HasChannel<TStruct>(Name, Point))
-				{
-					RegisterChannelLocation({Name, TStruct::StaticStruct()}, ChunkPoint);
-				}
-
-				Channels.Add(&this->Chunks[ChunkPoint]->template FindOrAddChannel<TStruct>(Name, Point));
-			}
-		}
-
-		return Channels;
+		return FindOrAddChannels(FCellChannelRegistry::Resolve<TStruct>(Name), InGridLocations,
+		                         TStruct::StaticStruct());
 	}
 
+	/** The pointers are invalidated by the next channel added to or removed from their chunks. */
 	FORCEINLINE TArray<FInstancedStruct*> FindOrAddChannels(const FName Name, const TSet<FVector>& InLocations,
 	                                                        UScriptStruct* Type)
 	{
@@ -203,31 +265,13 @@ public:
 		return FindOrAddChannels(Name, GridLocations, Type);
 	}
 
+	/** The pointers are invalidated by the next channel added to or removed from their chunks. */
 	FORCEINLINE TArray<FInstancedStruct*> FindOrAddChannels(const FName Name, const TSet<FIntPoint>& InGridLocations,
 	                                                        UScriptStruct* Type)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::FindOrAddChannels)
 
-		TArray<FInstancedStruct*> Channels;
-		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
-		{
-			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
-			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
-
-			this->TryMakeChunk(ChunkPoint);
-
-			for (const FIntPoint& Point : GridPoints)
-			{
-				if (!HasChannel(Name, Point, Type))
-				{
-					RegisterChannelLocation({Name, Type}, ChunkPoint);
-				}
-
-				Channels.Add(&this->Chunks[ChunkPoint]->FindOrAddChannel(Name, Point, Type));
-			}
-		}
-
-		return Channels;
+		return FindOrAddChannels(FCellChannelRegistry::Resolve(Name, Type), InGridLocations, Type);
 	}
 
 	FORCEINLINE const FInstancedStruct* FindExistingChannel(const FName Name, const FVector& InLocation,
@@ -244,13 +288,8 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::FindExistingChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridLocation);
-		if (!this->Chunks.Contains(ChunkPoint))
-		{
-			return nullptr;
-		}
-
-		return this->Chunks[ChunkPoint]->FindChannel(Name, InGridLocation, Type);
+		const FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridLocation);
+		return Chunk ? Chunk->FindChannel(Name, InGridLocation, Type) : nullptr;
 	}
 
 	FORCEINLINE TArray<const FInstancedStruct*> FindExistingChannels(const FName Name,
@@ -277,6 +316,12 @@ public:
 
 		TArray<const FInstancedStruct*> Channels;
 
+		const FCellChannelHandle Handle = FCellChannelRegistry::Get().Find({Name, Type});
+		if (!Handle.IsValid())
+		{
+			return Channels;
+		}
+
 		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
 		{
 			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
@@ -287,10 +332,10 @@ public:
 				continue;
 			}
 
+			const FChunk_DynamicData& Chunk = *this->Chunks[ChunkPoint];
 			for (const FIntPoint& Point : GridPoints)
 			{
-				if (const FInstancedStruct* const Struct = this->Chunks[ChunkPoint]->FindChannel(Name, Point, Type);
-					Struct)
+				if (const FInstancedStruct* const Struct = Chunk.FindChannel(Handle, Point); Struct)
 				{
 					Channels.Add(Struct);
 				}
@@ -314,19 +359,7 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_TryRemoveChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridLocation);
-		if (!this->Chunks.Contains(ChunkPoint))
-		{
-			return false;
-		}
-
-		const bool bRemoved = this->Chunks[ChunkPoint]->template TryRemoveChannel<TStruct>(Name, InGridLocation);
-		if (bRemoved)
-		{
-			UnregisterChannelLocation({Name, TStruct::StaticStruct()}, ChunkPoint);
-		}
-
-		return bRemoved;
+		return TryRemoveChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridLocation);
 	}
 
 	FORCEINLINE bool TryRemoveChannel(const FName Name, const FVector& InLocation, UScriptStruct* Type)
@@ -341,16 +374,35 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::TryRemoveChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridLocation);
-		if (!this->Chunks.Contains(ChunkPoint))
+		return TryRemoveChannel(FCellChannelRegistry::Get().Find({Name, Type}), InGridLocation);
+	}
+
+	FORCEINLINE bool TryRemoveChannel(const FCellChannelHandle Handle, const FVector& InLocation)
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return TryRemoveChannel(Handle, GridPoint);
+	}
+
+	FORCEINLINE bool TryRemoveChannel(const FCellChannelHandle Handle, const FIntPoint& InGridLocation)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Handle_TryRemoveChannel)
+
+		if (!Handle.IsValid())
+		{
+			return false;
+		}
+
+		FIntPoint ChunkPoint;
+		FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridLocation, &ChunkPoint);
+		if (!Chunk)
 		{
 			return false;
 		}
 
-		const bool bRemoved = this->Chunks[ChunkPoint]->TryRemoveChannel(Name, InGridLocation, Type);
+		const bool bRemoved = Chunk->TryRemoveChannel(Handle, InGridLocation);
 		if (bRemoved)
 		{
-			UnregisterChannelLocation({Name, Type}, ChunkPoint);
+			UnregisterChannelLocationIfUnused(Handle, ChunkPoint);
 		}
 
 		return bRemoved;
@@ -376,29 +428,7 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_TryRemoveChannels)
 
-		bool bRemoved = false;
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
-		{
-			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
-			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
-
-			if (!this->Chunks.Contains(ChunkPoint))
-			{
-				continue;
-			}
-
-			for (const FIntPoint& Point : GridPoints)
-			{
-				if (this->Chunks[ChunkPoint]->template TryRemoveChannel<TStruct>(Name, Point))
-				{
-					UnregisterChannelLocation(Key, ChunkPoint);
-					bRemoved = true;
-				}
-			}
-		}
-
-		return bRemoved;
+		return TryRemoveChannels(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridLocations);
 	}
 
 	FORCEINLINE bool TryRemoveChannels(const FName Name, const TSet<FVector>& InLocations, UScriptStruct* Type)
@@ -419,29 +449,7 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::TryRemoveChannels)
 
-		bool bRemoved = false;
-		const FCellChannelKey Key{Name, Type};
-		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
-		{
-			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
-			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
-
-			if (!this->Chunks.Contains(ChunkPoint))
-			{
-				continue;
-			}
-
-			for (const FIntPoint& Point : GridPoints)
-			{
-				if (this->Chunks[ChunkPoint]->TryRemoveChannel(Name, Point, Type))
-				{
-					UnregisterChannelLocation(Key, ChunkPoint);
-					bRemoved = true;
-				}
-			}
-		}
-
-		return bRemoved;
+		return TryRemoveChannels(FCellChannelRegistry::Get().Find({Name, Type}), InGridLocations);
 	}
 
 	template <typename TStruct>
@@ -458,14 +466,7 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData_HasChannel::Template_HasChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridLocation);
-		TSharedPtr<FChunk_DynamicData> const* ChunkPtr = this->Chunks.Find(ChunkPoint);
-		if (!ChunkPtr || !ChunkPtr->IsValid())
-		{
-			return false;
-		}
-
-		return (*ChunkPtr)->HasChannel<TStruct>(Name, InGridLocation);
+		return HasChannel(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridLocation);
 	}
 
 	FORCEINLINE bool HasChannel(const FName Name, const FVector& InLocation, UScriptStruct* Type) const
@@ -480,14 +481,31 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData_HasChannel::HasChannel)
 
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGridLocation);
-		TSharedPtr<FChunk_DynamicData> const* ChunkPtr = this->Chunks.Find(ChunkPoint);
-		if (!ChunkPtr || !ChunkPtr->IsValid())
+		return HasChannel(FCellChannelRegistry::Get().Find({Name, Type}), InGridLocation);
+	}
+
+	FORCEINLINE bool HasChannel(const FCellChannelHandle Handle, const FVector& InLocation) const
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return HasChannel(Handle, GridPoint);
+	}
+
+	FORCEINLINE bool HasChannel(const FCellChannelHandle Handle, const FIntPoint& InGridLocation) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData_HasChannel::Handle_HasChannel)
+
+		if (!Handle.IsValid())
 		{
 			return false;
 		}
 
-		return (*ChunkPtr)->HasChannel(Name, InGridLocation, Type);
+		const FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridLocation);
+		if (!Chunk)
+		{
+			return false;
+		}
+
+		return Chunk->HasChannel(Handle, InGridLocation);
 	}
 
 	template <typename TStruct>
@@ -510,27 +528,7 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_HasChannels)
 
-		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
-		{
-			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
-			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
-
-			TSharedPtr<FChunk_DynamicData> const* ChunkPtr = this->Chunks.Find(ChunkPoint);
-			if (!ChunkPtr || !ChunkPtr->IsValid())
-			{
-				return false;
-			}
-
-			for (const FIntPoint& Point : GridPoints)
-			{
-				if (!(*ChunkPtr)->HasChannel<TStruct>(Name, Point))
-				{
-					return false;
-				}
-			}
-		}
-
-		return true;
+		return HasChannels(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridLocations);
 	}
 
 	FORCEINLINE bool HasChannels(const FName Name, const TSet<FVector>& InLocations, UScriptStruct* Type) const
@@ -551,157 +549,1764 @@ public:
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::HasChannels)
 
-		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
-		{
-			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
-			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
-
-			TSharedPtr<FChunk_DynamicData> const* ChunkPtr = this->Chunks.Find(ChunkPoint);
-			if (!ChunkPtr || !ChunkPtr->IsValid())
-			{
-				return false;
-			}
-
-			for (const FIntPoint& Point : GridPoints)
-			{
-				if (!(*ChunkPtr)->HasChannel(Name, Point, Type))
-				{
-					return false;
-				}
-			}
-		}
-
-		return true;
+		return HasChannels(FCellChannelRegistry::Get().Find({Name, Type}), InGridLocations);
 	}
 
-	template <typename TStruct>
-	TSet<FIntPoint> const* FindChannelLocations(const FName Name) const
+	/**
+	 * Type must be the type the handle was resolved with. The point must be inside of the chunk grid
+	 * bounds, use TryFindOrAddChannel for points that may not be.
+	 *
+	 * Like FChunk_DynamicData::FindOrAddChannel the reference is invalidated by the next channel added
+	 * to or removed from the same chunk, while the struct memory it owns stays valid.
+	 */
+	FORCEINLINE FInstancedStruct& FindOrAddChannel(const FCellChannelHandle Handle, const FIntPoint& InGridPoint,
+	                                               const UScriptStruct* Type)
 	{
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		return FindChannelLocations(Key);
-	}
+		FInstancedStruct* const Channel = TryFindOrAddChannel(Handle, InGridPoint, Type);
+		checkf(Channel, TEXT("Cell %s is outside of the chunk grid bounds"), *InGridPoint.ToString());
 
-	TSet<FIntPoint> const* FindChannelLocations(const FName Name, UScriptStruct* Type) const
-	{
-		const FCellChannelKey Key{Name, Type};
-		return FindChannelLocations(Key);
+		return *Channel;
 	}
 
-	template <typename TStruct>
-	TChannelIteratorRange<TStruct> IterateChannel(const FName Name)
+	/**
+	 * Like FindOrAddChannel but returns nullptr for points outside of the chunk grid bounds. The pointer
+	 * is invalidated the same way as the reference of FindOrAddChannel.
+	 */
+	FORCEINLINE FInstancedStruct* TryFindOrAddChannel(const FCellChannelHandle Handle, const FIntPoint& InGridPoint,
+	                                                  const UScriptStruct* Type)
 	{
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		return TChannelIteratorRangeImpl<TStruct, false>(this, Key);
-	}
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Handle_FindOrAddChannel)
 
-	template <typename TStruct>
-	TConstChannelIteratorRange<TStruct> IterateChannel(const FName Name) const
-	{
-		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
-		return TChannelIteratorRangeImpl<TStruct, true>(this, Key);
-	}
+		FIntPoint ChunkPoint;
+		FChunk_DynamicData* const Chunk = this->FindOrMakeChunkCached(InGridPoint, &ChunkPoint);
+		if (!Chunk)
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Warning, TEXT("Cell %s is outside of the chunk grid bounds."),
+			           *InGridPoint.ToString());
+			return nullptr;
+		}
 
-	FORCEINLINE virtual bool TryRemoveChunkByLocation(const FVector& InGlobalLocation) override
-	{
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGlobalLocation);
-		return TryRemoveChunkInternal(ChunkPoint);
+		RegisterChannelLocation(Handle, ChunkPoint);
+		return &Chunk->FindOrAddChannel(Handle, InGridPoint, Type);
 	}
 
-	FORCEINLINE virtual bool TryRemoveChunkByGrid(const FIntPoint& InGlobalGridLocation) override
+	FORCEINLINE bool SetChannelValue(const FCellChannelHandle Handle, const FVector& InLocation,
+	                                 const FInstancedStruct& Value)
 	{
-		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGlobalGridLocation);
-		return TryRemoveChunkInternal(ChunkPoint);
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return SetChannelValue(Handle, GridPoint, Value);
 	}
 
-	FORCEINLINE virtual void Empty(const int32 ExpectedNumElements = 0) override
+	/**
+	 * Copies Value into the channel of the cell, adding the channel if missing, and updates the kept
+	 * aggregate summary in place. Returns false if Value is not of the type the handle was resolved with
+	 * or the point is outside of the chunk grid bounds.
+	 */
+	bool SetChannelValue(const FCellChannelHandle Handle, const FIntPoint& InGridPoint, const FInstancedStruct& Value)
 	{
-		Super::Empty(ExpectedNumElements);
-		RebuildChannelIndex(ExpectedNumElements);
-	}
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::SetChannelValue)
 
-	// Debug
-	FORCEINLINE void DrawDebug(const TFunction<FVector(const FIntPoint&)>& InConvertor) const
-	{
-		for (const TPair<FIntPoint, TSharedPtr<FChunk_DynamicData>>& Chunk : this->Chunks)
+		if (!Handle.IsValid() || !Value.IsValid())
 		{
-			Chunk.Value->DrawDebug(this->GetWorld(), InConvertor);
+			return false;
 		}
-	}
 
-private:
-	template <typename, bool>
+		if (Value.GetScriptStruct() != FCellChannelRegistry::Get().GetType(Handle))
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Warning, TEXT("Value type %s does not match the channel type."),
+			           *Value.GetScriptStruct()->GetName());
+			return false;
+		}
+
+		FIntPoint ChunkPoint;
+		FChunk_DynamicData* const Chunk = this->FindOrMakeChunkCached(InGridPoint, &ChunkPoint);
+		if (!Chunk)
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Warning, TEXT("Cell %s is outside of the chunk grid bounds."),
+			           *InGridPoint.ToString());
+			return false;
+		}
+
+		RegisterChannelLocation(Handle, ChunkPoint);
+		Chunk->SetChannelValue(Handle, InGridPoint, Value);
+		return true;
+	}
+
+	/** The pointers are invalidated by the next channel added to or removed from their chunks. */
+	FORCEINLINE TArray<FInstancedStruct*> FindOrAddChannels(const FCellChannelHandle Handle,
+	                                                        const TSet<FIntPoint>& InGridLocations)
+	{
+		return FindOrAddChannels(Handle, InGridLocations, FCellChannelRegistry::Get().GetType(Handle));
+	}
+
+	/**
+	 * Type must be the type the handle was resolved with. The pointers are collected once every point
+	 * is added and are invalidated by the next channel added to or removed from their chunks.
+	 */
+	FORCEINLINE TArray<FInstancedStruct*> FindOrAddChannels(const FCellChannelHandle Handle,
+	                                                        const TSet<FIntPoint>& InGridLocations,
+	                                                        const UScriptStruct* Type)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Handle_FindOrAddChannels)
+
+		TArray<FInstancedStruct*> Channels;
+		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
+		{
+			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
+			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
+
+			if (!this->Chunks.IsInBounds(ChunkPoint))
+			{
+				continue;
+			}
+
+			this->TryMakeChunk(ChunkPoint);
+
+			FChunk_DynamicData& Chunk = *this->Chunks[ChunkPoint];
+			RegisterChannelLocation(Handle, ChunkPoint);
+
+			// Adding channels may move cells and their inline channels, collect pointers once all are added.
+			for (const FIntPoint& Point : GridPoints)
+			{
+				Chunk.FindOrAddChannel(Handle, Point, Type);
+			}
+
+			for (const FIntPoint& Point : GridPoints)
+			{
+				Channels.Add(Chunk.FindChannel(Handle, Point));
+			}
+		}
+
+		return Channels;
+	}
+
+	FORCEINLINE bool TryRemoveChannels(const FCellChannelHandle Handle, const TSet<FIntPoint>& InGridLocations)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Handle_TryRemoveChannels)
+
+		if (!Handle.IsValid())
+		{
+			return false;
+		}
+
+		bool bRemoved = false;
+		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
+		{
+			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
+			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
+
+			if (!this->Chunks.Contains(ChunkPoint))
+			{
+				continue;
+			}
+
+			FChunk_DynamicData& Chunk = *this->Chunks[ChunkPoint];
+			for (const FIntPoint& Point : GridPoints)
+			{
+				if (Chunk.TryRemoveChannel(Handle, Point))
+				{
+					bRemoved = true;
+				}
+			}
+
+			UnregisterChannelLocationIfUnused(Handle, ChunkPoint);
+		}
+
+		return bRemoved;
+	}
+
+	FORCEINLINE bool HasChannels(const FCellChannelHandle Handle, const TSet<FIntPoint>& InGridLocations) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Handle_HasChannels)
+
+		for (const TPair<FIntPoint, TSet<FIntPoint>>& ChunkToGrid : this->SplitGridLocationsToChunks(InGridLocations))
+		{
+			const FIntPoint& ChunkPoint = ChunkToGrid.Key;
+			const TSet<FIntPoint>& GridPoints = ChunkToGrid.Value;
+
+			FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+			if (!Handle.IsValid() || !ChunkPtr || !ChunkPtr->IsValid())
+			{
+				return false;
+			}
+
+			for (const FIntPoint& Point : GridPoints)
+			{
+				if (!(*ChunkPtr)->HasChannel(Handle, Point))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Array view batches, grouped by chunk with a sort into a scratch buffer instead of hashed containers.
+	/**
+	 * Adds the channel to every point. OutChannels is reset and filled index aligned
+	 * with the points, points outside of the chunk grid bounds get nullptr. The pointers
+	 * are invalidated by the next channel added to or removed from their chunks.
+	 */
+	FORCEINLINE void FindOrAddChannels(const FCellChannelHandle Handle, const TConstArrayView<FIntPoint> InGridLocations,
+	                                   TArray<FInstancedStruct*>& OutChannels)
+	{
+		FindOrAddChannels(Handle, InGridLocations, OutChannels, ChunkBatch::GetThreadScratch());
+	}
+
+	void FindOrAddChannels(const FCellChannelHandle Handle, const TConstArrayView<FIntPoint> InGridLocations,
+	                       TArray<FInstancedStruct*>& OutChannels, FChunkBatchScratch& Scratch)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Batch_FindOrAddChannels)
+
+		OutChannels.Reset();
+		OutChannels.SetNumZeroed(InGridLocations.Num(), EAllowShrinking::No);
+
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+
+		const UScriptStruct* Type = FCellChannelRegistry::Get().GetType(Handle);
+		this->ForEachChunkGroup(InGridLocations, Scratch,
+		                        [this, Handle, Type, InGridLocations, &OutChannels](
+		                        const FIntPoint& ChunkPoint, const TConstArrayView<FChunkBatchItem> Group)
+		                        {
+			                        if (!this->Chunks.IsInBounds(ChunkPoint))
+			                        {
+				                        return;
+			                        }
+
+			                        this->TryMakeChunk(ChunkPoint);
+
+			                        FChunk_DynamicData& Chunk = *this->Chunks[ChunkPoint];
+			                        RegisterChannelLocation(Handle, ChunkPoint);
+
+			                        // Adding channels may move cells, collect pointers once the whole chunk is done.
+			                        for (const FChunkBatchItem& Item : Group)
+			                        {
+				                        Chunk.FindOrAddChannel(Handle, InGridLocations[Item.PointIndex], Type);
+			                        }
+
+			                        for (const FChunkBatchItem& Item : Group)
+			                        {
+				                        OutChannels[Item.PointIndex] = Chunk.FindChannel(
+					                        Handle, InGridLocations[Item.PointIndex]);
+			                        }
+		                        });
+	}
+
+	/** OutChannels is reset and filled index aligned with the points, nullptr where the channel is missing. */
+	FORCEINLINE void FindExistingChannels(const FCellChannelHandle Handle,
+	                                      const TConstArrayView<FIntPoint> InGridLocations,
+	                                      TArray<const FInstancedStruct*>& OutChannels) const
+	{
+		FindExistingChannels(Handle, InGridLocations, OutChannels, ChunkBatch::GetThreadScratch());
+	}
+
+	void FindExistingChannels(const FCellChannelHandle Handle, const TConstArrayView<FIntPoint> InGridLocations,
+	                          TArray<const FInstancedStruct*>& OutChannels, FChunkBatchScratch& Scratch) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Batch_FindExistingChannels)
+
+		OutChannels.Reset();
+		OutChannels.SetNumZeroed(InGridLocations.Num(), EAllowShrinking::No);
+
+		if (!Handle.IsValid())
+		{
+			return;
+		}
+
+		this->ForEachChunkGroup(InGridLocations, Scratch,
+		                        [this, Handle, InGridLocations, &OutChannels](
+		                        const FIntPoint& ChunkPoint, const TConstArrayView<FChunkBatchItem> Group)
+		                        {
+			                        FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+			                        if (!ChunkPtr || !ChunkPtr->IsValid())
+			                        {
+				                        return;
+			                        }
+
+			                        const FChunk_DynamicData& Chunk = **ChunkPtr;
+			                        for (const FChunkBatchItem& Item : Group)
+			                        {
+				                        OutChannels[Item.PointIndex] = Chunk.FindChannel(
+					                        Handle, InGridLocations[Item.PointIndex]);
+			                        }
+		                        });
+	}
+
+	FORCEINLINE bool TryRemoveChannels(const FCellChannelHandle Handle, const TConstArrayView<FIntPoint> InGridLocations)
+	{
+		return TryRemoveChannels(Handle, InGridLocations, ChunkBatch::GetThreadScratch());
+	}
+
+	bool TryRemoveChannels(const FCellChannelHandle Handle, const TConstArrayView<FIntPoint> InGridLocations,
+	                       FChunkBatchScratch& Scratch)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Batch_TryRemoveChannels)
+
+		if (!Handle.IsValid())
+		{
+			return false;
+		}
+
+		bool bRemoved = false;
+		this->ForEachChunkGroup(InGridLocations, Scratch,
+		                        [this, Handle, InGridLocations, &bRemoved](
+		                        const FIntPoint& ChunkPoint, const TConstArrayView<FChunkBatchItem> Group)
+		                        {
+			                        FChunkPtr* const ChunkPtr = this->Chunks.Find(ChunkPoint);
+			                        if (!ChunkPtr || !ChunkPtr->IsValid())
+			                        {
+				                        return;
+			                        }
+
+			                        FChunk_DynamicData& Chunk = **ChunkPtr;
+			                        for (const FChunkBatchItem& Item : Group)
+			                        {
+				                        bRemoved |= Chunk.TryRemoveChannel(Handle, InGridLocations[Item.PointIndex]);
+			                        }
+
+			                        UnregisterChannelLocationIfUnused(Handle, ChunkPoint);
+		                        });
+
+		return bRemoved;
+	}
+
+	/** True if every point holds the channel. */
+	FORCEINLINE bool HasChannels(const FCellChannelHandle Handle, const TConstArrayView<FIntPoint> InGridLocations) const
+	{
+		return HasChannels(Handle, InGridLocations, ChunkBatch::GetThreadScratch());
+	}
+
+	bool HasChannels(const FCellChannelHandle Handle, const TConstArrayView<FIntPoint> InGridLocations,
+	                 FChunkBatchScratch& Scratch) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Batch_HasChannels)
+
+		if (!Handle.IsValid())
+		{
+			return InGridLocations.IsEmpty();
+		}
+
+		bool bHasAll = true;
+		this->ForEachChunkGroup(InGridLocations, Scratch,
+		                        [this, Handle, InGridLocations, &bHasAll](
+		                        const FIntPoint& ChunkPoint, const TConstArrayView<FChunkBatchItem> Group)
+		                        {
+			                        if (!bHasAll)
+			                        {
+				                        return;
+			                        }
+
+			                        FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+			                        if (!ChunkPtr || !ChunkPtr->IsValid() || !(*ChunkPtr)->HasAnyChannel(Handle))
+			                        {
+				                        bHasAll = false;
+				                        return;
+			                        }
+
+			                        for (const FChunkBatchItem& Item : Group)
+			                        {
+				                        if (!(*ChunkPtr)->HasChannel(Handle, InGridLocations[Item.PointIndex]))
+				                        {
+					                        bHasAll = false;
+					                        return;
+				                        }
+			                        }
+		                        });
+
+		return bHasAll;
+	}
+
+	/**
+	 * Returns the cells of the grid region (Max exclusive) matching the channel query.
+	 * Each chunk is evaluated over its channel masks, cell payloads are not read.
+	 */
+	TArray<FIntPoint> QueryCells(const FChunkChannelQuery& Query, const FIntRect& InGridRegion) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::QueryCells)
+
+		TArray<FIntPoint> Cells;
+		if (Query.IsEmpty())
+		{
+			return Cells;
+		}
+
+		this->ForEachChunkInRegion(InGridRegion, [&Query, &InGridRegion, &Cells](const FIntPoint&,
+		                                                                        const FChunk_DynamicData& Chunk)
+		{
+			Chunk.QueryCells(Query, InGridRegion, Cells);
+		});
+
+		return Cells;
+	}
+
+	// Regions
+	// Rectangles are in grid cells with Max exclusive. Only the chunks overlapping the rectangle are
+	// visited and each of them only walks its clipped part of it.
+
+	template <typename TStruct>
+	FORCEINLINE int32 FillRegion(const FName Name, const FIntRect& InGridRegion, const TStruct& Value)
+	{
+		return FillRegion(FCellChannelRegistry::Resolve<TStruct>(Name), InGridRegion, FInstancedStruct::Make(Value));
+	}
+
+	FORCEINLINE int32 FillRegion(const FName Name, const FIntRect& InGridRegion, const FInstancedStruct& Value)
+	{
+		return FillRegion(FCellChannelRegistry::Resolve(Name, const_cast<UScriptStruct*>(Value.GetScriptStruct())),
+		                  InGridRegion, Value);
+	}
+
+	/**
+	 * Writes a copy of Value to the channel of every cell of the region, creating chunks as needed.
+	 * Value must be of the type the handle was resolved with. Cells outside of the chunk grid bounds
+	 * are skipped. Returns the number of cells written.
+	 */
+	int32 FillRegion(const FCellChannelHandle Handle, const FIntRect& InGridRegion, const FInstancedStruct& Value)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::FillRegion)
+
+		if (!Handle.IsValid() || !Value.IsValid())
+		{
+			return 0;
+		}
+
+		if (Value.GetScriptStruct() != FCellChannelRegistry::Get().GetType(Handle))
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Warning, TEXT("Fill value type %s does not match the channel type."),
+			           *Value.GetScriptStruct()->GetName());
+			return 0;
+		}
+
+		const FIntRect Range = this->GetChunkRangeOfRegion(InGridRegion);
+
+		int32 Count = 0;
+		for (int32 X = Range.Min.X; X < Range.Max.X; ++X)
+		{
+			for (int32 Y = Range.Min.Y; Y < Range.Max.Y; ++Y)
+			{
+				const FIntPoint ChunkPoint(X, Y);
+				this->TryMakeChunk(ChunkPoint);
+
+				const int32 Written = this->Chunks[ChunkPoint]->FillRegion(Handle, InGridRegion, Value);
+				if (Written > 0)
+				{
+					RegisterChannelLocation(Handle, ChunkPoint);
+					Count += Written;
+				}
+			}
+		}
+
+		return Count;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE int32 ClearRegion(const FName Name, const FIntRect& InGridRegion)
+	{
+		return ClearRegion(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridRegion);
+	}
+
+	FORCEINLINE int32 ClearRegion(const FName Name, const FIntRect& InGridRegion, UScriptStruct* Type)
+	{
+		return ClearRegion(FCellChannelRegistry::Get().Find({Name, Type}), InGridRegion);
+	}
+
+	/** Removes the channel from every cell of the region, returns the number of cells it was removed from. */
+	int32 ClearRegion(const FCellChannelHandle Handle, const FIntRect& InGridRegion)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::ClearRegion)
+
+		if (!Handle.IsValid())
+		{
+			return 0;
+		}
+
+		int32 Count = 0;
+		this->ForEachChunkInRegion(InGridRegion, [this, Handle, &InGridRegion, &Count](const FIntPoint& ChunkPoint,
+		                                                                             FChunk_DynamicData& Chunk)
+		{
+			if (Chunk.HasAnyChannel(Handle))
+			{
+				Count += Chunk.ClearRegion(Handle, InGridRegion);
+				UnregisterChannelLocationIfUnused(Handle, ChunkPoint);
+			}
+		});
+
+		return Count;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TArray<FIntPoint> QueryRegion(const FName Name, const FIntRect& InGridRegion) const
+	{
+		return QueryRegion(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridRegion);
+	}
+
+	FORCEINLINE TArray<FIntPoint> QueryRegion(const FName Name, const FIntRect& InGridRegion, UScriptStruct* Type) const
+	{
+		return QueryRegion(FCellChannelRegistry::Get().Find({Name, Type}), InGridRegion);
+	}
+
+	/** Cells of the region holding the channel, chunk by chunk in local cell order. */
+	FORCEINLINE TArray<FIntPoint> QueryRegion(const FCellChannelHandle Handle, const FIntRect& InGridRegion) const
+	{
+		if (!Handle.IsValid())
+		{
+			return TArray<FIntPoint>();
+		}
+
+		return QueryCells(FChunkChannelQuery().Where(Handle), InGridRegion);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE int32 CountRegion(const FName Name, const FIntRect& InGridRegion) const
+	{
+		return CountRegion(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridRegion);
+	}
+
+	FORCEINLINE int32 CountRegion(const FName Name, const FIntRect& InGridRegion, UScriptStruct* Type) const
+	{
+		return CountRegion(FCellChannelRegistry::Get().Find({Name, Type}), InGridRegion);
+	}
+
+	/** Number of cells of the region holding the channel, counted on the occupancy masks. */
+	int32 CountRegion(const FCellChannelHandle Handle, const FIntRect& InGridRegion) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::CountRegion)
+
+		if (!Handle.IsValid())
+		{
+			return 0;
+		}
+
+		int32 Count = 0;
+		ForEachChannelChunkInRegion(Handle, InGridRegion, [Handle, &InGridRegion, &Count](const FIntPoint&,
+		                                                                                const FChunk_DynamicData& Chunk)
+		{
+			Count += Chunk.CountRegion(Handle, InGridRegion);
+		});
+
+		return Count;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool HasAnyInRegion(const FName Name, const FIntRect& InGridRegion) const
+	{
+		return HasAnyInRegion(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridRegion);
+	}
+
+	FORCEINLINE bool HasAnyInRegion(const FName Name, const FIntRect& InGridRegion, UScriptStruct* Type) const
+	{
+		return HasAnyInRegion(FCellChannelRegistry::Get().Find({Name, Type}), InGridRegion);
+	}
+
+	/**
+	 * Whether any cell of the region holds the channel. Answered from the coarsest level that can: a
+	 * superchunk or chunk inside the region that holds the channel answers at once, only chunks on the
+	 * border of the region look at their cells.
+	 */
+	bool HasAnyInRegion(const FCellChannelHandle Handle, const FIntRect& InGridRegion) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::HasAnyInRegion)
+
+		const TSet<FIntPoint>* const Locations = ChannelIndex.Find(Handle);
+		const FIntRect Range = this->GetChunkRangeOfRegion(InGridRegion);
+		if (!Locations || Range.Min.X >= Range.Max.X)
+		{
+			return false;
+		}
+
+		// Chunks whose cells all lie in the region.
+		const int32 Size = this->GetChunkSize();
+		const FIntRect Inner(this->ConvertGlobalToChunkGrid(InGridRegion.Min + FIntPoint(Size - 1, Size - 1)),
+		                     this->ConvertGlobalToChunkGrid(InGridRegion.Max));
+
+		return ForEachChannelSuperchunkInRange(Handle, Range, [this, Handle, &InGridRegion, Locations, &Inner](
+			const FIntRect& BlockChunks, const bool bWholeBlock)
+		{
+			if (bWholeBlock && Inner.Contains(BlockChunks.Min) && Inner.Contains(BlockChunks.Max - FIntPoint(1, 1)))
+			{
+				return true;
+			}
+
+			for (int32 X = BlockChunks.Min.X; X < BlockChunks.Max.X; ++X)
+			{
+				for (int32 Y = BlockChunks.Min.Y; Y < BlockChunks.Max.Y; ++Y)
+				{
+					const FIntPoint ChunkPoint(X, Y);
+					if (!Locations->Contains(ChunkPoint))
+					{
+						continue;
+					}
+
+					if (Inner.Contains(ChunkPoint))
+					{
+						return true;
+					}
+
+					FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+					if (ChunkPtr && ChunkPtr->IsValid() && (*ChunkPtr)->HasAnyInRegion(Handle, InGridRegion))
+					{
+						return true;
+					}
+				}
+			}
+
+			return false;
+		});
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool IsRegionEmpty(const FName Name, const FIntRect& InGridRegion) const
+	{
+		return !HasAnyInRegion<TStruct>(Name, InGridRegion);
+	}
+
+	FORCEINLINE bool IsRegionEmpty(const FName Name, const FIntRect& InGridRegion, UScriptStruct* Type) const
+	{
+		return !HasAnyInRegion(Name, InGridRegion, Type);
+	}
+
+	FORCEINLINE bool IsRegionEmpty(const FCellChannelHandle Handle, const FIntRect& InGridRegion) const
+	{
+		return !HasAnyInRegion(Handle, InGridRegion);
+	}
+
+	// Radius queries
+	// A cell is inside the disc when its center lies within the radius of the disc center, in continuous grid
+	// space where cell (X, Y) covers [X, X + 1) x [Y, Y + 1).
+
+	template <typename TStruct>
+	FORCEINLINE TArray<FIntPoint> QueryRadius(const FName Name, const FVector& InLocation, const double InRadius) const
+	{
+		return QueryRadius(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InLocation, InRadius);
+	}
+
+	FORCEINLINE TArray<FIntPoint> QueryRadius(const FName Name, const FVector& InLocation, const double InRadius,
+	                                          UScriptStruct* Type) const
+	{
+		return QueryRadius(FCellChannelRegistry::Get().Find({Name, Type}), InLocation, InRadius);
+	}
+
+	/**
+	 * World space overload. Exact with the default world to grid conversion, custom conversions only
+	 * resolve whole cells so the disc is then centered on the cell of InLocation and its radius is measured
+	 * between the cells of the extents along X.
+	 */
+	TArray<FIntPoint> QueryRadius(const FCellChannelHandle Handle, const FVector& InLocation,
+	                              const double InRadius) const
+	{
+		if (InRadius < 0.0)
+		{
+			return TArray<FIntPoint>();
+		}
+
+		if constexpr (FuncConv == &UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToGrid)
+		{
+			const FVector2D GridCenter = UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToContinuousGrid(
+				this->GetWorld(), InLocation);
+			return QueryRadius(Handle, GridCenter, InRadius / UChunkBlueprintFunctionLibrary::GetCellSize());
+		}
+		else
+		{
+			const FIntPoint GridCenter = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+			const FIntPoint GridMin = this->ConvertWorldToGridFunc(this->GetWorld(),
+			                                                       InLocation - FVector(InRadius, 0.0, 0.0));
+			const FIntPoint GridMax = this->ConvertWorldToGridFunc(this->GetWorld(),
+			                                                       InLocation + FVector(InRadius, 0.0, 0.0));
+
+			return QueryRadius(Handle, FVector2D(GridCenter) + FVector2D(0.5, 0.5),
+			                   FMath::Abs(GridMax.X - GridMin.X) * 0.5);
+		}
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TArray<FIntPoint> QueryRadius(const FName Name, const FIntPoint& InCenter, const int32 InRadius) const
+	{
+		return QueryRadius(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InCenter, InRadius);
+	}
+
+	FORCEINLINE TArray<FIntPoint> QueryRadius(const FName Name, const FIntPoint& InCenter, const int32 InRadius,
+	                                          UScriptStruct* Type) const
+	{
+		return QueryRadius(FCellChannelRegistry::Get().Find({Name, Type}), InCenter, InRadius);
+	}
+
+	/** Cells within InRadius whole cells of the cell InCenter. */
+	FORCEINLINE TArray<FIntPoint> QueryRadius(const FCellChannelHandle Handle, const FIntPoint& InCenter,
+	                                          const int32 InRadius) const
+	{
+		return QueryRadius(Handle, FVector2D(InCenter) + FVector2D(0.5, 0.5), static_cast<double>(InRadius));
+	}
+
+	/**
+	 * Cells holding the channel whose center lies within InRadius of InCenter, in continuous grid space and
+	 * in no particular order. Only chunks overlapping the bounding square of the disc and indexed for the
+	 * channel are visited.
+	 */
+	TArray<FIntPoint> QueryRadius(const FCellChannelHandle Handle, const FVector2D& InCenter,
+	                              const double InRadius) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::QueryRadius)
+
+		TArray<FIntPoint> Cells;
+		if (!Handle.IsValid() || !(InRadius >= 0.0))
+		{
+			return Cells;
+		}
+
+		// Cells whose centers can reach the disc, Max exclusive and clamped to the int32 grid.
+		const auto ToGrid = [](const double Value)
+		{
+			return static_cast<int32>(FMath::Clamp(Value, static_cast<double>(MIN_int32),
+			                                       static_cast<double>(MAX_int32)));
+		};
+		const FIntRect Square(ToGrid(FMath::FloorToDouble(InCenter.X - 0.5 - InRadius)),
+		                      ToGrid(FMath::FloorToDouble(InCenter.Y - 0.5 - InRadius)),
+		                      ToGrid(FMath::FloorToDouble(InCenter.X - 0.5 + InRadius) + 1.0),
+		                      ToGrid(FMath::FloorToDouble(InCenter.Y - 0.5 + InRadius) + 1.0));
+
+		ForEachChannelChunkInRegion(Handle, Square, [Handle, &InCenter, InRadius, &Cells](const FIntPoint&,
+		                                                                                 const FChunk_DynamicData& Chunk)
+		{
+			Chunk.QueryDisc(Handle, InCenter, InRadius, Cells);
+		});
+
+		return Cells;
+	}
+
+	// Raycasts
+	// Rays are segments in continuous grid space, see FChunkRay. Chunks that are absent or lack the channel
+	// are crossed in a single step.
+
+	/**
+	 * Ray between two world locations. Exact with the default world to grid conversion, custom
+	 * conversions only resolve whole cells so the ray then joins the centers of the end cells.
+	 */
+	FChunkRay MakeRay(const FVector& InStart, const FVector& InEnd) const
+	{
+		if constexpr (FuncConv == &UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToGrid)
+		{
+			return FChunkRay(UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToContinuousGrid(this->GetWorld(), InStart),
+			                 UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToContinuousGrid(this->GetWorld(), InEnd));
+		}
+		else
+		{
+			return MakeRay(this->ConvertWorldToGridFunc(this->GetWorld(), InStart),
+			               this->ConvertWorldToGridFunc(this->GetWorld(), InEnd));
+		}
+	}
+
+	/** Ray between the centers of two cells. */
+	FORCEINLINE static FChunkRay MakeRay(const FIntPoint& InStart, const FIntPoint& InEnd)
+	{
+		return FChunkRay(FVector2D(InStart) + FVector2D(0.5, 0.5), FVector2D(InEnd) + FVector2D(0.5, 0.5));
+	}
+
+	template <typename TStruct>
+	FORCEINLINE FChunkRayHit Raycast(const FName Name, const FVector& InStart, const FVector& InEnd) const
+	{
+		return Raycast(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), MakeRay(InStart, InEnd));
+	}
+
+	FORCEINLINE FChunkRayHit Raycast(const FName Name, const FVector& InStart, const FVector& InEnd,
+	                                 UScriptStruct* Type) const
+	{
+		return Raycast(FCellChannelRegistry::Get().Find({Name, Type}), MakeRay(InStart, InEnd));
+	}
+
+	FORCEINLINE FChunkRayHit Raycast(const FCellChannelHandle Handle, const FVector& InStart,
+	                                 const FVector& InEnd) const
+	{
+		return Raycast(Handle, MakeRay(InStart, InEnd));
+	}
+
+	template <typename TStruct>
+	FORCEINLINE FChunkRayHit Raycast(const FName Name, const FChunkRay& InRay) const
+	{
+		return Raycast(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InRay);
+	}
+
+	FORCEINLINE FChunkRayHit Raycast(const FName Name, const FChunkRay& InRay, UScriptStruct* Type) const
+	{
+		return Raycast(FCellChannelRegistry::Get().Find({Name, Type}), InRay);
+	}
+
+	/** First cell along the ray holding the channel, the result has no hit if there is none. */
+	FChunkRayHit Raycast(const FCellChannelHandle Handle, const FChunkRay& InRay) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Raycast)
+
+		if (!ChannelIndex.Contains(Handle))
+		{
+			return FChunkRayHit();
+		}
+
+		FChunkGridTraversal Traversal(InRay.Start, InRay.End);
+		while (!Traversal.IsDone())
+		{
+			const FChunk_DynamicData* const Chunk = FindChunkOnTraversal(Traversal);
+			if (Chunk && Chunk->TraceFirst(Handle, Traversal))
+			{
+				return FChunkRayHit(Traversal.GetCell(), Traversal.GetEntryTime());
+			}
+		}
+
+		return FChunkRayHit();
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TArray<FChunkRayHit> RaycastAll(const FName Name, const FVector& InStart, const FVector& InEnd) const
+	{
+		return RaycastAll(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), MakeRay(InStart, InEnd));
+	}
+
+	FORCEINLINE TArray<FChunkRayHit> RaycastAll(const FName Name, const FVector& InStart, const FVector& InEnd,
+	                                            UScriptStruct* Type) const
+	{
+		return RaycastAll(FCellChannelRegistry::Get().Find({Name, Type}), MakeRay(InStart, InEnd));
+	}
+
+	FORCEINLINE TArray<FChunkRayHit> RaycastAll(const FCellChannelHandle Handle, const FVector& InStart,
+	                                            const FVector& InEnd) const
+	{
+		return RaycastAll(Handle, MakeRay(InStart, InEnd));
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TArray<FChunkRayHit> RaycastAll(const FName Name, const FChunkRay& InRay) const
+	{
+		return RaycastAll(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InRay);
+	}
+
+	FORCEINLINE TArray<FChunkRayHit> RaycastAll(const FName Name, const FChunkRay& InRay, UScriptStruct* Type) const
+	{
+		return RaycastAll(FCellChannelRegistry::Get().Find({Name, Type}), InRay);
+	}
+
+	/** Every cell along the ray holding the channel, from the start of the ray to its end. */
+	TArray<FChunkRayHit> RaycastAll(const FCellChannelHandle Handle, const FChunkRay& InRay) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::RaycastAll)
+
+		TArray<FChunkRayHit> Hits;
+		if (!ChannelIndex.Contains(Handle))
+		{
+			return Hits;
+		}
+
+		FChunkGridTraversal Traversal(InRay.Start, InRay.End);
+		while (!Traversal.IsDone())
+		{
+			if (const FChunk_DynamicData* const Chunk = FindChunkOnTraversal(Traversal))
+			{
+				Chunk->TraceAll(Handle, Traversal, Hits);
+			}
+		}
+
+		return Hits;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TArray<FChunkRayHit> RaycastBatch(const FName Name, const TConstArrayView<FChunkRay> InRays) const
+	{
+		return RaycastBatch(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InRays);
+	}
+
+	FORCEINLINE TArray<FChunkRayHit> RaycastBatch(const FName Name, const TConstArrayView<FChunkRay> InRays,
+	                                              UScriptStruct* Type) const
+	{
+		return RaycastBatch(FCellChannelRegistry::Get().Find({Name, Type}), InRays);
+	}
+
+	/**
+	 * First hit of each ray, in the order of the rays. The rays are traced in parallel, the system must not
+	 * be modified meanwhile.
+	 */
+	TArray<FChunkRayHit> RaycastBatch(const FCellChannelHandle Handle, const TConstArrayView<FChunkRay> InRays) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::RaycastBatch)
+
+		TArray<FChunkRayHit> Hits;
+		Hits.SetNum(InRays.Num());
+
+		if (!ChannelIndex.Contains(Handle))
+		{
+			return Hits;
+		}
+
+		ParallelFor(InRays.Num(), [this, Handle, &InRays, &Hits](const int32 Index)
+		{
+			Hits[Index] = Raycast(Handle, InRays[Index]);
+		});
+
+		return Hits;
+	}
+
+	// Aggregates
+	template <typename TStruct>
+	FORCEINLINE bool AddAggregateField(const FName Name, const FName FieldName)
+	{
+		return AddAggregateField(FCellChannelRegistry::Resolve<TStruct>(Name), FieldName);
+	}
+
+	FORCEINLINE bool AddAggregateField(const FName Name, const FName FieldName, UScriptStruct* Type)
+	{
+		return AddAggregateField(FCellChannelRegistry::Resolve(Name, Type), FieldName);
+	}
+
+	/**
+	 * Makes every chunk keep a summary of the numeric field over the cells holding the channel, see
+	 * FChunkChannelAggregate. Name_None keeps the count only. Returns false if the channel struct has
+	 * no numeric field with that name. Pooled chunks are dropped so new chunks pick the field up.
+	 */
+	bool AddAggregateField(const FCellChannelHandle Handle, const FName FieldName)
+	{
+		FChunkAggregateField Field;
+		if (!Handle.IsValid() ||
+			!FChunkAggregateField::Make(FCellChannelRegistry::Get().GetType(Handle), FieldName, Field))
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Warning, TEXT("No numeric field %s to aggregate."),
+			           *FieldName.ToString());
+			return false;
+		}
+
+		AggregateFields.Add(Handle, Field);
+		this->EmptyChunkPool();
+
+		for (TPair<FIntPoint, FChunkPtr>& Chunk : this->Chunks)
+		{
+			Chunk.Value->AddAggregateField(Handle, Field);
+		}
+
+		return true;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE FChunkChannelAggregate AggregateRegion(const FName Name, const FIntRect& InGridRegion)
+	{
+		return AggregateRegion(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridRegion);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE FChunkChannelAggregate AggregateRegion(const FName Name, const FIntRect& InGridRegion) const
+	{
+		return AggregateRegion(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InGridRegion);
+	}
+
+	FORCEINLINE FChunkChannelAggregate AggregateRegion(const FName Name, const FIntRect& InGridRegion,
+	                                                   UScriptStruct* Type)
+	{
+		return AggregateRegion(FCellChannelRegistry::Get().Find({Name, Type}), InGridRegion);
+	}
+
+	FORCEINLINE FChunkChannelAggregate AggregateRegion(const FName Name, const FIntRect& InGridRegion,
+	                                                   UScriptStruct* Type) const
+	{
+		return AggregateRegion(FCellChannelRegistry::Get().Find({Name, Type}), InGridRegion);
+	}
+
+	/**
+	 * Summary of the channel over the grid region, Max exclusive. Chunks inside the region use their kept
+	 * summary, rebuilding and keeping it if stale, only chunks on the border of the region are scanned.
+	 */
+	FChunkChannelAggregate AggregateRegion(const FCellChannelHandle Handle, const FIntRect& InGridRegion)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::AggregateRegion)
+
+		FChunkChannelAggregate Aggregate;
+		ForEachChannelChunkInRegion(Handle, InGridRegion,
+		                            [Handle, &InGridRegion, &Aggregate](const FIntPoint&, FChunk_DynamicData& Chunk)
+		{
+			Aggregate.Append(Chunk.AggregateRegion(Handle, InGridRegion));
+		});
+
+		return Aggregate;
+	}
+
+	/** Like the mutable overload but stale summaries are rebuilt without being kept, safe to call concurrently. */
+	FChunkChannelAggregate AggregateRegion(const FCellChannelHandle Handle, const FIntRect& InGridRegion) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::AggregateRegion)
+
+		FChunkChannelAggregate Aggregate;
+		ForEachChannelChunkInRegion(Handle, InGridRegion, [Handle, &InGridRegion, &Aggregate](
+			const FIntPoint&, const FChunk_DynamicData& Chunk)
+		{
+			Aggregate.Append(Chunk.AggregateRegion(Handle, InGridRegion));
+		});
+
+		return Aggregate;
+	}
+
+	// Nearest
+	// Distances are measured between cells in whole cells, like the radius queries.
+
+	template <typename TStruct>
+	FORCEINLINE FChunkNearestCell FindNearest(const FName Name, const FIntPoint& InOrigin) const
+	{
+		return FindNearest(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InOrigin);
+	}
+
+	FORCEINLINE FChunkNearestCell FindNearest(const FName Name, const FIntPoint& InOrigin, UScriptStruct* Type) const
+	{
+		return FindNearest(FCellChannelRegistry::Get().Find({Name, Type}), InOrigin);
+	}
+
+	FORCEINLINE FChunkNearestCell FindNearest(const FName Name, const FVector& InLocation, UScriptStruct* Type) const
+	{
+		return FindNearest(FCellChannelRegistry::Get().Find({Name, Type}), InLocation);
+	}
+
+	FORCEINLINE FChunkNearestCell FindNearest(const FCellChannelHandle Handle, const FVector& InLocation) const
+	{
+		return FindNearest(Handle, this->ConvertWorldToGridFunc(this->GetWorld(), InLocation));
+	}
+
+	/** Cell holding the channel nearest to InOrigin, invalid if no cell has it. */
+	FORCEINLINE FChunkNearestCell FindNearest(const FCellChannelHandle Handle, const FIntPoint& InOrigin) const
+	{
+		const TArray<FChunkNearestCell> Nearest = FindKNearest(Handle, InOrigin, 1);
+		return Nearest.IsEmpty() ? FChunkNearestCell() : Nearest[0];
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TArray<FChunkNearestCell> FindKNearest(const FName Name, const FIntPoint& InOrigin,
+	                                                   const int32 InCount) const
+	{
+		return FindKNearest(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}), InOrigin, InCount);
+	}
+
+	FORCEINLINE TArray<FChunkNearestCell> FindKNearest(const FName Name, const FIntPoint& InOrigin, const int32 InCount,
+	                                                   UScriptStruct* Type) const
+	{
+		return FindKNearest(FCellChannelRegistry::Get().Find({Name, Type}), InOrigin, InCount);
+	}
+
+	FORCEINLINE TArray<FChunkNearestCell> FindKNearest(const FName Name, const FVector& InLocation, const int32 InCount,
+	                                                   UScriptStruct* Type) const
+	{
+		return FindKNearest(FCellChannelRegistry::Get().Find({Name, Type}), InLocation, InCount);
+	}
+
+	FORCEINLINE TArray<FChunkNearestCell> FindKNearest(const FCellChannelHandle Handle, const FVector& InLocation,
+	                                                   const int32 InCount) const
+	{
+		return FindKNearest(Handle, this->ConvertWorldToGridFunc(this->GetWorld(), InLocation), InCount);
+	}
+
+	/**
+	 * Up to InCount cells holding the channel nearest to InOrigin, nearest first. Chunks are visited ring by
+	 * ring around the chunk of the origin and the search stops once the next ring cannot hold a nearer cell.
+	 * Rings only test chunks listed in the channel index, and once they would cover more chunks than the
+	 * index holds the remaining indexed chunks are scanned directly.
+	 */
+	TArray<FChunkNearestCell> FindKNearest(const FCellChannelHandle Handle, const FIntPoint& InOrigin,
+	                                       const int32 InCount) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::FindKNearest)
+
+		TArray<FChunkNearestCell> Heap;
+
+		const TSet<FIntPoint>* const Locations = ChannelIndex.Find(Handle);
+		if (!Locations || InCount <= 0)
+		{
+			return Heap;
+		}
+
+		const int32 Size = this->GetChunkSize();
+
+		// InCount may come straight from Blueprint, never reserve more than the indexed chunks can hold.
+		const int64 MaxCells = static_cast<int64>(Locations->Num()) * Size * Size;
+		Heap.Reserve(static_cast<int32>(FMath::Min<int64>(InCount, MaxCells)));
+
+		const FIntPoint Center = this->ConvertGlobalToChunkGrid(InOrigin);
+		const FIntPoint Local = this->ConvertGlobalToLocalCell(InOrigin);
+
+		// Cells of ring 1 are at least this far from the origin along one axis, each further ring adds a chunk.
+		const int64 EdgeDistance = FMath::Min(FMath::Min(Local.X, Size - 1 - Local.X),
+		                                      FMath::Min(Local.Y, Size - 1 - Local.Y)) + 1;
+
+		const auto Collect = [this, Handle, &InOrigin, InCount, &Heap](const FIntPoint& ChunkPoint)
+		{
+			FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+			if (ChunkPtr && ChunkPtr->IsValid())
+			{
+				(*ChunkPtr)->CollectNearest(Handle, InOrigin, InCount, Heap);
+			}
+		};
+
+		int64 NumRingChunks = 0;
+		for (int32 Ring = 0;; ++Ring)
+		{
+			const int64 RingDistance = Ring == 0 ? 0 : (Ring - 1) * static_cast<int64>(Size) + EdgeDistance;
+			if (RingDistance * RingDistance > ChunkNearest::GetWorstDistanceSquared(Heap, InCount))
+			{
+				break;
+			}
+
+			const int64 NumChunks = Ring == 0 ? 1 : 8 * static_cast<int64>(Ring);
+			if (NumRingChunks + NumChunks > Locations->Num())
+			{
+				for (const FIntPoint& ChunkPoint : *Locations)
+				{
+					const int64 ChunkDistance = FMath::Max(FMath::Abs(static_cast<int64>(ChunkPoint.X) - Center.X),
+					                                       FMath::Abs(static_cast<int64>(ChunkPoint.Y) - Center.Y));
+					if (ChunkDistance >= Ring)
+					{
+						Collect(ChunkPoint);
+					}
+				}
+
+				break;
+			}
+
+			NumRingChunks += NumChunks;
+
+			ForEachRingChunk(Center, Ring, [Locations, &Collect](const FIntPoint& ChunkPoint)
+			{
+				if (Locations->Contains(ChunkPoint))
+				{
+					Collect(ChunkPoint);
+				}
+			});
+		}
+
+		Heap.Sort();
+		return Heap;
+	}
+
+	// Components
+	template <typename TStruct>
+	FORCEINLINE FChunkChannelComponents LabelComponents(const FName Name) const
+	{
+		return LabelComponents(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+	}
+
+	FORCEINLINE FChunkChannelComponents LabelComponents(const FName Name, UScriptStruct* Type) const
+	{
+		return LabelComponents(FCellChannelRegistry::Get().Find({Name, Type}));
+	}
+
+	/**
+	 * Groups the cells holding the channel into 4-connected components. Chunks are labeled in parallel,
+	 * then the labels touching across chunk borders are merged. The system must not be modified meanwhile.
+	 */
+	FChunkChannelComponents LabelComponents(const FCellChannelHandle Handle) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::LabelComponents)
+
+		FChunkChannelComponents Components;
+		Components.ChunkSize = this->GetChunkSize();
+
+		const TSet<FIntPoint>* const Locations = ChannelIndex.Find(Handle);
+		if (!Locations)
+		{
+			return Components;
+		}
+
+		struct FChunkLabels
+		{
+			FIntPoint ChunkPoint;
+			const FChunk_DynamicData* Chunk = nullptr;
+			TArray<int32> Labels;
+			TArray<int32> Sizes;
+
+			/** First global label of the chunk. */
+			int32 Offset = 0;
+		};
+
+		TArray<FChunkLabels> Parts;
+		Parts.Reserve(Locations->Num());
+
+		for (const FIntPoint& ChunkPoint : *Locations)
+		{
+			FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+			if (ChunkPtr && ChunkPtr->IsValid())
+			{
+				FChunkLabels& Part = Parts.AddDefaulted_GetRef();
+				Part.ChunkPoint = ChunkPoint;
+				Part.Chunk = ChunkPtr->Get();
+			}
+		}
+
+		ParallelFor(Parts.Num(), [Handle, &Parts](const int32 Index)
+		{
+			FChunkLabels& Part = Parts[Index];
+			Part.Chunk->LabelComponents(Handle, Part.Labels, Part.Sizes);
+		});
+
+		TMap<FIntPoint, int32> PartIndices;
+		PartIndices.Reserve(Parts.Num());
+
+		int32 NumLabels = 0;
+		for (int32 Index = 0; Index < Parts.Num(); ++Index)
+		{
+			Parts[Index].Offset = NumLabels;
+			NumLabels += Parts[Index].Sizes.Num();
+			PartIndices.Add(Parts[Index].ChunkPoint, Index);
+		}
+
+		TArray<int32> Parents;
+		Parents.SetNumUninitialized(NumLabels);
+		for (int32 Label = 0; Label < NumLabels; ++Label)
+		{
+			Parents[Label] = Label;
+		}
+
+		// Joins the labels facing each other across the border at X + 1 and Y + 1 of every chunk.
+		const int32 Size = Components.ChunkSize;
+		for (const FChunkLabels& Part : Parts)
+		{
+			if (const int32* const NextIndex = PartIndices.Find(Part.ChunkPoint + FIntPoint(1, 0)))
+			{
+				const FChunkLabels& Next = Parts[*NextIndex];
+				for (int32 Y = 0; Y < Size; ++Y)
+				{
+					const int32 Label = Part.Labels[(Size - 1) * Size + Y];
+					const int32 NextLabel = Next.Labels[Y];
+					if (Label != INDEX_NONE && NextLabel != INDEX_NONE)
+					{
+						ChunkComponents::Union(Parents, Part.Offset + Label, Next.Offset + NextLabel);
+					}
+				}
+			}
+
+			if (const int32* const NextIndex = PartIndices.Find(Part.ChunkPoint + FIntPoint(0, 1)))
+			{
+				const FChunkLabels& Next = Parts[*NextIndex];
+				for (int32 X = 0; X < Size; ++X)
+				{
+					const int32 Label = Part.Labels[X * Size + Size - 1];
+					const int32 NextLabel = Next.Labels[X * Size];
+					if (Label != INDEX_NONE && NextLabel != INDEX_NONE)
+					{
+						ChunkComponents::Union(Parents, Part.Offset + Label, Next.Offset + NextLabel);
+					}
+				}
+			}
+		}
+
+		// Roots are the smallest label of their set, so they get their component before the rest of it.
+		TArray<int32> ComponentOfLabel;
+		ComponentOfLabel.SetNumUninitialized(NumLabels);
+		for (int32 Label = 0; Label < NumLabels; ++Label)
+		{
+			const int32 Root = ChunkComponents::FindRoot(Parents, Label);
+			ComponentOfLabel[Label] = Root == Label ? Components.Sizes.Add(0) : ComponentOfLabel[Root];
+		}
+
+		for (const FChunkLabels& Part : Parts)
+		{
+			for (int32 Label = 0; Label < Part.Sizes.Num(); ++Label)
+			{
+				Components.Sizes[ComponentOfLabel[Part.Offset + Label]] += Part.Sizes[Label];
+			}
+		}
+
+		ParallelFor(Parts.Num(), [&Parts, &ComponentOfLabel](const int32 Index)
+		{
+			FChunkLabels& Part = Parts[Index];
+			for (int32& Label : Part.Labels)
+			{
+				if (Label != INDEX_NONE)
+				{
+					Label = ComponentOfLabel[Part.Offset + Label];
+				}
+			}
+		});
+
+		Components.ChunkLabels.Reserve(Parts.Num());
+		for (FChunkLabels& Part : Parts)
+		{
+			Components.ChunkLabels.Add(Part.ChunkPoint, MoveTemp(Part.Labels));
+		}
+
+		return Components;
+	}
+
+	// Parallel queries
+	// Chunks holding the channel are split across the task graph with ParallelFor. The predicate is called
+	// concurrently with (const FIntPoint& Cell, const TStruct& Value) and must not modify the system.
+
+	template <typename TStruct, typename PredicateType>
+	FORCEINLINE TArray<FIntPoint> FilterChannel(const FName Name, PredicateType&& Predicate,
+	                                            const EParallelForFlags Flags = EParallelForFlags::None,
+	                                            const int32 MaxTasks = 0) const
+	{
+		return FilterChannel<TStruct>(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}),
+		                              Forward<PredicateType>(Predicate), Flags, MaxTasks);
+	}
+
+	/**
+	 * Cells holding the channel whose value passes the predicate. The result does not depend on the
+	 * scheduling: chunks are ordered by chunk point, cells by local index within their chunk.
+	 * MaxTasks caps the number of batches the chunks are split into and so the threads working on
+	 * them at once, 0 leaves it to ParallelFor.
+	 */
+	template <typename TStruct, typename PredicateType>
+	TArray<FIntPoint> FilterChannel(const FCellChannelHandle Handle, PredicateType&& Predicate,
+	                                const EParallelForFlags Flags = EParallelForFlags::None,
+	                                const int32 MaxTasks = 0) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::FilterChannel)
+
+		const TSet<FIntPoint>* const Locations = ChannelIndex.Find(Handle);
+		if (!Locations)
+		{
+			return TArray<FIntPoint>();
+		}
+
+		TArray<FIntPoint> ChunkPoints = Locations->Array();
+		ChunkPoints.Sort([](const FIntPoint& A, const FIntPoint& B)
+		{
+			return A.X != B.X ? A.X < B.X : A.Y < B.Y;
+		});
+
+		TArray<TArray<FIntPoint>> ChunkCells;
+		ChunkCells.SetNum(ChunkPoints.Num());
+
+		const int32 MinBatchSize = MaxTasks > 0 ? FMath::DivideAndRoundUp(ChunkPoints.Num(), MaxTasks) : 1;
+
+		ParallelFor(TEXT("TChunkSystem_DynamicData::FilterChannel"), ChunkPoints.Num(), MinBatchSize,
+		            [this, Handle, &Predicate, &ChunkPoints, &ChunkCells](const int32 Index)
+		{
+			FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoints[Index]);
+			if (!ChunkPtr || !ChunkPtr->IsValid())
+			{
+				return;
+			}
+
+			const FChunk_DynamicData& Chunk = **ChunkPtr;
+			for (const TPair<FIntPoint, const TStruct&> Cell : Chunk.template IterateChannel<TStruct>(Handle))
+			{
+				if (Predicate(Cell.Key, Cell.Value))
+				{
+					ChunkCells[Index].Add(Cell.Key);
+				}
+			}
+		}, Flags);
+
+		int32 NumCells = 0;
+		for (const TArray<FIntPoint>& Cells : ChunkCells)
+		{
+			NumCells += Cells.Num();
+		}
+
+		TArray<FIntPoint> Result;
+		Result.Reserve(NumCells);
+		for (const TArray<FIntPoint>& Cells : ChunkCells)
+		{
+			Result.Append(Cells);
+		}
+
+		return Result;
+	}
+
+	template <typename TStruct, typename PredicateType>
+	FORCEINLINE int32 CountChannelIf(const FName Name, PredicateType&& Predicate,
+	                                 const EParallelForFlags Flags = EParallelForFlags::None) const
+	{
+		return CountChannelIf<TStruct>(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}),
+		                               Forward<PredicateType>(Predicate), Flags);
+	}
+
+	/** Number of cells holding the channel whose value passes the predicate, counted like FilterChannel. */
+	template <typename TStruct, typename PredicateType>
+	int32 CountChannelIf(const FCellChannelHandle Handle, PredicateType&& Predicate,
+	                     const EParallelForFlags Flags = EParallelForFlags::None) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::CountChannelIf)
+
+		const TSet<FIntPoint>* const Locations = ChannelIndex.Find(Handle);
+		if (!Locations)
+		{
+			return 0;
+		}
+
+		const TArray<FIntPoint> ChunkPoints = Locations->Array();
+		std::atomic<int32> Count{0};
+
+		ParallelFor(ChunkPoints.Num(), [this, Handle, &Predicate, &ChunkPoints, &Count](const int32 Index)
+		{
+			FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoints[Index]);
+			if (!ChunkPtr || !ChunkPtr->IsValid())
+			{
+				return;
+			}
+
+			int32 ChunkCount = 0;
+			const FChunk_DynamicData& Chunk = **ChunkPtr;
+			for (const TPair<FIntPoint, const TStruct&> Cell : Chunk.template IterateChannel<TStruct>(Handle))
+			{
+				ChunkCount += Predicate(Cell.Key, Cell.Value) ? 1 : 0;
+			}
+
+			Count.fetch_add(ChunkCount, std::memory_order_relaxed);
+		}, Flags);
+
+		return Count.load();
+	}
+
+	template <typename TStruct, typename FuncType>
+	FORCEINLINE void ParallelForEachChannel(const FName Name, FuncType&& Func,
+	                                        const EParallelForFlags Flags = EParallelForFlags::None)
+	{
+		ParallelForEachChannel<TStruct>(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}),
+		                                Forward<FuncType>(Func), Flags);
+	}
+
+	/**
+	 * Calls Func(const FIntPoint& Cell, TStruct& Value) for every cell holding the channel, one task per
+	 * chunk. Func may write the value it is given and read anything, but must not add or remove channels
+	 * or chunks. The chunk directory is locked for the sweep, so adding or removing a chunk, or indexing
+	 * a chunk for a channel, fails a check.
+	 */
+	template <typename TStruct, typename FuncType>
+	void ParallelForEachChannel(const FCellChannelHandle Handle, FuncType&& Func,
+	                            const EParallelForFlags Flags = EParallelForFlags::None)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::ParallelForEachChannel)
+
+		const TSet<FIntPoint>* const Locations = ChannelIndex.Find(Handle);
+		if (!Locations)
+		{
+			return;
+		}
+
+		TArray<FChunk_DynamicData*> SweepChunks;
+		SweepChunks.Reserve(Locations->Num());
+		for (const FIntPoint& ChunkPoint : *Locations)
+		{
+			FChunkPtr* const ChunkPtr = this->Chunks.Find(ChunkPoint);
+			if (ChunkPtr && ChunkPtr->IsValid())
+			{
+				SweepChunks.Add(ChunkPtr->Get());
+			}
+		}
+
+		this->Chunks.Lock();
+
+		// Each task only touches the cells, and the aggregate flags, of its own chunk.
+		ParallelFor(SweepChunks.Num(), [Handle, &Func, &SweepChunks](const int32 Index)
+		{
+			for (const TPair<FIntPoint, TStruct&> Cell : SweepChunks[Index]->template IterateChannel<TStruct>(Handle))
+			{
+				Func(Cell.Key, Cell.Value);
+			}
+		}, Flags);
+
+		this->Chunks.Unlock();
+	}
+
+	// Columns
+	// Column channels are a separate store from the boxed channels above, keyed by (name, type). They
+	// are not visible to HasChannel, GetChannel, the channel masks and ChannelIndex, IterateChannel or
+	// the region, nearest, raycast, aggregate, filter and parallel queries, which only see boxed
+	// channels. A value written as a column is only reachable through the column functions below.
+	// Chunks holding a column are indexed separately in ColumnIndex so sweeps skip the other chunks.
+
+	template <typename TStruct>
+	FORCEINLINE TStruct& FindOrAddColumnValue(const FName Name, const FVector& InLocation)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_FindOrAddColumnValue)
+
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return FindOrAddColumnValue<TStruct>(Name, GridPoint);
+	}
+
+	/** The point must be inside of the chunk grid bounds, use TryFindOrAddColumnValue for points that may not be. */
+	template <typename TStruct>
+	FORCEINLINE TStruct& FindOrAddColumnValue(const FName Name, const FIntPoint& InGridPoint)
+	{
+		TStruct* const Value = TryFindOrAddColumnValue<TStruct>(Name, InGridPoint);
+		checkf(Value, TEXT("Cell %s is outside of the chunk grid bounds"), *InGridPoint.ToString());
+
+		return *Value;
+	}
+
+	FORCEINLINE FStructView FindOrAddColumnValue(const FName Name, const FIntPoint& InGridPoint, UScriptStruct* Type)
+	{
+		const FStructView Value = TryFindOrAddColumnValue(Name, InGridPoint, Type);
+		checkf(Value.IsValid(), TEXT("Cell %s is outside of the chunk grid bounds"), *InGridPoint.ToString());
+
+		return Value;
+	}
+
+	/** Like FindOrAddColumnValue but returns nullptr for points outside of the chunk grid bounds. */
+	template <typename TStruct>
+	FORCEINLINE TStruct* TryFindOrAddColumnValue(const FName Name, const FIntPoint& InGridPoint)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_FindOrAddColumnValue)
+
+		FIntPoint ChunkPoint;
+		FChunk_DynamicData* const Chunk = this->FindOrMakeChunkCached(InGridPoint, &ChunkPoint);
+		if (!Chunk)
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Warning, TEXT("Cell %s is outside of the chunk grid bounds."),
+			           *InGridPoint.ToString());
+			return nullptr;
+		}
+
+		ColumnIndex.FindOrAdd({Name, TStruct::StaticStruct()}).Add(ChunkPoint);
+		return &Chunk->template FindOrAddColumnValue<TStruct>(Name, InGridPoint);
+	}
+
+	/** Returns an empty view for points outside of the chunk grid bounds. */
+	FORCEINLINE FStructView TryFindOrAddColumnValue(const FName Name, const FIntPoint& InGridPoint, UScriptStruct* Type)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::FindOrAddColumnValue)
+
+		FIntPoint ChunkPoint;
+		FChunk_DynamicData* const Chunk = this->FindOrMakeChunkCached(InGridPoint, &ChunkPoint);
+		if (!Chunk)
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal_DynamicData, Warning, TEXT("Cell %s is outside of the chunk grid bounds."),
+			           *InGridPoint.ToString());
+			return FStructView();
+		}
+
+		ColumnIndex.FindOrAdd({Name, Type}).Add(ChunkPoint);
+		return Chunk->FindOrAddColumnValue(Name, InGridPoint, Type);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TStruct* FindColumnValue(const FName Name, const FIntPoint& InGridPoint)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_FindColumnValue)
+
+		FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridPoint);
+		if (!Chunk)
+		{
+			return nullptr;
+		}
+
+		return Chunk->template FindColumnValue<TStruct>(Name, InGridPoint);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE const TStruct* FindColumnValue(const FName Name, const FIntPoint& InGridPoint) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_FindColumnValue)
+
+		const FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridPoint);
+		if (!Chunk)
+		{
+			return nullptr;
+		}
+
+		return Chunk->template FindColumnValue<TStruct>(Name, InGridPoint);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool HasColumnValue(const FName Name, const FIntPoint& InGridPoint) const
+	{
+		const FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridPoint);
+		if (!Chunk)
+		{
+			return false;
+		}
+
+		return Chunk->template HasColumnValue<TStruct>(Name, InGridPoint);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool TryRemoveColumnValue(const FName Name, const FIntPoint& InGridPoint)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::Template_TryRemoveColumnValue)
+
+		FIntPoint ChunkPoint;
+		FChunk_DynamicData* const Chunk = this->FindChunkCached(InGridPoint, &ChunkPoint);
+		if (!Chunk || !Chunk->template TryRemoveColumnValue<TStruct>(Name, InGridPoint))
+		{
+			return false;
+		}
+
+		// The chunk drops a column with its last value.
+		const FCellChannelKey Key{Name, TStruct::StaticStruct()};
+		if (!Chunk->GetColumns().Contains(Key))
+		{
+			UnregisterColumnLocation(Key, ChunkPoint);
+		}
+
+		return true;
+	}
+
+	/**
+	 * Visits every value of the column in the chunks indexed for it. Func is called as
+	 * Func(const FIntPoint&, TStruct&) and must not add or remove column values.
+	 */
+	template <typename TStruct, typename FuncType>
+	void ForEachColumnValue(const FName Name, FuncType&& Func)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::ForEachColumnValue)
+
+		const TSet<FIntPoint>* const Locations = ColumnIndex.Find({Name, TStruct::StaticStruct()});
+		if (!Locations)
+		{
+			return;
+		}
+
+		for (const FIntPoint& ChunkPoint : *Locations)
+		{
+			FChunk_DynamicData& Chunk = *this->Chunks[ChunkPoint];
+			for (TPair<FIntPoint, TStruct&> Value : Chunk.template IterateColumn<TStruct>(Name))
+			{
+				Func(Value.Key, Value.Value);
+			}
+		}
+	}
+
+	template <typename TStruct, typename FuncType>
+	void ForEachColumnValue(const FName Name, FuncType&& Func) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_DynamicData::ForEachColumnValue)
+
+		const TSet<FIntPoint>* const Locations = ColumnIndex.Find({Name, TStruct::StaticStruct()});
+		if (!Locations)
+		{
+			return;
+		}
+
+		for (const FIntPoint& ChunkPoint : *Locations)
+		{
+			const FChunk_DynamicData& Chunk = *this->Chunks[ChunkPoint];
+			for (TPair<FIntPoint, const TStruct&> Value : Chunk.template IterateColumn<TStruct>(Name))
+			{
+				Func(Value.Key, Value.Value);
+			}
+		}
+	}
+
+	template <typename TStruct>
+	TSet<FIntPoint> const* FindChannelLocations(const FName Name) const
+	{
+		return FindChannelLocations(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+	}
+
+	TSet<FIntPoint> const* FindChannelLocations(const FName Name, UScriptStruct* Type) const
+	{
+		return FindChannelLocations(FCellChannelRegistry::Get().Find({Name, Type}));
+	}
+
+	/** Chunk points with at least one cell holding the channel. */
+	TSet<FIntPoint> const* FindChannelLocations(const FCellChannelHandle Handle) const
+	{
+		return ChannelIndex.Find(Handle);
+	}
+
+	template <typename TStruct>
+	TChannelIteratorRange<TStruct> IterateChannel(const FName Name)
+	{
+		return IterateChannel<TStruct>(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+	}
+
+	template <typename TStruct>
+	TConstChannelIteratorRange<TStruct> IterateChannel(const FName Name) const
+	{
+		return IterateChannel<TStruct>(FCellChannelRegistry::Get().Find({Name, TStruct::StaticStruct()}));
+	}
+
+	template <typename TStruct>
+	TChannelIteratorRange<TStruct> IterateChannel(const FCellChannelHandle Handle)
+	{
+		return TChannelIteratorRangeImpl<TStruct, false>(this, Handle);
+	}
+
+	template <typename TStruct>
+	TConstChannelIteratorRange<TStruct> IterateChannel(const FCellChannelHandle Handle) const
+	{
+		return TChannelIteratorRangeImpl<TStruct, true>(this, Handle);
+	}
+
+	FORCEINLINE virtual bool TryRemoveChunkByLocation(const FVector& InGlobalLocation) override
+	{
+		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGlobalLocation);
+		return TryRemoveChunkInternal(ChunkPoint);
+	}
+
+	FORCEINLINE virtual bool TryRemoveChunkByGrid(const FIntPoint& InGlobalGridLocation) override
+	{
+		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(InGlobalGridLocation);
+		return TryRemoveChunkInternal(ChunkPoint);
+	}
+
+	FORCEINLINE virtual void Empty(const int32 ExpectedNumElements = 0) override
+	{
+		Super::Empty(ExpectedNumElements);
+		RebuildChannelIndex(ExpectedNumElements);
+	}
+
+	FORCEINLINE const FChunkCellStorageSettings& GetStorageSettings() const
+	{
+		return StorageSettings;
+	}
+
+	// Debug
+	FORCEINLINE void DrawDebug(const TFunction<FVector(const FIntPoint&)>& InConvertor) const
+	{
+		for (const TPair<FIntPoint, FChunkPtr>& Chunk : this->Chunks)
+		{
+			Chunk.Value->DrawDebug(this->GetWorld(), InConvertor);
+		}
+	}
+
+protected:
+	virtual FChunkPtr MakeChunk(const FIntPoint& InTopLeft, const FIntPoint& InBottomRight) const override
+	{
+		FChunkPtr Chunk = MakeUnique<FChunk_DynamicData>(InTopLeft, InBottomRight, StorageSettings);
+
+		for (const TPair<FCellChannelHandle, FChunkAggregateField>& Field : AggregateFields)
+		{
+			Chunk->AddAggregateField(Field.Key, Field.Value);
+		}
+
+		return Chunk;
+	}
+
+private:
+	template <typename, bool>
 	friend class TChannelIteratorRangeImpl;
 
 	template <typename TStruct, bool bConst>
 	class TChannelIteratorRangeImpl
 	{
 		using OwnerType = std::conditional_t<bConst, const TChunkSystem_DynamicData*, TChunkSystem_DynamicData*>;
-		using StructRefType = std::conditional_t<bConst, const TStruct&, TStruct&>;
-
+		using ChunkRefType = std::conditional_t<bConst, const FChunk_DynamicData&, FChunk_DynamicData&>;
+		using FPerChunkRange = decltype(std::declval<ChunkRefType>().template IterateChannel<TStruct>(
+			FCellChannelHandle()));
+		using FPerChunkIterator = decltype(std::declval<FPerChunkRange>().begin());
+		using FReturnType = decltype(*std::declval<FPerChunkIterator>());
+
+		/**
+		 * Walks the chunk points of the channel index in place and the channel mask of one chunk at a time.
+		 * Holds no containers, so creating, copying and advancing it never allocates.
+		 */
 		class FIterator
 		{
-			using FReturnType = TPair<FIntPoint, StructRefType>;
-			using ChunkRefType = std::conditional_t<bConst, const FChunk_DynamicData&, FChunk_DynamicData&>;
-			using FPerChunkRange = decltype(std::declval<ChunkRefType>().template IterateChannel<TStruct>(FName()));
-			using FPerChunkIterator = decltype(std::declval<FPerChunkRange>().begin());
-
 		public:
 			FIterator() = default;
 
-			FIterator(OwnerType InOwner,
-			          const FCellChannelKey* InKey,
-			          const TSet<FIntPoint>* InChunkPoints,
-			          int32 InIndex)
+			FIterator(OwnerType InOwner, const FCellChannelHandle InHandle, const TSet<FIntPoint>* InLocations,
+			          const bool bInBegin)
 				: Owner(InOwner)
-				  , Key(InKey)
-				  , Index(0)
+				  , Handle(InHandle)
+				  , Locations(InLocations)
+				  , SetIndex(InLocations ? InLocations->GetMaxIndex() : 0)
 			{
-				if (!Owner || !Key || !InChunkPoints)
-				{
-					return;
-				}
-
-				PerChunkRanges.Reserve(InChunkPoints->Num());
-				PerChunkIterators.Reserve(InChunkPoints->Num());
-
-				for (const FIntPoint& ChunkPoint : *InChunkPoints)
+				if (bInBegin && Owner && Locations)
 				{
-					const TSharedPtr<FChunk_DynamicData, ESPMode::ThreadSafe>* const ChunkPtr =
-						Owner->Chunks.Find(ChunkPoint);
-					if (!ChunkPtr || !ChunkPtr->IsValid())
-					{
-						continue;
-					}
-
-					if constexpr (bConst)
-					{
-						const FChunk_DynamicData& ChunkRef = *ChunkPtr->Get();
-						PerChunkRanges.Emplace(ChunkRef.IterateChannel<TStruct>(Key->ChannelName));
-					}
-					else
-					{
-						FChunk_DynamicData& ChunkRef = *ChunkPtr->Get();
-						PerChunkRanges.Emplace(ChunkRef.IterateChannel<TStruct>(Key->ChannelName));
-					}
-
-					PerChunkIterators.Emplace(PerChunkRanges.Last().begin());
+					SetIndex = -1;
+					SkipToValid();
 				}
-
-				Index = FMath::Clamp(InIndex, 0, PerChunkIterators.Num());
-				SkipToValid();
 			}
 
 			FIterator& operator++()
 			{
-				if (Index >= PerChunkIterators.Num())
-				{
-					return *this;
-				}
-
-				++PerChunkIterators[Index];
-				if (!PerChunkIterators[Index].IsValid())
+				if (ChunkIterator.IsValid())
 				{
-					++Index;
+					++ChunkIterator;
 					SkipToValid();
 				}
 
@@ -710,7 +2315,8 @@ private:
 
 			bool operator==(const FIterator& Other) const
 			{
-				return Owner == Other.Owner && Key == Other.Key && Index == Other.Index;
+				return Locations == Other.Locations && SetIndex == Other.SetIndex &&
+					ChunkIterator == Other.ChunkIterator;
 			}
 
 			bool operator!=(const FIterator& Other) const
@@ -720,7 +2326,7 @@ private:
 
 			bool IsValid() const
 			{
-				return Index < PerChunkIterators.Num() && PerChunkIterators[Index].IsValid();
+				return ChunkIterator.IsValid();
 			}
 
 			explicit operator bool() const
@@ -730,75 +2336,91 @@ private:
 
 			FReturnType operator*() const
 			{
-				check(Owner && Key);
-				check(Index >= 0 && Index < PerChunkIterators.Num());
-				check(PerChunkIterators[Index].IsValid());
-				return *PerChunkIterators[Index];
+				check(Owner && Handle.IsValid());
+				check(ChunkIterator.IsValid());
+				return *ChunkIterator;
 			}
 
 		private:
+			/** Moves on to the next indexed chunk until a cell is found, ends in the same state as end(). */
 			void SkipToValid()
 			{
-				while (Index < PerChunkIterators.Num() && !PerChunkIterators[Index].IsValid())
+				const int32 MaxIndex = Locations->GetMaxIndex();
+				while (!ChunkIterator.IsValid())
 				{
-					++Index;
+					if (++SetIndex >= MaxIndex)
+					{
+						SetIndex = MaxIndex;
+						ChunkIterator = FPerChunkIterator();
+						return;
+					}
+
+					const FSetElementId Id = FSetElementId::FromInteger(SetIndex);
+					if (!Locations->IsValidId(Id))
+					{
+						continue;
+					}
+
+					const FChunkPtr* const ChunkPtr = Owner->Chunks.Find((*Locations)[Id]);
+					if (!ChunkPtr || !ChunkPtr->IsValid())
+					{
+						continue;
+					}
+
+					ChunkRefType ChunkRef = *ChunkPtr->Get();
+					ChunkIterator = ChunkRef.template IterateChannel<TStruct>(Handle).begin();
 				}
 			}
 
 		private:
 			OwnerType Owner = nullptr;
-			const FCellChannelKey* Key = nullptr;
-			TArray<FPerChunkRange> PerChunkRanges;
-			TArray<FPerChunkIterator> PerChunkIterators;
-			int32 Index = 0;
+			FCellChannelHandle Handle;
+			const TSet<FIntPoint>* Locations = nullptr;
+
+			/** Element index into Locations of the current chunk, GetMaxIndex() once done. */
+			int32 SetIndex = 0;
+			FPerChunkIterator ChunkIterator;
 		};
 
 	public:
-		TChannelIteratorRangeImpl(OwnerType InOwner, const FCellChannelKey& InKey)
+		/** Refers to the channel index of the system, which must not change while iterating. */
+		TChannelIteratorRangeImpl(OwnerType InOwner, const FCellChannelHandle InHandle)
 			: Owner(InOwner)
-			  , Key(InKey)
+			  , Handle(InHandle)
+			  , Locations(InOwner ? InOwner->FindChannelLocations(InHandle) : nullptr)
 		{
-			if (!Owner)
-			{
-				return;
-			}
-
-			if (TSet<FIntPoint> const* Found = Owner->FindChannelLocations(Key);
-				Found && !Found->IsEmpty())
-			{
-				Locations = *Found;
-			}
 		}
 
 		FIterator begin() const
 		{
-			return FIterator(Owner, &Key, &Locations, 0);
+			return FIterator(Owner, Handle, Locations, true);
 		}
 
 		FIterator end() const
 		{
-			return FIterator(Owner, &Key, &Locations, TNumericLimits<int32>::Max());
+			return FIterator(Owner, Handle, Locations, false);
 		}
 
 		bool IsEmpty() const
 		{
-			return Locations.Num() == 0;
+			return !Locations || Locations->IsEmpty();
 		}
 
+		/** Number of chunks holding the channel. */
 		int32 Num() const
 		{
-			return Locations.Num();
+			return Locations ? Locations->Num() : 0;
 		}
 
 	private:
 		OwnerType Owner = nullptr;
-		FCellChannelKey Key;
-		TSet<FIntPoint> Locations;
+		FCellChannelHandle Handle;
+		const TSet<FIntPoint>* Locations = nullptr;
 	};
 
 	bool TryRemoveChunkInternal(const FIntPoint& InChunkGridLocation)
 	{
-		if (TSharedPtr<FChunk_DynamicData, ESPMode::ThreadSafe>* const ChunkPtr = this->Chunks.
+		if (FChunkPtr* const ChunkPtr = this->Chunks.
 			Find(InChunkGridLocation))
 		{
 			if (ChunkPtr->IsValid())
@@ -814,79 +2436,296 @@ private:
 
 	void RemoveChunkFromChannelIndex(const FChunk_DynamicData& Chunk)
 	{
-		for (const TPair<FCellChannelKey, TSet<FIntPoint>>& Entry : Chunk.GetChannelIndex())
+		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(Chunk.GetTopLeft());
+		for (const TPair<FCellChannelHandle, FChunkCellMask>& Entry : Chunk.GetChannelMasks())
+		{
+			UnregisterChannelLocation(Entry.Key, ChunkPoint);
+		}
+
+		for (const TPair<FCellChannelKey, FChunkChannelColumn>& Entry : Chunk.GetColumns())
+		{
+			UnregisterColumnLocation(Entry.Key, ChunkPoint);
+		}
+	}
+
+	void UnregisterColumnLocation(const FCellChannelKey& Key, const FIntPoint& InChunkPoint)
+	{
+		if (TSet<FIntPoint>* Locations = ColumnIndex.Find(Key))
 		{
-			for (const FIntPoint& CellLocation : Entry.Value)
+			Locations->Remove(InChunkPoint);
+			if (Locations->IsEmpty())
 			{
-				const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(CellLocation);
-				UnregisterChannelLocation(Entry.Key, ChunkPoint);
+				ColumnIndex.Remove(Key);
 			}
 		}
 	}
 
-	void RegisterChannelLocation(const FCellChannelKey& Key, const FIntPoint& InChunkPoint)
+	void RegisterChannelLocation(const FCellChannelHandle Handle, const FIntPoint& InChunkPoint)
 	{
-		if (!Key.Type)
+		if (!Handle.IsValid())
 		{
 			return;
 		}
 
-		ChannelIndex.FindOrAdd(Key).Emplace(InChunkPoint);
+		checkf(!this->Chunks.IsLocked(), TEXT("Channel added to a new chunk during a parallel sweep"));
+
+		bool bAlreadyIndexed = false;
+		ChannelIndex.FindOrAdd(Handle).Emplace(InChunkPoint, &bAlreadyIndexed);
+
+		if (!bAlreadyIndexed)
+		{
+			++SuperchunkIndex.FindOrAdd(Handle).FindOrAdd(GetSuperchunk(InChunkPoint));
+		}
 	}
 
-	void UnregisterChannelLocation(const FCellChannelKey& Key, const FIntPoint& InChunkPoint)
+	void UnregisterChannelLocation(const FCellChannelHandle Handle, const FIntPoint& InChunkPoint)
 	{
-		if (!Key.Type)
+		if (!Handle.IsValid())
 		{
 			return;
 		}
 
-		if (TSet<FIntPoint>* Locations = FindChannelLocations(Key);
+		if (TSet<FIntPoint>* Locations = ChannelIndex.Find(Handle);
 			Locations && Locations->Contains(InChunkPoint))
 		{
+			checkf(!this->Chunks.IsLocked(), TEXT("Channel removed from a chunk during a parallel sweep"));
+
 			if (Locations->Num() - 1 == 0)
 			{
-				ChannelIndex.Remove(Key);
+				ChannelIndex.Remove(Handle);
+				SuperchunkIndex.Remove(Handle);
+				return;
+			}
+
+			Locations->Remove(InChunkPoint);
+
+			TMap<FIntPoint, int32>& Blocks = SuperchunkIndex.FindChecked(Handle);
+			const FIntPoint Block = GetSuperchunk(InChunkPoint);
+			if (--Blocks.FindChecked(Block) == 0)
+			{
+				Blocks.Remove(Block);
+			}
+		}
+	}
+
+	/** The chunk stays indexed for the channel while any of its cells still has it. */
+	void UnregisterChannelLocationIfUnused(const FCellChannelHandle Handle, const FIntPoint& InChunkPoint)
+	{
+		FChunkPtr const* ChunkPtr = this->Chunks.Find(InChunkPoint);
+		if (ChunkPtr && ChunkPtr->IsValid() && (*ChunkPtr)->HasAnyChannel(Handle))
+		{
+			return;
+		}
+
+		UnregisterChannelLocation(Handle, InChunkPoint);
+	}
+
+	/**
+	 * Calls Func(const FIntPoint& ChunkPoint, FChunk_DynamicData& Chunk) for every chunk overlapping the
+	 * grid region that holds the channel. Walks the chunks indexed for the channel when there are fewer
+	 * of them than chunks covering the region, otherwise only the superchunks holding the channel.
+	 */
+	template <typename FuncType>
+	void ForEachChannelChunkInRegion(const FCellChannelHandle Handle, const FIntRect& InGridRegion,
+	                                 FuncType&& Func) const
+	{
+		const TSet<FIntPoint>* const Locations = ChannelIndex.Find(Handle);
+		const FIntRect Range = this->GetChunkRangeOfRegion(InGridRegion);
+		if (!Locations || Range.Min.X >= Range.Max.X)
+		{
+			return;
+		}
+
+		const int64 NumRangeChunks = (static_cast<int64>(Range.Max.X) - Range.Min.X) *
+			(static_cast<int64>(Range.Max.Y) - Range.Min.Y);
+		if (Locations->Num() < NumRangeChunks)
+		{
+			for (const FIntPoint& ChunkPoint : *Locations)
+			{
+				if (!Range.Contains(ChunkPoint))
+				{
+					continue;
+				}
+
+				FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+				if (ChunkPtr && ChunkPtr->IsValid())
+				{
+					Func(ChunkPoint, **ChunkPtr);
+				}
+			}
+
+			return;
+		}
+
+		ForEachChannelSuperchunkInRange(Handle, Range, [this, Locations, &Func](const FIntRect& BlockChunks, const bool)
+		{
+			for (int32 X = BlockChunks.Min.X; X < BlockChunks.Max.X; ++X)
+			{
+				for (int32 Y = BlockChunks.Min.Y; Y < BlockChunks.Max.Y; ++Y)
+				{
+					const FIntPoint ChunkPoint(X, Y);
+					if (!Locations->Contains(ChunkPoint))
+					{
+						continue;
+					}
+
+					FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+					if (ChunkPtr && ChunkPtr->IsValid())
+					{
+						Func(ChunkPoint, **ChunkPtr);
+					}
+				}
+			}
+
+			return false;
+		});
+	}
+
+	static FORCEINLINE FIntPoint GetSuperchunk(const FIntPoint& InChunkPoint)
+	{
+		// Arithmetic shifts round toward negative infinity, like the chunk grid conversion.
+		return FIntPoint(InChunkPoint.X >> SuperchunkShift, InChunkPoint.Y >> SuperchunkShift);
+	}
+
+	/**
+	 * Calls Func(const FIntRect& BlockChunks, bool bWholeBlock) for every superchunk overlapping the chunk
+	 * range with a chunk indexed for the channel. BlockChunks is the superchunk clipped to the range and
+	 * bWholeBlock tells whether nothing was clipped. Stops and returns true once Func returns true.
+	 */
+	template <typename FuncType>
+	bool ForEachChannelSuperchunkInRange(const FCellChannelHandle Handle, const FIntRect& InChunkRange,
+	                                     FuncType&& Func) const
+	{
+		const TMap<FIntPoint, int32>* const Blocks = SuperchunkIndex.Find(Handle);
+		if (!Blocks || InChunkRange.Min.X >= InChunkRange.Max.X || InChunkRange.Min.Y >= InChunkRange.Max.Y)
+		{
+			return false;
+		}
+
+		const FIntRect BlockRange(GetSuperchunk(InChunkRange.Min),
+		                          GetSuperchunk(InChunkRange.Max - FIntPoint(1, 1)) + FIntPoint(1, 1));
+
+		const auto Visit = [&InChunkRange, &Func](const FIntPoint& Block)
+		{
+			const FIntPoint BlockMin = Block * SuperchunkSize;
+			const FIntRect BlockChunks(BlockMin.ComponentMax(InChunkRange.Min),
+			                           (BlockMin + FIntPoint(SuperchunkSize, SuperchunkSize)).ComponentMin(
+				                           InChunkRange.Max));
+
+			return Func(BlockChunks, BlockChunks.Area() == SuperchunkSize * SuperchunkSize);
+		};
+
+		const int64 NumRangeBlocks = (static_cast<int64>(BlockRange.Max.X) - BlockRange.Min.X) *
+			(static_cast<int64>(BlockRange.Max.Y) - BlockRange.Min.Y);
+		if (Blocks->Num() < NumRangeBlocks)
+		{
+			for (const TPair<FIntPoint, int32>& Block : *Blocks)
+			{
+				if (BlockRange.Contains(Block.Key) && Visit(Block.Key))
+				{
+					return true;
+				}
 			}
-			else
+
+			return false;
+		}
+
+		for (int32 X = BlockRange.Min.X; X < BlockRange.Max.X; ++X)
+		{
+			for (int32 Y = BlockRange.Min.Y; Y < BlockRange.Max.Y; ++Y)
 			{
-				Locations->Remove(InChunkPoint);
+				const FIntPoint Block(X, Y);
+				if (Blocks->Contains(Block) && Visit(Block))
+				{
+					return true;
+				}
 			}
 		}
+
+		return false;
 	}
 
-	TSet<FIntPoint> const* FindChannelLocations(const FCellChannelKey& Key) const
+	/** Calls Func(const FIntPoint& ChunkPoint) for the chunks at Chebyshev distance Ring from Center. */
+	template <typename FuncType>
+	static void ForEachRingChunk(const FIntPoint& Center, const int32 Ring, FuncType&& Func)
 	{
-		return ChannelIndex.Find(Key);
+		if (Ring == 0)
+		{
+			Func(Center);
+			return;
+		}
+
+		for (int32 X = Center.X - Ring; X <= Center.X + Ring; ++X)
+		{
+			Func(FIntPoint(X, Center.Y - Ring));
+			Func(FIntPoint(X, Center.Y + Ring));
+		}
+
+		for (int32 Y = Center.Y - Ring + 1; Y < Center.Y + Ring; ++Y)
+		{
+			Func(FIntPoint(Center.X - Ring, Y));
+			Func(FIntPoint(Center.X + Ring, Y));
+		}
 	}
 
-	TSet<FIntPoint>* FindChannelLocations(const FCellChannelKey& Key)
+	/** Chunk holding the current cell of the traversal. Absent chunks are skipped over and give null. */
+	const FChunk_DynamicData* FindChunkOnTraversal(FChunkGridTraversal& Traversal) const
 	{
-		return ChannelIndex.Find(Key);
+		const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(Traversal.GetCell());
+
+		FChunkPtr const* ChunkPtr = this->Chunks.Find(ChunkPoint);
+		if (ChunkPtr && ChunkPtr->IsValid())
+		{
+			return ChunkPtr->Get();
+		}
+
+		FIntPoint TopLeft, BottomRight;
+		this->GetChunkBounds(ChunkPoint, TopLeft, BottomRight);
+		Traversal.SkipBox(TopLeft, BottomRight);
+
+		return nullptr;
 	}
 
 	void RebuildChannelIndex(const int32 ExpectedNumElements = 0)
 	{
 		ChannelIndex.Empty(ExpectedNumElements);
+		SuperchunkIndex.Empty();
+		ColumnIndex.Empty();
 
-		for (const TPair<FIntPoint, TSharedPtr<FChunk_DynamicData>>& ChunkPair : this->Chunks)
+		for (const TPair<FIntPoint, FChunkPtr>& ChunkPair : this->Chunks)
 		{
 			if (!ChunkPair.Value.IsValid())
 			{
 				continue;
 			}
 
-			for (const TPair<FCellChannelKey, TSet<FIntPoint>>& Entry : ChunkPair.Value->GetChannelIndex())
+			for (const TPair<FCellChannelHandle, FChunkCellMask>& Entry : ChunkPair.Value->GetChannelMasks())
 			{
-				for (const FIntPoint& Location : Entry.Value)
-				{
-					const FIntPoint ChunkPoint = this->ConvertGlobalToChunkGrid(Location);
-					RegisterChannelLocation(Entry.Key, ChunkPoint);
-				}
+				RegisterChannelLocation(Entry.Key, ChunkPair.Key);
+			}
+
+			for (const TPair<FCellChannelKey, FChunkChannelColumn>& Entry : ChunkPair.Value->GetColumns())
+			{
+				ColumnIndex.FindOrAdd(Entry.Key).Add(ChunkPair.Key);
 			}
 		}
 	}
 
 private:
-	TMap<FCellChannelKey, TSet<FIntPoint>> ChannelIndex;
+	FChunkCellStorageSettings StorageSettings;
+
+	TMap<FCellChannelHandle, TSet<FIntPoint>> ChannelIndex;
+
+	/** Superchunks are SuperchunkSize x SuperchunkSize chunks, the level above ChannelIndex. */
+	static constexpr int32 SuperchunkShift = 3;
+	static constexpr int32 SuperchunkSize = 1 << SuperchunkShift;
+
+	/** Number of chunks indexed for the channel in each superchunk, superchunks without any are absent. */
+	TMap<FCellChannelHandle, TMap<FIntPoint, int32>> SuperchunkIndex;
+
+	/** Chunks holding values of each column, columns are not part of ChannelIndex. */
+	TMap<FCellChannelKey, TSet<FIntPoint>> ColumnIndex;
+
+	/** Fields every chunk keeps a summary of, per channel. */
+	TMap<FCellChannelHandle, FChunkAggregateField> AggregateFields;
 };
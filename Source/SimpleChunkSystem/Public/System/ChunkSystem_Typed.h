@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ChunkSystem.h"
+#include "Chunk/Chunk_Typed.h"
+
+/**
+ * Chunk system for channel types known at compile time.
+ *
+ * Sibling of TChunkSystem_DynamicData with the same chunk and coordinate
+ * semantics, but every channel is a plain typed array inside the chunk and
+ * is addressed by its type instead of a name and UScriptStruct.
+ *
+ * @tparam TStructs Channel types, each type may appear once.
+ */
+template <typename... TStructs>
+class TChunkSystem_Typed final : public TChunkSystemBase<TChunk_Typed<TStructs...>>
+{
+	using Super = TChunkSystemBase<TChunk_Typed<TStructs...>>;
+	using FChunkType = TChunk_Typed<TStructs...>;
+	using FChunkPtr = typename Super::FChunkPtr;
+
+public:
+	explicit TChunkSystem_Typed(const UObject* InWorldContext, const int32 InChunkSize = 15)
+		: Super(InWorldContext, InChunkSize)
+	{
+	}
+
+public:
+	template <typename TStruct>
+	FORCEINLINE TStruct& FindOrAddChannel(const FVector& InLocation)
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return FindOrAddChannel<TStruct>(GridPoint);
+	}
+
+	/** The point must be inside of the chunk grid bounds, use TryFindOrAddChannel for points that may not be. */
+	template <typename TStruct>
+	FORCEINLINE TStruct& FindOrAddChannel(const FIntPoint& InGridPoint)
+	{
+		TStruct* const Value = TryFindOrAddChannel<TStruct>(InGridPoint);
+		checkf(Value, TEXT("Cell %s is outside of the chunk grid bounds"), *InGridPoint.ToString());
+
+		return *Value;
+	}
+
+	/** Like FindOrAddChannel but returns nullptr for points outside of the chunk grid bounds. */
+	template <typename TStruct>
+	FORCEINLINE TStruct* TryFindOrAddChannel(const FIntPoint& InGridPoint)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_Typed::FindOrAddChannel)
+
+		FChunkType* const Chunk = this->FindOrMakeChunkCached(InGridPoint);
+		if (!Chunk)
+		{
+			SCHUNK_LOG(LogSChunkSystemLocal, Warning, TEXT("Cell %s is outside of the chunk grid bounds."),
+			           *InGridPoint.ToString());
+			return nullptr;
+		}
+
+		return &Chunk->template FindOrAdd<TStruct>(InGridPoint);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TStruct* GetChannel(const FVector& InLocation)
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return GetChannel<TStruct>(GridPoint);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE TStruct* GetChannel(const FIntPoint& InGridPoint)
+	{
+		FChunkType* const Chunk = this->FindChunkCached(InGridPoint);
+		return Chunk ? Chunk->template Find<TStruct>(InGridPoint) : nullptr;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE const TStruct* GetChannel(const FIntPoint& InGridPoint) const
+	{
+		const FChunkType* const Chunk = this->FindChunkCached(InGridPoint);
+		return Chunk ? Chunk->template Find<TStruct>(InGridPoint) : nullptr;
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool HasChannel(const FVector& InLocation) const
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return HasChannel<TStruct>(GridPoint);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool HasChannel(const FIntPoint& InGridPoint) const
+	{
+		const FChunkType* const Chunk = this->FindChunkCached(InGridPoint);
+		return Chunk && Chunk->template Contains<TStruct>(InGridPoint);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool TryRemoveChannel(const FVector& InLocation)
+	{
+		const FIntPoint GridPoint = this->ConvertWorldToGridFunc(this->GetWorld(), InLocation);
+		return TryRemoveChannel<TStruct>(GridPoint);
+	}
+
+	template <typename TStruct>
+	FORCEINLINE bool TryRemoveChannel(const FIntPoint& InGridPoint)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_Typed::TryRemoveChannel)
+
+		FChunkType* const Chunk = this->FindChunkCached(InGridPoint);
+		return Chunk && Chunk->template Remove<TStruct>(InGridPoint);
+	}
+
+	/** Calls Func(const FIntPoint&, TStruct&) for every cell holding the channel. */
+	template <typename TStruct, typename FuncType>
+	void ForEachChannel(FuncType&& Func)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_Typed::ForEachChannel)
+
+		for (TPair<FIntPoint, FChunkPtr>& Chunk : this->Chunks)
+		{
+			Chunk.Value->template ForEach<TStruct>(Func);
+		}
+	}
+
+	template <typename TStruct, typename FuncType>
+	void ForEachChannel(FuncType&& Func) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TChunkSystem_Typed::ForEachChannel)
+
+		for (const TPair<FIntPoint, FChunkPtr>& Chunk : this->Chunks)
+		{
+			AsConst(*Chunk.Value).template ForEach<TStruct>(Func);
+		}
+	}
+
+	/** Number of cells holding the channel over all chunks. */
+	template <typename TStruct>
+	int32 NumChannels() const
+	{
+		int32 Count = 0;
+		for (const TPair<FIntPoint, FChunkPtr>& Chunk : this->Chunks)
+		{
+			Count += Chunk.Value->template Num<TStruct>();
+		}
+
+		return Count;
+	}
+
+	/** Chunk at the grid point, for batching several accesses to the same chunk. */
+	FORCEINLINE FChunkType* FindChunkByGrid(const FIntPoint& InGridPoint)
+	{
+		return this->FindChunkCached(InGridPoint);
+	}
+};
@@ -9,6 +9,7 @@ struct SIMPLECHUNKSYSTEM_API FData_UnitTest : public FCellBaseInfo
 {
 	GENERATED_BODY()
 
+	UPROPERTY()
 	int32 Value = 0;
 
 	virtual bool Serialize(FArchive& Ar) override
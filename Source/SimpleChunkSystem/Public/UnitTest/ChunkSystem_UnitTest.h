@@ -10,6 +10,7 @@
 #include "Subsystem/ChunkSubsystem.h"
 #include "Subsystem/ChunkSubsystemEvents.h"
 #include "System/ChunkSystem_DynamicData.h"
+#include "System/ChunkSystem_Typed.h"
 
 namespace ChunkSubsystemUnitTest
 {
@@ -18,6 +19,45 @@ namespace ChunkSubsystemUnitTest
 		return FName(*FString::Printf(
 			TEXT("ChunkSubsystemUnitTest_%s_%s"), *Suffix, *FGuid::NewGuid().ToString(EGuidFormats::Digits)));
 	}
+
+	template <typename ChannelType>
+	static FCellChannelHandle MakeUniqueChannel(const FString& Suffix)
+	{
+		return TChunkSystem_DynamicData<>::ResolveChannel<ChannelType>(MakeUniqueKey(Suffix));
+	}
+
+	// First world of the engine, the failed check is reported on the test.
+	static const UWorld* FindTestWorld(FAutomationTestBase& Test)
+	{
+		Test.TestNotNull(TEXT("GEngine is valid"), GEngine);
+		if (!GEngine)
+		{
+			return nullptr;
+		}
+
+		const TIndirectArray<FWorldContext>& Contexts = GEngine->GetWorldContexts();
+		Test.TestTrue(TEXT("Contexts are valid"), !Contexts.IsEmpty());
+		if (Contexts.IsEmpty())
+		{
+			return nullptr;
+		}
+
+		const UWorld* World = Contexts[0].World();
+		Test.TestNotNull(TEXT("World is valid"), World);
+		return World;
+	}
+
+	// Empty system on the test world, null when there is no world to create it for.
+	template <typename SystemType = TChunkSystem_DynamicData<>>
+	static TUniquePtr<SystemType> MakeTestSystem(FAutomationTestBase& Test, const int32 ChunkSize)
+	{
+		const UWorld* World = FindTestWorld(Test);
+		if (!World)
+		{
+			return nullptr;
+		}
+		return MakeUnique<SystemType>(World, ChunkSize);
+	}
 }
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_DivFloorTest,
@@ -61,6 +101,280 @@ FORCEINLINE bool FChunk_DivFloorTest::RunTest(const FString& Parameters)
 
 	delete ChunkSystem;
 
+	// The compile time power of two path must agree with the division path.
+	using FStaticSystem = TChunkSystemBase<FChunk_DynamicData, true,
+	                                       UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToGrid, 8>;
+	const FStaticSystem* StaticSystem = new FStaticSystem(World, 8);
+	const TChunkSystemBase<FChunk_DynamicData>* RuntimeSystem = new TChunkSystemBase<FChunk_DynamicData>(World, 8);
+
+	TestEqual(TEXT("Static chunk size"), StaticSystem->GetChunkSize(), 8);
+
+	bool bMatches = true;
+	for (int32 Value = -40; Value <= 40; ++Value)
+	{
+		const FIntPoint Point(Value, -Value * 3);
+		bMatches &= StaticSystem->ConvertGlobalToChunkGrid(Point) == RuntimeSystem->ConvertGlobalToChunkGrid(Point);
+		bMatches &= StaticSystem->ConvertGlobalToLocalCell(Point) == RuntimeSystem->ConvertGlobalToLocalCell(Point);
+
+		FIntPoint StaticTL, StaticBR, RuntimeTL, RuntimeBR;
+		StaticSystem->GetChunkBounds(Point, StaticTL, StaticBR);
+		RuntimeSystem->GetChunkBounds(Point, RuntimeTL, RuntimeBR);
+		bMatches &= StaticTL == RuntimeTL && StaticBR == RuntimeBR;
+	}
+	TestTrue(TEXT("Shift and mask match floor division"), bMatches);
+	TestEqual(TEXT("-1 >> 3"), StaticSystem->ConvertGlobalToChunkGrid(FIntPoint(-1, -9)), FIntPoint(-1, -2));
+	TestEqual(TEXT("-1 & 7"), StaticSystem->ConvertGlobalToLocalCell(FIntPoint(-1, -9)), FIntPoint(7, 7));
+
+	delete StaticSystem;
+	delete RuntimeSystem;
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSizeBenchmarkTest,
+                                 "SimpleChunkSystem.Benchmark.ChunkSize",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+FORCEINLINE bool FChunk_ChunkSizeBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const UWorld* World = ChunkSubsystemUnitTest::FindTestWorld(*this);
+	if (!World)
+	{
+		return false;
+	}
+
+	constexpr int32 ChunkSize = 16;
+	constexpr int32 NumPoints = 1 << 20;
+	constexpr int32 NumPasses = 8;
+
+	using FStaticSystem = TChunkSystemBase<FChunk_DynamicData, true,
+	                                       UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToGrid, ChunkSize>;
+	const FStaticSystem StaticSystem(World, ChunkSize);
+	const TChunkSystemBase<FChunk_DynamicData> RuntimeSystem(World, ChunkSize);
+
+	FRandomStream Random(1337);
+	TArray<FIntPoint> Points;
+	Points.SetNumUninitialized(NumPoints);
+	for (FIntPoint& Point : Points)
+	{
+		Point = FIntPoint(Random.RandRange(-100000, 100000), Random.RandRange(-100000, 100000));
+	}
+
+	// Chunk, local cell and chunk bounds per point, the sum keeps the work from being optimized away.
+	const auto Run = [&Points](const auto& System, int64& OutChecksum)
+	{
+		const double Start = FPlatformTime::Seconds();
+
+		int64 Checksum = 0;
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (const FIntPoint& Point : Points)
+			{
+				const FIntPoint Chunk = System.ConvertGlobalToChunkGrid(Point);
+				const FIntPoint Local = System.ConvertGlobalToLocalCell(Point);
+
+				FIntPoint TopLeft, BottomRight;
+				System.GetChunkBounds(Chunk, TopLeft, BottomRight);
+
+				Checksum += Chunk.X + Chunk.Y + Local.X + Local.Y + TopLeft.X + BottomRight.Y;
+			}
+		}
+
+		OutChecksum = Checksum;
+		return (FPlatformTime::Seconds() - Start) * 1000.0;
+	};
+
+	int64 RuntimeChecksum = 0;
+	int64 StaticChecksum = 0;
+	const double RuntimeMs = Run(RuntimeSystem, RuntimeChecksum);
+	const double StaticMs = Run(StaticSystem, StaticChecksum);
+
+	TestEqual(TEXT("Both paths compute the same coordinates"), StaticChecksum, RuntimeChecksum);
+
+	AddInfo(FString::Printf(TEXT("Runtime chunk size: %.2f ms, compile time chunk size: %.2f ms, speedup %.2fx"),
+	                        RuntimeMs, StaticMs, StaticMs > 0.0 ? RuntimeMs / StaticMs : 0.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkDirectoryTest,
+                                 "SimpleChunkSystem.System.ChunkDirectory",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkDirectoryTest::RunTest(const FString& Parameters)
+{
+	TChunkDirectory<int32> Directory;
+
+	const FChunkHandle A = Directory.Emplace(FIntPoint(0, 0), 10);
+	const FChunkHandle B = Directory.Emplace(FIntPoint(1, 0), 20);
+	const FChunkHandle C = Directory.Emplace(FIntPoint(-1, 5), 30);
+
+	TestEqual(TEXT("Directory size"), Directory.Num(), 3);
+	TestTrue(TEXT("Handle lookup"), Directory.Find(B) && *Directory.Find(B) == 20);
+	TestTrue(TEXT("Point lookup matches handle"), Directory.FindHandle(FIntPoint(-1, 5)) == C);
+	TestFalse(TEXT("Missing point has no handle"), Directory.FindHandle(FIntPoint(7, 7)).IsSet());
+
+	// Removing the first entry swaps the last one into its place, handles keep resolving.
+	TestTrue(TEXT("Removed entry"), Directory.Remove(FIntPoint(0, 0)));
+	TestFalse(TEXT("Removed handle is stale"), Directory.IsValid(A));
+	TestNull(TEXT("Stale handle resolves to nothing"), Directory.Find(A));
+	TestTrue(TEXT("Moved entry keeps its handle"), Directory.Find(C) && *Directory.Find(C) == 30);
+	TestTrue(TEXT("Moved entry keeps its point"), Directory.FindPoint(C) && *Directory.FindPoint(C) == FIntPoint(-1, 5));
+
+	// The freed slot is reused with a new generation.
+	const FChunkHandle D = Directory.Emplace(FIntPoint(0, 0), 40);
+	TestEqual(TEXT("Slot is reused"), D.GetIndex(), A.GetIndex());
+	TestTrue(TEXT("Reused slot does not revive the old handle"), !Directory.IsValid(A) && Directory.IsValid(D));
+
+	int32 Sum = 0;
+	for (const TPair<FIntPoint, int32>& Entry : Directory)
+	{
+		TestEqual(TEXT("Iterated entry resolves by point"), *Directory.Find(Entry.Key), Entry.Value);
+		Sum += Entry.Value;
+	}
+	TestEqual(TEXT("Iteration visits every entry"), Sum, 90);
+
+	Directory.Empty();
+	TestTrue(TEXT("Empty directory"), Directory.IsEmpty());
+	TestFalse(TEXT("Empty invalidates handles"), Directory.IsValid(B) || Directory.IsValid(C) || Directory.IsValid(D));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkPointTableTest,
+                                 "SimpleChunkSystem.System.ChunkPointTable",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkPointTableTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Morton interleaves X into even bits"),
+	         ChunkDirectory::MortonEncode(FIntPoint(1, 0)) - ChunkDirectory::MortonEncode(FIntPoint(0, 0)) == 1);
+	TestTrue(TEXT("Morton interleaves Y into odd bits"),
+	         ChunkDirectory::MortonEncode(FIntPoint(0, 1)) - ChunkDirectory::MortonEncode(FIntPoint(0, 0)) == 2);
+	TestTrue(TEXT("Negative coordinates order first"),
+	         ChunkDirectory::MortonEncode(FIntPoint(-1, -1)) < ChunkDirectory::MortonEncode(FIntPoint(0, 0)));
+	TestTrue(TEXT("Packed key round trips"),
+	         ChunkDirectory::UnpackPoint(ChunkDirectory::PackPoint(FIntPoint(-7, MAX_int32))) == FIntPoint(-7, MAX_int32));
+
+	// A dense block around the origin plus a far away diagonal exercises growth and collisions.
+	FChunkPointTable Table;
+	TArray<FIntPoint> Points;
+	for (int32 X = -32; X < 32; ++X)
+	{
+		for (int32 Y = -32; Y < 32; ++Y)
+		{
+			Points.Add(FIntPoint(X, Y));
+		}
+	}
+	for (int32 Index = 0; Index < 256; ++Index)
+	{
+		Points.Add(FIntPoint(100000 + Index * 37, -250000 + Index * 91));
+	}
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		Table.Add(Points[Index], Index);
+	}
+
+	TestEqual(TEXT("Table size"), Table.Num(), Points.Num());
+	TestTrue(TEXT("Probe sequences stay short"), Table.GetMaxProbeLength() <= 16);
+
+	bool bAllFound = true;
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		const int32* const Value = Table.Find(Points[Index]);
+		bAllFound &= Value && *Value == Index;
+	}
+	TestTrue(TEXT("Every point resolves to its value"), bAllFound);
+
+	// Remove every other point, the remaining ones must still be reachable after back shifting.
+	bool bRemovedAll = true;
+	for (int32 Index = 0; Index < Points.Num(); Index += 2)
+	{
+		int32 Removed = INDEX_NONE;
+		bRemovedAll &= Table.RemoveAndCopyValue(Points[Index], Removed) && Removed == Index;
+	}
+	TestTrue(TEXT("Removal returns the stored value"), bRemovedAll);
+
+	bool bConsistent = true;
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		const int32* const Value = Table.Find(Points[Index]);
+		bConsistent &= Index % 2 == 0 ? Value == nullptr : Value && *Value == Index;
+	}
+	TestTrue(TEXT("Lookups stay consistent after removal"), bConsistent);
+
+	int32 Dummy;
+	TestFalse(TEXT("Removing a missing point fails"), Table.RemoveAndCopyValue(FIntPoint(0, 0), Dummy));
+
+	Table.Shrink();
+	TestTrue(TEXT("Lookups survive shrinking"), Table.Find(Points[1]) && *Table.Find(Points[1]) == 1);
+
+	// Structured layouts must not pile up in the home buckets of their neighbours.
+	const auto MaxProbeOf = [](const TArray<FIntPoint>& Layout)
+	{
+		FChunkPointTable LayoutTable;
+		for (int32 Index = 0; Index < Layout.Num(); ++Index)
+		{
+			LayoutTable.Add(Layout[Index], Index);
+		}
+		return LayoutTable.GetMaxProbeLength();
+	};
+
+	TArray<FIntPoint> Strip;
+	for (int32 X = 0; X < 4096; ++X)
+	{
+		Strip.Add(FIntPoint(X, 0));
+	}
+	TestTrue(TEXT("Horizontal strip probes stay short"), MaxProbeOf(Strip) <= 16);
+
+	Strip.Reset();
+	for (int32 Y = 0; Y < 4096; ++Y)
+	{
+		Strip.Add(FIntPoint(0, Y));
+	}
+	TestTrue(TEXT("Vertical strip probes stay short"), MaxProbeOf(Strip) <= 16);
+
+	Strip.Reset();
+	for (int32 X = 0; X < 8192; ++X)
+	{
+		Strip.Add(FIntPoint(X, 0));
+		Strip.Add(FIntPoint(X, 1));
+	}
+	TestTrue(TEXT("Wide strip probes stay short"), MaxProbeOf(Strip) <= 16);
+
+	TArray<FIntPoint> Clusters;
+	for (int32 Cluster = 0; Cluster < 4; ++Cluster)
+	{
+		for (int32 X = 0; X < 16; ++X)
+		{
+			for (int32 Y = 0; Y < 16; ++Y)
+			{
+				Clusters.Add(FIntPoint((Cluster % 2) * 256 + X, (Cluster / 2) * 256 + Y));
+			}
+		}
+	}
+	TestTrue(TEXT("Clustered probes stay short"), MaxProbeOf(Clusters) <= 16);
+
+	// Sorting the directory orders iteration along the Z curve and keeps handles.
+	TChunkDirectory<int32> Directory;
+	const FChunkHandle Far = Directory.Emplace(FIntPoint(5, 5), 1);
+	Directory.Emplace(FIntPoint(0, 1), 2);
+	Directory.Emplace(FIntPoint(-1, -1), 3);
+	Directory.Emplace(FIntPoint(1, 0), 4);
+	Directory.SortByMortonOrder();
+
+	uint64 Previous = 0;
+	bool bSorted = true;
+	for (const TPair<FIntPoint, int32>& Entry : Directory)
+	{
+		const uint64 Code = ChunkDirectory::MortonEncode(Entry.Key);
+		bSorted &= Code >= Previous;
+		Previous = Code;
+	}
+	TestTrue(TEXT("Directory iterates in Morton order"), bSorted);
+	TestTrue(TEXT("Handles survive sorting"), Directory.Find(Far) && *Directory.Find(Far) == 1);
+	TestTrue(TEXT("Points survive sorting"), Directory.Find(FIntPoint(1, 0)) && *Directory.Find(FIntPoint(1, 0)) == 4);
+
 	return true;
 }
 
@@ -139,120 +453,451 @@ FORCEINLINE bool FChunk_DynamicData_CustomBoundsTest::RunTest(const FString& Par
 	return bWideChunkValid && bTallChunkValid;
 }
 
-IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_DynamicDataTest,
-                                 "SimpleChunkSystem.System.DynamicDataTest",
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_DynamicData_CellStorageTest,
+                                 "SimpleChunkSystem.Chunk.DynamicData.CellStorage",
                                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 
-FORCEINLINE bool FChunk_ChunkSystem_DynamicDataTest::RunTest(const FString& Parameters)
+FORCEINLINE bool FChunk_DynamicData_CellStorageTest::RunTest(const FString& Parameters)
 {
-	TestNotNull(TEXT("GEngine is valid"), GEngine);
-	if (!GEngine)
-	{
-		return false;
-	}
+	const FIntPoint TopLeft(-4, 3);
+	const FIntPoint BottomRight(2, 7);
+	const FName ChannelName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("CellStorage_Channel"));
 
-	const TIndirectArray<FWorldContext>& Contexts = GEngine->GetWorldContexts();
-	TestTrue(TEXT("Contexts are valid"), !Contexts.IsEmpty());
-	if (Contexts.IsEmpty())
+	const TArray<FIntPoint> Cells = {TopLeft, BottomRight, FIntPoint(0, 5), FIntPoint(-4, 7), FIntPoint(2, 3)};
+
+	for (const EChunkCellStorage Storage : {
+		     EChunkCellStorage::Map, EChunkCellStorage::Dense, EChunkCellStorage::Adaptive
+	     })
 	{
-		return false;
+		const FString StorageName = UEnum::GetValueAsString(Storage);
+
+		FChunkCellStorageSettings Settings;
+		Settings.Storage = Storage;
+
+		FChunk_DynamicData Chunk(TopLeft, BottomRight, Settings);
+
+		for (int32 Index = 0; Index < Cells.Num(); ++Index)
+		{
+			Chunk.FindOrAddChannel<FData_UnitTest>(ChannelName, Cells[Index]).GetMutablePtr<FData_UnitTest>()->Value =
+				Index + 1;
+		}
+
+		for (int32 Index = 0; Index < Cells.Num(); ++Index)
+		{
+			const FInstancedStruct* Struct = Chunk.FindChannel<FData_UnitTest>(ChannelName, Cells[Index]);
+			TestNotNull(*FString::Printf(TEXT("%s: value stored"), *StorageName), Struct);
+			if (Struct)
+			{
+				TestEqual(*FString::Printf(TEXT("%s: value matches"), *StorageName),
+				          Struct->GetPtr<FData_UnitTest>()->Value, Index + 1);
+			}
+		}
+
+		TestFalse(*FString::Printf(TEXT("%s: out of bounds cell has no channel"), *StorageName),
+		          Chunk.HasChannel<FData_UnitTest>(ChannelName, BottomRight + FIntPoint(1, 0)));
+		TestNull(*FString::Printf(TEXT("%s: out of bounds cell is not found"), *StorageName),
+		         Chunk.FindChannel<FData_UnitTest>(ChannelName, TopLeft - FIntPoint(0, 1)));
+		TestFalse(*FString::Printf(TEXT("%s: out of bounds removal fails"), *StorageName),
+		          Chunk.TryRemoveChannel<FData_UnitTest>(ChannelName, TopLeft - FIntPoint(1, 1)));
+
+		TestTrue(*FString::Printf(TEXT("%s: removal succeeds"), *StorageName),
+		         Chunk.TryRemoveChannel<FData_UnitTest>(ChannelName, Cells[0]));
+
+		TArray<uint8> Serialized;
+		{
+			FMemoryWriter Writer(Serialized, true);
+			Chunk.Serialize(Writer);
+		}
+
+		FChunk_DynamicData Loaded(FIntPoint::ZeroValue, FIntPoint::ZeroValue, Settings);
+		{
+			FMemoryReader Reader(Serialized, true);
+			Loaded.Serialize(Reader);
+		}
+
+		int32 Count = 0;
+		for (const auto Entry : Loaded.IterateChannel<FData_UnitTest>(ChannelName))
+		{
+			const int32 ExpectedIndex = Cells.IndexOfByKey(Entry.Key);
+			TestTrue(*FString::Printf(TEXT("%s: loaded cell is expected"), *StorageName), ExpectedIndex > 0);
+			TestEqual(*FString::Printf(TEXT("%s: loaded value matches"), *StorageName), Entry.Value.Value,
+			          ExpectedIndex + 1);
+			++Count;
+		}
+
+		TestEqual(*FString::Printf(TEXT("%s: loaded cell count"), *StorageName), Count, Cells.Num() - 1);
 	}
 
-	const UWorld* World = Contexts[0].World();
-	TestNotNull(TEXT("World is valid"), World);
-	if (!World)
 	{
-		return false;
+		FChunkCellStorageSettings Settings;
+		Settings.Storage = EChunkCellStorage::Adaptive;
+		Settings.PromoteOccupancy = 0.5f;
+		Settings.DemoteOccupancy = 0.25f;
+
+		// 4x4 chunk: promotes past 8 occupied cells, demotes below 4.
+		FChunk_DynamicData Chunk(FIntPoint(0, 0), FIntPoint(3, 3), Settings);
+		TestFalse(TEXT("Adaptive chunk starts sparse"), Chunk.IsDense());
+
+		TArray<FIntPoint> Written;
+		for (int32 X = 0; X < 4; ++X)
+		{
+			for (int32 Y = 0; Y < 3; ++Y)
+			{
+				Chunk.FindOrAddChannel<FData_UnitTest>(ChannelName, FIntPoint(X, Y)).GetMutablePtr<FData_UnitTest>()->
+				      Value = X * 10 + Y;
+				Written.Add(FIntPoint(X, Y));
+			}
+		}
+
+		TestEqual(TEXT("Adaptive chunk tracks occupied cells"), Chunk.GetNumOccupiedCells(), Written.Num());
+		TestTrue(TEXT("Adaptive chunk promoted past threshold"), Chunk.IsDense());
+
+		while (Written.Num() > 3)
+		{
+			const FIntPoint Cell = Written.Pop();
+			TestTrue(TEXT("Adaptive chunk removes cell"), Chunk.TryRemoveChannel<FData_UnitTest>(ChannelName, Cell));
+		}
+
+		TestFalse(TEXT("Adaptive chunk demoted below threshold"), Chunk.IsDense());
+
+		for (const FIntPoint& Cell : Written)
+		{
+			const FInstancedStruct* Struct = Chunk.FindChannel<FData_UnitTest>(ChannelName, Cell);
+			TestNotNull(TEXT("Adaptive chunk keeps values across layout changes"), Struct);
+			if (Struct)
+			{
+				TestEqual(TEXT("Adaptive chunk value survives layout changes"),
+				          Struct->GetPtr<FData_UnitTest>()->Value, Cell.X * 10 + Cell.Y);
+			}
+		}
 	}
 
-	constexpr int32 ChunkSize = 7;
-	TChunkSystem_DynamicData<>* ChunkSystem = new TChunkSystem_DynamicData(World, ChunkSize);
-	TestTrue(TEXT("ChunkSystem is valid"), ChunkSystem != nullptr);
+	return true;
+}
 
-	const FVector TestChannel_Location = FVector(1000, 2000, 3000);
-	const FName TestChannel_ChannelName = TEXT("TestChannel");
-	constexpr int32 TestChannel_Value = 42;
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_DynamicData_ColumnTest,
+                                 "SimpleChunkSystem.Chunk.DynamicData.Column",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_DynamicData_ColumnTest::RunTest(const FString& Parameters)
+{
+	const FIntPoint TopLeft(-2, -2);
+	const FIntPoint BottomRight(2, 2);
+	const FName ColumnName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("Column_Channel"));
+	const FName ArrayColumnName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("Column_Array"));
+
+	const TArray<FIntPoint> Cells = {FIntPoint(2, 2), FIntPoint(-2, -2), FIntPoint(0, 1), FIntPoint(1, -2)};
 
+	FChunk_DynamicData Chunk(TopLeft, BottomRight);
+
+	for (int32 Index = 0; Index < Cells.Num(); ++Index)
 	{
-		ChunkSystem->FindOrAddChannel<FData_UnitTest>(TestChannel_ChannelName, TestChannel_Location).GetMutablePtr<
-			FData_UnitTest>()->Value = TestChannel_Value;
+		Chunk.FindOrAddColumnValue<FData_UnitTest>(ColumnName, Cells[Index]).Value = Index + 1;
+		Chunk.FindOrAddColumnValue<FDataArray_UnitTest>(ArrayColumnName, Cells[Index]).Values.Init(Index, Index + 1);
 	}
 
-	const FVector TestChannel2_Location = FVector(2000, 3000, 4000);
-	const FName TestChannel2_ChannelName = TEXT("TestChannel2");
-	constexpr int32 TestChannel2_Value = 84;
-	constexpr int32 TestChannel2_Value2 = 168;
+	TestFalse(TEXT("Column values are not boxed channels"), Chunk.HasChannel<FData_UnitTest>(ColumnName, Cells[0]));
+	TestTrue(TEXT("Column value exists"), Chunk.HasColumnValue<FData_UnitTest>(ColumnName, Cells[0]));
+	TestFalse(TEXT("Column value is per type"), Chunk.HasColumnValue<FData2_UnitTest>(ColumnName, Cells[0]));
+	TestNull(TEXT("Out of bounds column value is not found"),
+	         Chunk.FindColumnValue<FData_UnitTest>(ColumnName, BottomRight + FIntPoint(1, 1)));
 
+	// Iteration follows local cell order, not insertion order.
+	TArray<FIntPoint> Visited;
+	for (const TPair<FIntPoint, const FData_UnitTest&> Entry : AsConst(Chunk).IterateColumn<FData_UnitTest>(
+		     ColumnName))
 	{
-		FInstancedStruct& Data_2 = ChunkSystem->FindOrAddChannel<FData2_UnitTest>(TestChannel2_ChannelName,
-			TestChannel2_Location);
-		FData2_UnitTest* Data_2_Ptr = Data_2.GetMutablePtr<FData2_UnitTest>();
-		Data_2_Ptr->Value = TestChannel2_Value;
-		Data_2_Ptr->Value2 = TestChannel2_Value2;
+		TestEqual(TEXT("Iterated column value matches"), Entry.Value.Value, Cells.IndexOfByKey(Entry.Key) + 1);
+		Visited.Add(Entry.Key);
 	}
 
-	const FIntPoint TestChannel3_Location = FIntPoint(44, 20);
-	const FName TestChannel3_ChannelName = TEXT("TestChannel3");
-	const FString TestChannel3_Name = TEXT("TestName");
-	const FName TestChannel3_Name2 = TEXT("TestName2");
+	TestEqual(TEXT("Column iterates all values"), Visited.Num(), Cells.Num());
+	TestTrue(TEXT("Column iterates in cell order"), Visited.Num() == 4 && Visited[0] == FIntPoint(-2, -2) &&
+	         Visited[1] == FIntPoint(0, 1) && Visited[2] == FIntPoint(1, -2) && Visited[3] == FIntPoint(2, 2));
 
+	TestTrue(TEXT("Column value removed"), Chunk.TryRemoveColumnValue<FDataArray_UnitTest>(ArrayColumnName, Cells[0]));
+	TestFalse(TEXT("Column value removed once"),
+	          Chunk.TryRemoveColumnValue<FDataArray_UnitTest>(ArrayColumnName, Cells[0]));
+
+	const FChunk_DynamicData Copy = Chunk;
+	const FDataArray_UnitTest* CopiedArray = Copy.FindColumnValue<FDataArray_UnitTest>(ArrayColumnName, Cells[3]);
+	TestTrue(TEXT("Copied column owns its values"), CopiedArray && CopiedArray->Values.Num() == 4 &&
+	         CopiedArray != Chunk.FindColumnValue<FDataArray_UnitTest>(ArrayColumnName, Cells[3]));
+
+	TArray<uint8> Serialized;
 	{
-		FInstancedStruct& Data_3 = ChunkSystem->FindOrAddChannel<FData3_UnitTest>(TestChannel3_ChannelName,
-			TestChannel3_Location);
-		FData3_UnitTest* Data_3_Ptr = Data_3.GetMutablePtr<FData3_UnitTest>();
-		Data_3_Ptr->Name = TestChannel3_Name;
-		Data_3_Ptr->Name2 = TestChannel3_Name2;
+		FMemoryWriter Writer(Serialized, true);
+		Chunk.Serialize(Writer);
 	}
 
-	TestTrue(TEXT("Has Channel FData_UnitTest"),
-	         ChunkSystem->HasChannel<FData_UnitTest>(TestChannel_ChannelName, TestChannel_Location));
-	TestTrue(TEXT("Has Channel FData2_UnitTest"),
-	         ChunkSystem->HasChannel<FData2_UnitTest>(TestChannel2_ChannelName, TestChannel2_Location));
-	TestTrue(TEXT("Has Channel FData3_UnitTest"),
-	         ChunkSystem->HasChannel<FData3_UnitTest>(TestChannel3_ChannelName, TestChannel3_Location));
-
+	FChunk_DynamicData Loaded(FIntPoint::ZeroValue, FIntPoint::ZeroValue);
 	{
-		FInstancedStruct& Data = ChunkSystem->FindOrAddChannel<FData_UnitTest>(TestChannel_ChannelName,
-		                                                                       TestChannel_Location);
-		const FData_UnitTest* Data_Ptr = Data.GetPtr<FData_UnitTest>();
-		TestEqual(TEXT("Data Value"), Data_Ptr->Value, TestChannel_Value);
+		FMemoryReader Reader(Serialized, true);
+		Loaded.Serialize(Reader);
 	}
 
+	TestEqual(TEXT("Loaded columns"), Loaded.GetColumns().Num(), 2);
+	for (int32 Index = 0; Index < Cells.Num(); ++Index)
 	{
-		FInstancedStruct& Data_2 = ChunkSystem->FindOrAddChannel<FData2_UnitTest>(TestChannel2_ChannelName,
-			TestChannel2_Location);
-		const FData2_UnitTest* Data_2_Ptr = Data_2.GetPtr<FData2_UnitTest>();
-		TestEqual(TEXT("Data_2 Value"), Data_2_Ptr->Value, TestChannel2_Value);
-		TestEqual(TEXT("Data_2 Value2"), Data_2_Ptr->Value2, TestChannel2_Value2);
+		const FData_UnitTest* Value = Loaded.FindColumnValue<FData_UnitTest>(ColumnName, Cells[Index]);
+		TestTrue(TEXT("Loaded column value matches"), Value && Value->Value == Index + 1);
+
+		const FDataArray_UnitTest* Array = Loaded.FindColumnValue<FDataArray_UnitTest>(ArrayColumnName, Cells[Index]);
+		TestEqual(TEXT("Loaded array column value"), Array ? Array->Values.Num() : 0, Index == 0 ? 0 : Index + 1);
 	}
 
+	for (const FIntPoint& Cell : Cells)
 	{
-		FInstancedStruct& Data_3 = ChunkSystem->FindOrAddChannel<FData3_UnitTest>(TestChannel3_ChannelName,
-			TestChannel3_Location);
-		const FData3_UnitTest* Data_3_Ptr = Data_3.GetPtr<FData3_UnitTest>();
-		TestEqual(TEXT("Data_3 Name"), Data_3_Ptr->Name, TestChannel3_Name);
-		TestEqual(TEXT("Data_3 Name2"), Data_3_Ptr->Name2, TestChannel3_Name2);
+		Loaded.TryRemoveColumnValue<FData_UnitTest>(ColumnName, Cell);
 	}
 
-	TestTrue(TEXT("Delete Channel FData_UnitTest"),
-	         ChunkSystem->TryRemoveChannel<FData_UnitTest>(TestChannel_ChannelName, TestChannel_Location));
-	TestFalse(TEXT("Has Channel FData_UnitTest after deletion"),
-	          ChunkSystem->HasChannel<FData_UnitTest>(TestChannel_ChannelName, TestChannel_Location));
+	TestEqual(TEXT("Empty column is dropped"), Loaded.GetColumns().Num(), 1);
 
-	TestTrue(TEXT("Delete Channel FData2_UnitTest"),
-	         ChunkSystem->TryRemoveChannel<FData2_UnitTest>(TestChannel2_ChannelName, TestChannel2_Location));
-	TestFalse(TEXT("Has Channel FData2_UnitTest after deletion"),
-	          ChunkSystem->HasChannel<FData2_UnitTest>(TestChannel2_ChannelName, TestChannel2_Location));
+	return true;
+}
 
-	TestTrue(TEXT("Delete Channel FData3_UnitTest"),
-	         ChunkSystem->TryRemoveChannel<FData3_UnitTest>(TestChannel3_ChannelName, TestChannel3_Location));
-	TestFalse(TEXT("Has Channel FData3_UnitTest after deletion"),
-	          ChunkSystem->HasChannel<FData3_UnitTest>(TestChannel3_ChannelName, TestChannel3_Location));
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_DynamicData_BaselineLayoutTest,
+                                 "SimpleChunkSystem.Chunk.DynamicData.BaselineLayout",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
 
-	const FIntPoint TestCase4_Location = FIntPoint(20, 20);
-	const FName TestCase4_ChannelName = TEXT("TestCase4_1");
-	const FName TestCase4_ChannelName2 = TEXT("TestCase4_2");
-	const FName TestCase4_ChannelName3 = TEXT("TestCase4_3");
+bool FChunk_DynamicData_BaselineLayoutTest::RunTest(const FString& Parameters)
+{
+	const FName ChannelName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("BaselineLayout"));
+	const FIntPoint Cells[] = {FIntPoint(0, 0), FIntPoint(2, 3)};
+	constexpr int32 NumChunks = UE_ARRAY_COUNT(Cells);
+
+	// Chunks back to back in the layout written before the save version marker and columns.
+	TArray<uint8> Bytes;
+	{
+		FMemoryWriter Writer(Bytes, true);
+		for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+		{
+			FIntPoint TopLeft(ChunkIndex * 4, 0);
+			FIntPoint BottomRight = TopLeft + FIntPoint(3, 3);
+			Writer << TopLeft;
+			Writer << BottomRight;
+
+			int32 Count = 1;
+			Writer << Count;
+
+			FIntPoint CellPoint = TopLeft + Cells[ChunkIndex];
+			Writer << CellPoint;
+
+			FCellDynamicInfo Cell;
+			Cell.GetOrAddChannel<FData_UnitTest>(ChannelName).GetMutablePtr<FData_UnitTest>()->Value = ChunkIndex + 1;
+			Cell.Serialize(Writer);
+		}
+	}
+
+	FMemoryReader Reader(Bytes, true);
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		FChunk_DynamicData Loaded(FIntPoint::ZeroValue, FIntPoint::ZeroValue);
+		Loaded.Serialize(Reader);
+
+		TestFalse(TEXT("Baseline chunk loads without errors"), Reader.IsError());
+		TestEqual(TEXT("Baseline chunk bounds"), Loaded.GetTopLeft(), FIntPoint(ChunkIndex * 4, 0));
+		TestTrue(TEXT("Baseline chunk has no columns"), Loaded.GetColumns().IsEmpty());
+
+		const FInstancedStruct* Struct = AsConst(Loaded).FindChannel<FData_UnitTest>(
+			ChannelName, Loaded.GetTopLeft() + Cells[ChunkIndex]);
+		const FData_UnitTest* Value = Struct ? Struct->GetPtr<FData_UnitTest>() : nullptr;
+		TestTrue(TEXT("Baseline cell value matches"), Value && Value->Value == ChunkIndex + 1);
+	}
+
+	TestTrue(TEXT("Baseline stream is read to its end"), Reader.AtEnd());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_CellDynamicInfo_InlineChannelsTest,
+                                 "SimpleChunkSystem.Chunk.DynamicData.InlineChannels",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_CellDynamicInfo_InlineChannelsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumChannels = FCellDynamicInfo::InlineCapacity + 2;
+
+	TArray<FName> Names;
+	for (int32 Index = 0; Index < NumChannels; ++Index)
+	{
+		Names.Add(ChunkSubsystemUnitTest::MakeUniqueKey(FString::Printf(TEXT("Inline_%d"), Index)));
+	}
+
+	FCellDynamicInfo Cell;
+	for (int32 Index = 0; Index < FCellDynamicInfo::InlineCapacity; ++Index)
+	{
+		Cell.GetOrAddChannel<FData_UnitTest>(Names[Index]).GetMutablePtr<FData_UnitTest>()->Value = Index;
+	}
+
+	TestFalse(TEXT("Cell within inline capacity is not spilled"), Cell.IsSpilled());
+	TestEqual(TEXT("Existing channel is reused"),
+	          Cell.GetOrAddChannel<FData_UnitTest>(Names[0]).GetPtr<FData_UnitTest>()->Value, 0);
+	TestFalse(TEXT("Channel is per type"), Cell.HasChannel<FData2_UnitTest>(Names[0]));
+
+	for (int32 Index = FCellDynamicInfo::InlineCapacity; Index < NumChannels; ++Index)
+	{
+		Cell.GetOrAddChannel<FData_UnitTest>(Names[Index]).GetMutablePtr<FData_UnitTest>()->Value = Index;
+	}
+
+	TestTrue(TEXT("Cell past inline capacity is spilled"), Cell.IsSpilled());
+	TestEqual(TEXT("Spilled cell keeps all channels"), Cell.Num(), NumChannels);
+
+	const FCellDynamicInfo Copy = Cell;
+	TestTrue(TEXT("Removed spilled channel"), Cell.RemoveChannel<FData_UnitTest>(Names[1]));
+	TestFalse(TEXT("Removed channel is gone"), Cell.HasChannel<FData_UnitTest>(Names[1]));
+	TestTrue(TEXT("Copy is independent"), Copy.HasChannel<FData_UnitTest>(Names[1]));
+
+	TArray<uint8> Serialized;
+	{
+		FMemoryWriter Writer(Serialized, true);
+		Cell.Serialize(Writer);
+	}
+
+	FCellDynamicInfo Loaded;
+	{
+		FMemoryReader Reader(Serialized, true);
+		Loaded.Serialize(Reader);
+	}
+
+	TestEqual(TEXT("Loaded channel count"), Loaded.Num(), NumChannels - 1);
+	for (int32 Index = 0; Index < NumChannels; ++Index)
+	{
+		const FInstancedStruct* Struct = Loaded.FindChannel<FData_UnitTest>(Names[Index]);
+		if (Index == 1)
+		{
+			TestNull(TEXT("Removed channel is not loaded"), Struct);
+			continue;
+		}
+
+		TestTrue(TEXT("Loaded channel value"), Struct && Struct->GetPtr<FData_UnitTest>()->Value == Index);
+	}
+
+	FCellDynamicInfo Small;
+	Small.GetOrAddChannel<FData_UnitTest>(Names[0]);
+	Small.GetOrAddChannel<FData2_UnitTest>(Names[0]);
+	TestTrue(TEXT("Inline channel removed"), Small.RemoveChannel<FData_UnitTest>(Names[0]));
+	TestFalse(TEXT("Inline channel removed once"), Small.RemoveChannel<FData_UnitTest>(Names[0]));
+	TestTrue(TEXT("Other inline channel kept"), Small.HasChannel<FData2_UnitTest>(Names[0]));
+	TestTrue(TEXT("Empty after last removal"), Small.RemoveChannel<FData2_UnitTest>(Names[0]) && Small.IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_DynamicDataTest,
+                                 "SimpleChunkSystem.System.DynamicDataTest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_DynamicDataTest::RunTest(const FString& Parameters)
+{
+	TestNotNull(TEXT("GEngine is valid"), GEngine);
+	if (!GEngine)
+	{
+		return false;
+	}
+
+	const TIndirectArray<FWorldContext>& Contexts = GEngine->GetWorldContexts();
+	TestTrue(TEXT("Contexts are valid"), !Contexts.IsEmpty());
+	if (Contexts.IsEmpty())
+	{
+		return false;
+	}
+
+	const UWorld* World = Contexts[0].World();
+	TestNotNull(TEXT("World is valid"), World);
+	if (!World)
+	{
+		return false;
+	}
+
+	constexpr int32 ChunkSize = 7;
+	TChunkSystem_DynamicData<>* ChunkSystem = new TChunkSystem_DynamicData(World, ChunkSize);
+	TestTrue(TEXT("ChunkSystem is valid"), ChunkSystem != nullptr);
+
+	const FVector TestChannel_Location = FVector(1000, 2000, 3000);
+	const FName TestChannel_ChannelName = TEXT("TestChannel");
+	constexpr int32 TestChannel_Value = 42;
+
+	{
+		ChunkSystem->FindOrAddChannel<FData_UnitTest>(TestChannel_ChannelName, TestChannel_Location).GetMutablePtr<
+			FData_UnitTest>()->Value = TestChannel_Value;
+	}
+
+	const FVector TestChannel2_Location = FVector(2000, 3000, 4000);
+	const FName TestChannel2_ChannelName = TEXT("TestChannel2");
+	constexpr int32 TestChannel2_Value = 84;
+	constexpr int32 TestChannel2_Value2 = 168;
+
+	{
+		FInstancedStruct& Data_2 = ChunkSystem->FindOrAddChannel<FData2_UnitTest>(TestChannel2_ChannelName,
+			TestChannel2_Location);
+		FData2_UnitTest* Data_2_Ptr = Data_2.GetMutablePtr<FData2_UnitTest>();
+		Data_2_Ptr->Value = TestChannel2_Value;
+		Data_2_Ptr->Value2 = TestChannel2_Value2;
+	}
+
+	const FIntPoint TestChannel3_Location = FIntPoint(44, 20);
+	const FName TestChannel3_ChannelName = TEXT("TestChannel3");
+	const FString TestChannel3_Name = TEXT("TestName");
+	const FName TestChannel3_Name2 = TEXT("TestName2");
+
+	{
+		FInstancedStruct& Data_3 = ChunkSystem->FindOrAddChannel<FData3_UnitTest>(TestChannel3_ChannelName,
+			TestChannel3_Location);
+		FData3_UnitTest* Data_3_Ptr = Data_3.GetMutablePtr<FData3_UnitTest>();
+		Data_3_Ptr->Name = TestChannel3_Name;
+		Data_3_Ptr->Name2 = TestChannel3_Name2;
+	}
+
+	TestTrue(TEXT("Has Channel FData_UnitTest"),
+	         ChunkSystem->HasChannel<FData_UnitTest>(TestChannel_ChannelName, TestChannel_Location));
+	TestTrue(TEXT("Has Channel FData2_UnitTest"),
+	         ChunkSystem->HasChannel<FData2_UnitTest>(TestChannel2_ChannelName, TestChannel2_Location));
+	TestTrue(TEXT("Has Channel FData3_UnitTest"),
+	         ChunkSystem->HasChannel<FData3_UnitTest>(TestChannel3_ChannelName, TestChannel3_Location));
+
+	{
+		FInstancedStruct& Data = ChunkSystem->FindOrAddChannel<FData_UnitTest>(TestChannel_ChannelName,
+		                                                                       TestChannel_Location);
+		const FData_UnitTest* Data_Ptr = Data.GetPtr<FData_UnitTest>();
+		TestEqual(TEXT("Data Value"), Data_Ptr->Value, TestChannel_Value);
+	}
+
+	{
+		FInstancedStruct& Data_2 = ChunkSystem->FindOrAddChannel<FData2_UnitTest>(TestChannel2_ChannelName,
+			TestChannel2_Location);
+		const FData2_UnitTest* Data_2_Ptr = Data_2.GetPtr<FData2_UnitTest>();
+		TestEqual(TEXT("Data_2 Value"), Data_2_Ptr->Value, TestChannel2_Value);
+		TestEqual(TEXT("Data_2 Value2"), Data_2_Ptr->Value2, TestChannel2_Value2);
+	}
+
+	{
+		FInstancedStruct& Data_3 = ChunkSystem->FindOrAddChannel<FData3_UnitTest>(TestChannel3_ChannelName,
+			TestChannel3_Location);
+		const FData3_UnitTest* Data_3_Ptr = Data_3.GetPtr<FData3_UnitTest>();
+		TestEqual(TEXT("Data_3 Name"), Data_3_Ptr->Name, TestChannel3_Name);
+		TestEqual(TEXT("Data_3 Name2"), Data_3_Ptr->Name2, TestChannel3_Name2);
+	}
+
+	TestTrue(TEXT("Delete Channel FData_UnitTest"),
+	         ChunkSystem->TryRemoveChannel<FData_UnitTest>(TestChannel_ChannelName, TestChannel_Location));
+	TestFalse(TEXT("Has Channel FData_UnitTest after deletion"),
+	          ChunkSystem->HasChannel<FData_UnitTest>(TestChannel_ChannelName, TestChannel_Location));
+
+	TestTrue(TEXT("Delete Channel FData2_UnitTest"),
+	         ChunkSystem->TryRemoveChannel<FData2_UnitTest>(TestChannel2_ChannelName, TestChannel2_Location));
+	TestFalse(TEXT("Has Channel FData2_UnitTest after deletion"),
+	          ChunkSystem->HasChannel<FData2_UnitTest>(TestChannel2_ChannelName, TestChannel2_Location));
+
+	TestTrue(TEXT("Delete Channel FData3_UnitTest"),
+	         ChunkSystem->TryRemoveChannel<FData3_UnitTest>(TestChannel3_ChannelName, TestChannel3_Location));
+	TestFalse(TEXT("Has Channel FData3_UnitTest after deletion"),
+	          ChunkSystem->HasChannel<FData3_UnitTest>(TestChannel3_ChannelName, TestChannel3_Location));
+
+	const FIntPoint TestCase4_Location = FIntPoint(20, 20);
+	const FName TestCase4_ChannelName = TEXT("TestCase4_1");
+	const FName TestCase4_ChannelName2 = TEXT("TestCase4_2");
+	const FName TestCase4_ChannelName3 = TEXT("TestCase4_3");
 
 	{
 		FInstancedStruct& Data_4 = ChunkSystem->FindOrAddChannel<FData_UnitTest>(TestCase4_ChannelName,
@@ -370,7 +1015,7 @@ FORCEINLINE bool FChunk_ChunkSystem_DynamicDataTest::RunTest(const FString& Para
 
 	{
 		const FIntPoint TargetChunk = ChunkSystem->ConvertGlobalToChunkGrid(TestCase4_Location);
-		TSharedPtr<FChunk_DynamicData, ESPMode::ThreadSafe>* const ChunkPtr = ChunkSystem->Chunks.Find(TargetChunk);
+		TUniquePtr<FChunk_DynamicData>* const ChunkPtr = ChunkSystem->Chunks.Find(TargetChunk);
 		TestNotNull(TEXT("Chunk exists for iterator test"), ChunkPtr ? ChunkPtr->Get() : nullptr);
 
 		if (ChunkPtr && ChunkPtr->IsValid())
@@ -423,7 +1068,7 @@ FORCEINLINE bool FChunk_ChunkSystem_DynamicDataTest::RunTest(const FString& Para
 
 	{
 		const FIntPoint TargetChunk = ChunkSystem->ConvertGlobalToChunkGrid(TestCase4_Location);
-		TSharedPtr<FChunk_DynamicData, ESPMode::ThreadSafe>* const ChunkPtr = ChunkSystem->Chunks.Find(TargetChunk);
+		TUniquePtr<FChunk_DynamicData>* const ChunkPtr = ChunkSystem->Chunks.Find(TargetChunk);
 		if (ChunkPtr && ChunkPtr->IsValid())
 		{
 			auto Range = ChunkPtr->Get()->IterateChannel<FData_UnitTest>(TestCase4_ChannelName);
@@ -1153,6 +1798,1580 @@ FORCEINLINE bool FChunk_ChunkSystem_ChannelIndexRebuildTest::RunTest(const FStri
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_ChannelQueryTest,
+                                 "SimpleChunkSystem.System.ChannelQuery",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_ChannelQueryTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 5;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FName ChannelA = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("Query_A"));
+	const FName ChannelB = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("Query_B"));
+
+	// A on a diagonal across several chunks, B on every even X of the same cells plus one extra cell.
+	for (int32 Index = -6; Index <= 6; ++Index)
+	{
+		const FIntPoint Point(Index, Index);
+		ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelA, Point);
+		if (Index % 2 == 0)
+		{
+			ChunkSystem->FindOrAddChannel<FData2_UnitTest>(ChannelB, Point);
+		}
+	}
+	ChunkSystem->FindOrAddChannel<FData2_UnitTest>(ChannelB, FIntPoint(3, -3));
+
+	const FIntRect All(FIntPoint(-10, -10), FIntPoint(10, 10));
+
+	FChunkChannelQuery Both;
+	Both.Where<FData_UnitTest>(ChannelA).And<FData2_UnitTest>(ChannelB);
+	TestEqual(TEXT("A and B"), ChunkSystem->QueryCells(Both, All).Num(), 7);
+
+	FChunkChannelQuery Either;
+	Either.Where<FData_UnitTest>(ChannelA).Or<FData2_UnitTest>(ChannelB);
+	TestEqual(TEXT("A or B"), ChunkSystem->QueryCells(Either, All).Num(), 14);
+
+	FChunkChannelQuery OnlyA;
+	OnlyA.Where<FData_UnitTest>(ChannelA).AndNot<FData2_UnitTest>(ChannelB);
+	const TArray<FIntPoint> OnlyACells = ChunkSystem->QueryCells(OnlyA, All);
+	TestEqual(TEXT("A and not B"), OnlyACells.Num(), 6);
+	for (const FIntPoint& Cell : OnlyACells)
+	{
+		TestTrue(TEXT("A and not B matches odd cells"), Cell.X % 2 != 0 && Cell.X == Cell.Y);
+	}
+
+	// Max is exclusive and the region crosses chunk borders.
+	const TArray<FIntPoint> Clipped = ChunkSystem->QueryCells(Both, FIntRect(FIntPoint(-2, -2), FIntPoint(4, 4)));
+	TestEqual(TEXT("Region clips results"), Clipped.Num(), 3);
+	TestTrue(TEXT("Region keeps inner cells"), Clipped.Contains(FIntPoint(-2, -2)) &&
+	         Clipped.Contains(FIntPoint(0, 0)) && Clipped.Contains(FIntPoint(2, 2)));
+
+	FChunkChannelQuery Missing;
+	Missing.Where<FData_UnitTest>(ChannelA).And<FData3_UnitTest>(ChannelB);
+	TestEqual(TEXT("Missing channel matches nothing"), ChunkSystem->QueryCells(Missing, All).Num(), 0);
+
+	// Removing one cell must keep the chunk indexed for the cells that still have the channel.
+	TestTrue(TEXT("Removed A from one cell"), ChunkSystem->TryRemoveChannel<FData_UnitTest>(ChannelA, FIntPoint(1, 1)));
+	TestFalse(TEXT("Removed cell has no A"), ChunkSystem->HasChannel<FData_UnitTest>(ChannelA, FIntPoint(1, 1)));
+	TestTrue(TEXT("Neighbour cell keeps A"), ChunkSystem->HasChannel<FData_UnitTest>(ChannelA, FIntPoint(0, 0)));
+
+	int32 Count = 0;
+	for (const auto Entry : ChunkSystem->IterateChannel<FData_UnitTest>(ChannelA))
+	{
+		++Count;
+	}
+	TestEqual(TEXT("System iterator still sees the rest of the chunk"), Count, 12);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_ChannelHandleTest,
+                                 "SimpleChunkSystem.System.ChannelHandle",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_ChannelHandleTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 5;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FName ChannelName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("Handle"));
+	const FName UnknownName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("Handle_Unknown"));
+
+	// Unresolved keys have no handle and name based reads must not create one.
+	TestFalse(TEXT("Unknown name has no channel"), ChunkSystem->HasChannel<FData_UnitTest>(UnknownName, FIntPoint(0, 0)));
+	TestFalse(TEXT("Reads do not intern keys"),
+	          FCellChannelRegistry::Get().Find({UnknownName, FData_UnitTest::StaticStruct()}).IsValid());
+
+	const FCellChannelHandle Handle = TChunkSystem_DynamicData<>::ResolveChannel<FData_UnitTest>(ChannelName);
+	TestTrue(TEXT("Resolved handle is valid"), Handle.IsValid());
+	TestEqual(TEXT("Resolve is stable"), TChunkSystem_DynamicData<>::ResolveChannel<FData_UnitTest>(ChannelName),
+	          Handle);
+	TestNotEqual(TEXT("Type is part of the key"),
+	             TChunkSystem_DynamicData<>::ResolveChannel<FData2_UnitTest>(ChannelName), Handle);
+	TestTrue(TEXT("Registry keeps the type"), FCellChannelRegistry::Get().GetType(Handle) == FData_UnitTest::StaticStruct());
+
+	// Workers resolve through their own caches and read published keys without the lock.
+	std::atomic<int32> NumMismatches{0};
+	ParallelFor(64, [&](const int32 Index)
+	{
+		const FCellChannelHandle Found = FCellChannelRegistry::Get().Find({ChannelName, FData_UnitTest::StaticStruct()});
+		if (Found != Handle || FCellChannelRegistry::Get().GetKey(Found).ChannelName != ChannelName)
+		{
+			NumMismatches.fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+	TestEqual(TEXT("Every thread resolves the same handle"), NumMismatches.load(), 0);
+
+	// Handle writes are visible through names and the other way around.
+	ChunkSystem->FindOrAddChannel(Handle, FIntPoint(1, 1)).GetMutable<FData_UnitTest>().Value = 7;
+	ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelName, FIntPoint(8, 8)).GetMutable<FData_UnitTest>().Value = 9;
+
+	TestTrue(TEXT("Name sees handle write"), ChunkSystem->HasChannel<FData_UnitTest>(ChannelName, FIntPoint(1, 1)));
+	TestTrue(TEXT("Handle sees name write"), ChunkSystem->HasChannel(Handle, FIntPoint(8, 8)));
+	TestFalse(TEXT("Other type is a different channel"),
+	          ChunkSystem->HasChannel<FData2_UnitTest>(ChannelName, FIntPoint(1, 1)));
+
+	const FInstancedStruct* Value = ChunkSystem->GetChannel(Handle, FIntPoint(8, 8));
+	TestTrue(TEXT("Handle read returns the value"), Value && Value->Get<FData_UnitTest>().Value == 9);
+
+	const TSet<FIntPoint> Batch = {FIntPoint(-3, -3), FIntPoint(-2, -2), FIntPoint(12, 0)};
+	TestEqual(TEXT("Handle batch add"), ChunkSystem->FindOrAddChannels(Handle, Batch).Num(), Batch.Num());
+	TestTrue(TEXT("Handle batch has"), ChunkSystem->HasChannels(Handle, Batch));
+
+	int32 Count = 0;
+	for (const auto Entry : ChunkSystem->IterateChannel<FData_UnitTest>(Handle))
+	{
+		++Count;
+	}
+	TestEqual(TEXT("Handle iterator sees every cell"), Count, 5);
+
+	TestTrue(TEXT("Handle batch remove"), ChunkSystem->TryRemoveChannels(Handle, Batch));
+	TestTrue(TEXT("Handle remove"), ChunkSystem->TryRemoveChannel(Handle, FIntPoint(1, 1)));
+	TestFalse(TEXT("Name sees handle remove"), ChunkSystem->HasChannel<FData_UnitTest>(ChannelName, FIntPoint(1, 1)));
+	TestFalse(TEXT("Invalid handle removes nothing"), ChunkSystem->TryRemoveChannel(FCellChannelHandle(), FIntPoint(8, 8)));
+
+	// Save data keeps names, loading resolves the same handle again.
+	TArray<uint8> Bytes;
+	{
+		FMemoryWriter Writer(Bytes, true);
+		ChunkSystem->Serialize(Writer);
+	}
+
+	const TUniquePtr<TChunkSystem_DynamicData<>> Loaded = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	{
+		FMemoryReader Reader(Bytes, true);
+		Loaded->Serialize(Reader);
+	}
+
+	const FInstancedStruct* LoadedValue = Loaded->GetChannel(Handle, FIntPoint(8, 8));
+	TestTrue(TEXT("Loaded value found by handle"), LoadedValue && LoadedValue->Get<FData_UnitTest>().Value == 9);
+	TestTrue(TEXT("Loaded index knows the handle"), Loaded->FindChannelLocations(Handle) != nullptr);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_ChunkPoolTest,
+                                 "SimpleChunkSystem.System.ChunkPool",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_ChunkPoolTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	ChunkSystem->SetChunkPoolSize(2);
+
+	const FName ChannelName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("Pool"));
+
+	// Three chunks, removing all of them keeps two in the pool.
+	ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelName, FIntPoint(0, 0)).GetMutable<FData_UnitTest>().Value = 1;
+	ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelName, FIntPoint(4, 0)).GetMutable<FData_UnitTest>().Value = 2;
+	ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelName, FIntPoint(8, 0)).GetMutable<FData_UnitTest>().Value = 3;
+	TestEqual(TEXT("New chunks miss the empty pool"), ChunkSystem->GetChunkPoolStats().Misses, 3);
+
+	TestTrue(TEXT("Removed chunk 0"), ChunkSystem->TryRemoveChunkByGrid(FIntPoint(0, 0)));
+	TestTrue(TEXT("Removed chunk 1"), ChunkSystem->TryRemoveChunkByGrid(FIntPoint(4, 0)));
+	TestTrue(TEXT("Removed chunk 2"), ChunkSystem->TryRemoveChunkByGrid(FIntPoint(8, 0)));
+	TestEqual(TEXT("Pool is limited"), ChunkSystem->GetNumPooledChunks(), 2);
+	TestEqual(TEXT("Recycled chunks"), ChunkSystem->GetChunkPoolStats().Recycled, 2);
+	TestEqual(TEXT("Discarded chunks"), ChunkSystem->GetChunkPoolStats().Discarded, 1);
+
+	// A recycled chunk is rebound to its new bounds and holds no stale data.
+	const FIntPoint FarCell(-41, 17);
+	ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelName, FarCell).GetMutable<FData_UnitTest>().Value = 4;
+	TestEqual(TEXT("Pool hit"), ChunkSystem->GetChunkPoolStats().Hits, 1);
+	TestEqual(TEXT("Pool shrinks on reuse"), ChunkSystem->GetNumPooledChunks(), 1);
+
+	const FInstancedStruct* FarValue = ChunkSystem->GetChannel<FData_UnitTest>(ChannelName, FarCell);
+	TestTrue(TEXT("Recycled chunk stores new data"), FarValue && FarValue->Get<FData_UnitTest>().Value == 4);
+	TestFalse(TEXT("Removed data is gone"), ChunkSystem->HasChannel<FData_UnitTest>(ChannelName, FIntPoint(8, 0)));
+
+	int32 Count = 0;
+	for (const auto Entry : ChunkSystem->IterateChannel<FData_UnitTest>(ChannelName))
+	{
+		TestEqual(TEXT("Iterator only sees the new cell"), Entry.Key, FarCell);
+		++Count;
+	}
+	TestEqual(TEXT("Recycled chunk has a single channel"), Count, 1);
+
+	const FChunkHandle FarChunk = ChunkSystem->FindChunkHandleByGrid(FarCell);
+	TestTrue(TEXT("Chunk handle resolves"), ChunkSystem->FindChunk(FarChunk) != nullptr);
+
+	// Empty returns chunks to the pool as well, shrinking the pool drops the extra ones.
+	ChunkSystem->Empty();
+	TestEqual(TEXT("Empty fills the pool"), ChunkSystem->GetNumPooledChunks(), 2);
+
+	TestFalse(TEXT("Chunk handle is stale after Empty"), ChunkSystem->IsChunkHandleValid(FarChunk));
+
+	ChunkSystem->SetChunkPoolSize(1);
+	TestEqual(TEXT("Pool is trimmed"), ChunkSystem->GetNumPooledChunks(), 1);
+
+	ChunkSystem->SetChunkPoolSize(0);
+	ChunkSystem->ResetChunkPoolStats();
+	TestTrue(TEXT("Chunk created without pool"), ChunkSystem->TryMakeChunkByGrid(FIntPoint(0, 0)));
+	TestTrue(TEXT("Chunk removed without pool"), ChunkSystem->TryRemoveChunkByGrid(FIntPoint(0, 0)));
+	TestEqual(TEXT("Disabled pool keeps nothing"), ChunkSystem->GetNumPooledChunks(), 0);
+	TestEqual(TEXT("Disabled pool counts no recycling"), ChunkSystem->GetChunkPoolStats().Recycled, 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_GridBoundsTest,
+                                 "SimpleChunkSystem.System.GridBounds",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_GridBoundsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	// Chunks -2..1 on both axes, cells -8..7.
+	TestTrue(TEXT("Bounds set on empty system"), ChunkSystem->SetChunkGridBounds(FIntRect(-2, -2, 2, 2)));
+	TestTrue(TEXT("System is bounded"), ChunkSystem->HasChunkGridBounds());
+
+	const FName ChannelName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("Bounded"));
+
+	const FIntPoint MinCell(-8, -8);
+	const FIntPoint MaxCell(7, 7);
+	ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelName, MinCell).GetMutable<FData_UnitTest>().Value = 1;
+	ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelName, MaxCell).GetMutable<FData_UnitTest>().Value = 2;
+
+	const FInstancedStruct* MinValue = ChunkSystem->GetChannel<FData_UnitTest>(ChannelName, MinCell);
+	const FInstancedStruct* MaxValue = ChunkSystem->GetChannel<FData_UnitTest>(ChannelName, MaxCell);
+	TestTrue(TEXT("Corner cell resolves"), MinValue && MinValue->Get<FData_UnitTest>().Value == 1);
+	TestTrue(TEXT("Opposite corner resolves"), MaxValue && MaxValue->Get<FData_UnitTest>().Value == 2);
+	TestEqual(TEXT("Two chunks"), ChunkSystem->Num(), 2);
+
+	TestFalse(TEXT("Cell past Max is outside"), ChunkSystem->IsInChunkGridBounds(FIntPoint(8, 0)));
+	TestFalse(TEXT("Cell before Min is outside"), ChunkSystem->IsInChunkGridBounds(FIntPoint(0, -9)));
+	TestFalse(TEXT("Chunk outside is not created"), ChunkSystem->TryMakeChunkByGrid(FIntPoint(8, 0)));
+	TestNull(TEXT("Reads outside return nothing"), ChunkSystem->GetChannel<FData_UnitTest>(ChannelName, FIntPoint(100, 100)));
+	TestFalse(TEXT("Removal outside fails"), ChunkSystem->TryRemoveChunkByGrid(FIntPoint(-100, 0)));
+
+	const TArray<FInstancedStruct*> Added = ChunkSystem->FindOrAddChannels<FData_UnitTest>(
+		ChannelName, TSet<FIntPoint>{FIntPoint(0, 0), FIntPoint(50, 50)});
+	TestEqual(TEXT("Batch skips cells outside"), Added.Num(), 1);
+
+	// Single cell writes outside of the bounds are rejected instead of asserting.
+	AddExpectedError(TEXT("outside of the chunk grid bounds"), EAutomationExpectedErrorFlags::Contains, 3);
+	TestNull(TEXT("Try add outside is rejected"),
+	         ChunkSystem->TryFindOrAddChannel<FData_UnitTest>(ChannelName, FIntPoint(50, 50)));
+	TestNull(TEXT("Try add column outside is rejected"),
+	         ChunkSystem->TryFindOrAddColumnValue<FData_UnitTest>(ChannelName, FIntPoint(-50, 0)));
+	const FStructView Rejected = ChunkSystem->TryFindOrAddColumnValue(ChannelName, FIntPoint(0, 50),
+	                                                                  FData_UnitTest::StaticStruct());
+	TestFalse(TEXT("Try add view outside is rejected"), Rejected.IsValid());
+	TestNotNull(TEXT("Try add inside succeeds"),
+	            ChunkSystem->TryFindOrAddChannel<FData_UnitTest>(ChannelName, FIntPoint(1, 1)));
+	TestEqual(TEXT("Rejected writes create no chunks"), ChunkSystem->Num(), 3);
+
+	TestFalse(TEXT("Bounds can't change with chunks"), ChunkSystem->SetChunkGridBounds(FIntRect()));
+
+	TestTrue(TEXT("Removed corner chunk"), ChunkSystem->TryRemoveChunkByGrid(MinCell));
+	TestFalse(TEXT("Removed corner is gone"), ChunkSystem->HasChannel<FData_UnitTest>(ChannelName, MinCell));
+
+	ChunkSystem->Empty();
+	TestTrue(TEXT("Bounds lifted on empty system"), ChunkSystem->SetChunkGridBounds(FIntRect()));
+	TestTrue(TEXT("Unbounded system accepts any chunk"), ChunkSystem->TryMakeChunkByGrid(FIntPoint(100, 100)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_LookupCacheTest,
+                                 "SimpleChunkSystem.System.LookupCache",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_LookupCacheTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("LookupCache"));
+
+	// The first access misses and creates the chunk, the rest of the chunk is served by the cache.
+	ChunkSystem->FindOrAddChannel(Handle, FIntPoint(-4, -4)).GetMutable<FData_UnitTest>().Value = 1;
+	TestEqual(TEXT("First access misses"), ChunkSystem->GetChunkLookupCacheStats().Misses, 1ll);
+
+	for (int32 X = -4; X < 0; ++X)
+	{
+		for (int32 Y = -4; Y < 0; ++Y)
+		{
+			ChunkSystem->HasChannel(Handle, FIntPoint(X, Y));
+		}
+	}
+	TestEqual(TEXT("Same chunk hits"), ChunkSystem->GetChunkLookupCacheStats().Hits, 16ll);
+
+	ChunkSystem->HasChannel(Handle, FIntPoint(0, -4));
+	TestEqual(TEXT("Neighbour chunk cell misses"), ChunkSystem->GetChunkLookupCacheStats().Misses, 2ll);
+	TestTrue(TEXT("Hit rate"), ChunkSystem->GetChunkLookupCacheStats().GetHitRate() > 0.8);
+
+	// Removing the chunk must not leave a dangling cached chunk behind.
+	const FInstancedStruct* Cached = ChunkSystem->GetChannel(Handle, FIntPoint(-4, -4));
+	TestTrue(TEXT("Cached chunk resolves"), Cached && Cached->Get<FData_UnitTest>().Value == 1);
+	TestTrue(TEXT("Removed chunk"), ChunkSystem->TryRemoveChunkByGrid(FIntPoint(-4, -4)));
+
+	ChunkSystem->ResetChunkLookupCacheStats();
+	TestNull(TEXT("Removal invalidates the cache"), ChunkSystem->GetChannel(Handle, FIntPoint(-4, -4)));
+	TestEqual(TEXT("Lookup after removal misses"), ChunkSystem->GetChunkLookupCacheStats().Misses, 1ll);
+
+	// Another system never sees the chunk cached by this one.
+	const TUniquePtr<TChunkSystem_DynamicData<>> OtherSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	ChunkSystem->FindOrAddChannel(Handle, FIntPoint(1, 1));
+	TestFalse(TEXT("Cache is per system"), OtherSystem->HasChannel(Handle, FIntPoint(1, 1)));
+
+	// Per thread counters add up to every lookup made by the workers.
+	ChunkSystem->ResetChunkLookupCacheStats();
+	ParallelFor(256, [&ChunkSystem, Handle](const int32 Index)
+	{
+		ChunkSystem->HasChannel(Handle, FIntPoint(Index % ChunkSize, Index / ChunkSize % ChunkSize));
+	});
+	const FChunkLookupCacheStats ParallelStats = ChunkSystem->GetChunkLookupCacheStats();
+	TestEqual(TEXT("Counters of all threads are summed"), ParallelStats.Hits + ParallelStats.Misses, 256ll);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_BatchViewTest,
+                                 "SimpleChunkSystem.System.BatchView",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_BatchViewTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("BatchView"));
+
+	// Points spread over several chunks in a scrambled order, including negative coordinates.
+	TArray<FIntPoint> Points;
+	for (int32 Index = 0; Index < 200; ++Index)
+	{
+		Points.Add(FIntPoint((Index * 7) % 23 - 11, (Index * 13) % 19 - 9));
+	}
+
+	FChunkBatchScratch Scratch;
+	TArray<FInstancedStruct*> Added;
+	ChunkSystem->FindOrAddChannels(Handle, Points, Added, Scratch);
+	TestEqual(TEXT("Output is index aligned"), Added.Num(), Points.Num());
+
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		if (Added[Index])
+		{
+			Added[Index]->GetMutable<FData_UnitTest>().Value = Points[Index].X * 100 + Points[Index].Y;
+		}
+	}
+
+	TArray<const FInstancedStruct*> Found;
+	ChunkSystem->FindExistingChannels(Handle, Points, Found, Scratch);
+
+	bool bAligned = Found.Num() == Points.Num();
+	for (int32 Index = 0; bAligned && Index < Points.Num(); ++Index)
+	{
+		bAligned &= Found[Index] && Found[Index]->Get<FData_UnitTest>().Value == Points[Index].X * 100 + Points[Index].Y;
+		bAligned &= ChunkSystem->HasChannel(Handle, Points[Index]);
+	}
+	TestTrue(TEXT("Found channels match their points"), bAligned);
+	TestTrue(TEXT("All points hold the channel"), ChunkSystem->HasChannels(Handle, Points, Scratch));
+
+	const TArray<FIntPoint> WithMissing = {Points[0], FIntPoint(500, 500)};
+	TestFalse(TEXT("A missing point fails the batch"), ChunkSystem->HasChannels(Handle, WithMissing));
+
+	ChunkSystem->FindExistingChannels(Handle, WithMissing, Found);
+	TestTrue(TEXT("Missing point yields null"), Found.Num() == 2 && Found[0] && !Found[1]);
+
+	// Removing every point empties the channel index as the TSet path does.
+	TestTrue(TEXT("Batch removal"), ChunkSystem->TryRemoveChannels(Handle, Points, Scratch));
+	TestFalse(TEXT("Nothing left to remove"), ChunkSystem->TryRemoveChannels(Handle, Points, Scratch));
+	TestNull(TEXT("No channel locations left"), ChunkSystem->FindChannelLocations(Handle));
+
+	TestTrue(TEXT("Empty batch"), ChunkSystem->HasChannels(Handle, TConstArrayView<FIntPoint>()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_RegionTest,
+                                 "SimpleChunkSystem.System.Region",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_RegionTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Region"));
+
+	FData_UnitTest Value;
+	Value.Value = 7;
+
+	// 10x6 cells straddling the origin and several chunk borders, Max is exclusive.
+	const FIntRect Region(FIntPoint(-5, -3), FIntPoint(5, 3));
+	TestEqual(TEXT("Fill writes every cell"), ChunkSystem->FillRegion(Handle, Region, FInstancedStruct::Make(Value)), 60);
+	TestEqual(TEXT("Chunks covering the region"), ChunkSystem->Num(), 4 * 2);
+
+	bool bFilled = true;
+	for (int32 X = Region.Min.X; X < Region.Max.X; ++X)
+	{
+		for (int32 Y = Region.Min.Y; Y < Region.Max.Y; ++Y)
+		{
+			const FInstancedStruct* const Channel = ChunkSystem->GetChannel(Handle, FIntPoint(X, Y));
+			bFilled &= Channel && Channel->Get<FData_UnitTest>().Value == 7;
+		}
+	}
+	TestTrue(TEXT("Filled cells hold the value"), bFilled);
+	TestFalse(TEXT("Max X is exclusive"), ChunkSystem->HasChannel(Handle, FIntPoint(5, 0)));
+	TestFalse(TEXT("Max Y is exclusive"), ChunkSystem->HasChannel(Handle, FIntPoint(0, 3)));
+
+	TestEqual(TEXT("Count full region"), ChunkSystem->CountRegion(Handle, Region), 60);
+	TestEqual(TEXT("Count larger region"), ChunkSystem->CountRegion(Handle, FIntRect(-50, -50, 50, 50)), 60);
+	TestEqual(TEXT("Count sub region"), ChunkSystem->CountRegion(Handle, FIntRect(-1, -1, 2, 1)), 6);
+	TestEqual(TEXT("Count empty region"), ChunkSystem->CountRegion(Handle, FIntRect(2, 2, 2, 8)), 0);
+
+	// Punch a hole across the chunk border at x = 0.
+	const FIntRect Hole(FIntPoint(-2, -1), FIntPoint(2, 2));
+	TestEqual(TEXT("Clear hole"), ChunkSystem->ClearRegion(Handle, Hole), 12);
+	TestEqual(TEXT("Nothing left in hole"), ChunkSystem->ClearRegion(Handle, Hole), 0);
+	TestEqual(TEXT("Count after clear"), ChunkSystem->CountRegion(Handle, Region), 48);
+
+	const TArray<FIntPoint> Remaining = ChunkSystem->QueryRegion(Handle, FIntRect(-3, -1, 3, 2));
+	TestEqual(TEXT("Query around the hole"), Remaining.Num(), 6);
+
+	bool bOutsideHole = true;
+	for (const FIntPoint& Point : Remaining)
+	{
+		bOutsideHole &= !Hole.Contains(Point) && ChunkSystem->HasChannel(Handle, Point);
+	}
+	TestTrue(TEXT("Queried cells are outside of the hole"), bOutsideHole);
+
+	// Clearing the rest drops the channel index entirely.
+	TestEqual(TEXT("Clear everything"), ChunkSystem->ClearRegion(Handle, Region), 48);
+	TestNull(TEXT("No channel locations left"), ChunkSystem->FindChannelLocations(Handle));
+	TestTrue(TEXT("Query on cleared region"), ChunkSystem->QueryRegion(Handle, Region).IsEmpty());
+
+	// Bounded systems only fill the part of the region inside the chunk grid.
+	const TUniquePtr<TChunkSystem_DynamicData<>> Bounded = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	Bounded->SetChunkGridBounds(FIntRect(0, 0, 2, 2));
+	TestEqual(TEXT("Fill clipped to bounds"), Bounded->FillRegion(Handle, FIntRect(-4, -4, 12, 12),
+	                                                              FInstancedStruct::Make(Value)), 64);
+	TestEqual(TEXT("Only bounded chunks created"), Bounded->Num(), 4);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_RadiusQueryTest,
+                                 "SimpleChunkSystem.System.RadiusQuery",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_RadiusQueryTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Radius"));
+	const FCellChannelHandle Other = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("RadiusOther"));
+
+	// A checkerboard of the channel, the other channel fills everything so chunks without it exist too.
+	TSet<FIntPoint> Cells;
+	for (int32 X = -20; X < 20; ++X)
+	{
+		for (int32 Y = -20; Y < 20; ++Y)
+		{
+			ChunkSystem->FindOrAddChannel(Other, FIntPoint(X, Y));
+			if (((X + Y) & 1) == 0 && X < 10)
+			{
+				ChunkSystem->FindOrAddChannel(Handle, FIntPoint(X, Y));
+				Cells.Add(FIntPoint(X, Y));
+			}
+		}
+	}
+
+	struct FCase
+	{
+		FIntPoint Center;
+		int32 Radius;
+	};
+
+	const FCase Cases[] = {{FIntPoint(0, 0), 0}, {FIntPoint(1, 1), 1}, {FIntPoint(-3, 2), 5}, {FIntPoint(7, -9), 9},
+	                       {FIntPoint(0, 0), 40}, {FIntPoint(100, 100), 3}};
+
+	for (const FCase& Case : Cases)
+	{
+		TSet<FIntPoint> Expected;
+		for (const FIntPoint& Cell : Cells)
+		{
+			if ((Cell - Case.Center).SizeSquared() <= Case.Radius * Case.Radius)
+			{
+				Expected.Add(Cell);
+			}
+		}
+
+		const TArray<FIntPoint> Found = ChunkSystem->QueryRadius(Handle, Case.Center, Case.Radius);
+		const TSet<FIntPoint> FoundSet(Found);
+
+		TestEqual(FString::Printf(TEXT("No duplicates around %s r %d"), *Case.Center.ToString(), Case.Radius),
+		          FoundSet.Num(), Found.Num());
+		TestTrue(FString::Printf(TEXT("Matches brute force around %s r %d"), *Case.Center.ToString(), Case.Radius),
+		         FoundSet.Num() == Expected.Num() && FoundSet.Includes(Expected));
+	}
+
+	TestTrue(TEXT("Negative radius"), ChunkSystem->QueryRadius(Handle, FIntPoint(0, 0), -1).IsEmpty());
+	TestTrue(TEXT("Unknown channel"), ChunkSystem->QueryRadius(FCellChannelHandle(), FIntPoint(0, 0), 5).IsEmpty());
+
+	// Continuous centers and radii test the cell centers, whatever cell the center falls in.
+	const auto BruteForce = [&Cells](const FVector2D& Center, const double Radius)
+	{
+		TSet<FIntPoint> Expected;
+		for (const FIntPoint& Cell : Cells)
+		{
+			const double DeltaX = static_cast<double>(Cell.X) + 0.5 - Center.X;
+			const double DeltaY = static_cast<double>(Cell.Y) + 0.5 - Center.Y;
+			if (DeltaX * DeltaX + DeltaY * DeltaY <= Radius * Radius)
+			{
+				Expected.Add(Cell);
+			}
+		}
+
+		return Expected;
+	};
+
+	struct FContinuousCase
+	{
+		FVector2D Center;
+		double Radius;
+	};
+
+	const FContinuousCase ContinuousCases[] = {{FVector2D(0.1, -0.7), 2.3}, {FVector2D(3.9, 4.2), 6.75},
+	                                           {FVector2D(-10.25, 7.5), 0.6}, {FVector2D(0.5, 0.5), 0.4},
+	                                           {FVector2D(-3.0, 2.0), 5.0}, {FVector2D(8.7, -15.1), 11.3}};
+
+	for (const FContinuousCase& Case : ContinuousCases)
+	{
+		const TSet<FIntPoint> Expected = BruteForce(Case.Center, Case.Radius);
+		const TArray<FIntPoint> Found = ChunkSystem->QueryRadius(Handle, Case.Center, Case.Radius);
+		const TSet<FIntPoint> FoundSet(Found);
+
+		TestEqual(FString::Printf(TEXT("No duplicates around %s r %f"), *Case.Center.ToString(), Case.Radius),
+		          FoundSet.Num(), Found.Num());
+		TestTrue(FString::Printf(TEXT("Matches brute force around %s r %f"), *Case.Center.ToString(), Case.Radius),
+		         FoundSet.Num() == Expected.Num() && FoundSet.Includes(Expected));
+	}
+
+	// The world space overload keeps the location within its cell and a fractional radius.
+	const UWorld* World = ChunkSystem->GetWorld();
+	const double CellSize = UChunkBlueprintFunctionLibrary::GetCellSize();
+	const FVector2D CellCenter = UChunkBlueprintFunctionLibrary::ConvertGridToGlobalLocationAtCenter(
+		World, FIntPoint(2, 2));
+	const FVector2D Offsets[] = {FVector2D::ZeroVector, FVector2D(0.3, -0.2) * CellSize};
+	for (const FVector2D& Offset : Offsets)
+	{
+		const FVector Location(CellCenter + Offset, 0.0);
+		const double Radius = CellSize * 3.5;
+
+		const TSet<FIntPoint> Expected = BruteForce(
+			UChunkBlueprintFunctionLibrary::ConvertGlobalLocationToContinuousGrid(World, Location), Radius / CellSize);
+		const TSet<FIntPoint> WorldFound(ChunkSystem->QueryRadius(Handle, Location, Radius));
+		TestTrue(FString::Printf(TEXT("World space matches brute force at offset %s"), *Offset.ToString()),
+		         WorldFound.Num() == Expected.Num() && WorldFound.Includes(Expected));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_RaycastTest,
+                                 "SimpleChunkSystem.System.Raycast",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_RaycastTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Raycast"));
+	const FCellChannelHandle Other = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("RaycastOther"));
+
+	// Scattered cells, with chunks holding only the other channel and gaps without chunks in between.
+	FRandomStream Random(1337);
+	for (int32 Index = 0; Index < 300; ++Index)
+	{
+		const FIntPoint Cell(Random.RandRange(-30, 30), Random.RandRange(-30, 30));
+		if (Cell.X > 20)
+		{
+			continue;
+		}
+
+		ChunkSystem->FindOrAddChannel(Cell.X < 0 && Cell.Y < 0 ? Other : Handle, Cell);
+	}
+
+	for (int32 Index = 0; Index < 200; ++Index)
+	{
+		const FChunkRay Ray(FVector2D(Random.FRandRange(-35.0, 35.0), Random.FRandRange(-35.0, 35.0)),
+		                    FVector2D(Random.FRandRange(-35.0, 35.0), Random.FRandRange(-35.0, 35.0)));
+
+		// Cell by cell walk as reference.
+		TArray<FChunkRayHit> Expected;
+		for (FChunkGridTraversal Traversal(Ray.Start, Ray.End); !Traversal.IsDone(); Traversal.Step())
+		{
+			if (ChunkSystem->HasChannel(Handle, Traversal.GetCell()))
+			{
+				Expected.Emplace(Traversal.GetCell(), Traversal.GetEntryTime());
+			}
+		}
+
+		const FChunkRayHit First = ChunkSystem->Raycast(Handle, Ray);
+		const TArray<FChunkRayHit> All = ChunkSystem->RaycastAll(Handle, Ray);
+
+		TestEqual(FString::Printf(TEXT("Hit %d found"), Index), First.IsHit(), !Expected.IsEmpty());
+		if (!Expected.IsEmpty())
+		{
+			TestEqual(FString::Printf(TEXT("Hit %d cell"), Index), First.Cell, Expected[0].Cell);
+			TestTrue(FString::Printf(TEXT("Hit %d time"), Index), FMath::IsNearlyEqual(First.Time, Expected[0].Time));
+		}
+
+		TestEqual(FString::Printf(TEXT("All hits %d count"), Index), All.Num(), Expected.Num());
+		for (int32 HitIndex = 0; HitIndex < FMath::Min(All.Num(), Expected.Num()); ++HitIndex)
+		{
+			TestEqual(FString::Printf(TEXT("All hits %d cell %d"), Index, HitIndex), All[HitIndex].Cell,
+			          Expected[HitIndex].Cell);
+		}
+	}
+
+	// Straight rays and rays starting and ending in the same cell.
+	ChunkSystem->FindOrAddChannel(Handle, FIntPoint(25, 0));
+	TestEqual(TEXT("Along X"), ChunkSystem->Raycast(Handle, FChunkRay(FVector2D(50.5, 0.5), FVector2D(21.5, 0.5))).Cell,
+	          FIntPoint(25, 0));
+	TestTrue(TEXT("Single cell hit"),
+	         ChunkSystem->Raycast(Handle, FChunkRay(FVector2D(25.2, 0.2), FVector2D(25.8, 0.9))).IsHit());
+	TestFalse(TEXT("Single cell miss"),
+	          ChunkSystem->Raycast(Handle, FChunkRay(FVector2D(26.2, 0.2), FVector2D(26.8, 0.9))).IsHit());
+	TestFalse(TEXT("Segment ends before the cell"),
+	          ChunkSystem->Raycast(Handle, FChunkRay(FVector2D(50.5, 0.5), FVector2D(26.01, 0.5))).IsHit());
+	TestFalse(TEXT("Unknown channel"),
+	          ChunkSystem->Raycast(FCellChannelHandle(), FChunkRay(FVector2D(50.5, 0.5), FVector2D(21.5, 0.5))).IsHit());
+
+	// The batch matches the single rays.
+	TArray<FChunkRay> Rays;
+	for (int32 Index = 0; Index < 500; ++Index)
+	{
+		Rays.Emplace(FVector2D(Random.FRandRange(-35.0, 35.0), Random.FRandRange(-35.0, 35.0)),
+		             FVector2D(Random.FRandRange(-35.0, 35.0), Random.FRandRange(-35.0, 35.0)));
+	}
+
+	const TArray<FChunkRayHit> Batch = ChunkSystem->RaycastBatch(Handle, Rays);
+	TestEqual(TEXT("Batch size"), Batch.Num(), Rays.Num());
+
+	int32 NumMismatches = 0;
+	for (int32 Index = 0; Index < Rays.Num(); ++Index)
+	{
+		const FChunkRayHit Single = ChunkSystem->Raycast(Handle, Rays[Index]);
+		NumMismatches += Single.IsHit() != Batch[Index].IsHit() || Single.Cell != Batch[Index].Cell ? 1 : 0;
+	}
+	TestEqual(TEXT("Batch matches single rays"), NumMismatches, 0);
+
+	// World space rays go through the grid conversion of the system.
+	const UWorld* World = ChunkSystem->GetWorld();
+	const FVector2D From = UChunkBlueprintFunctionLibrary::ConvertGridToGlobalLocationAtCenter(World, FIntPoint(50, 0));
+	const FVector2D To = UChunkBlueprintFunctionLibrary::ConvertGridToGlobalLocationAtCenter(World, FIntPoint(21, 0));
+	TestEqual(TEXT("World space ray"), ChunkSystem->Raycast(Handle, FVector(From, 0.0), FVector(To, 0.0)).Cell,
+	          FIntPoint(25, 0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_NearestTest,
+                                 "SimpleChunkSystem.System.Nearest",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_NearestTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Nearest"));
+
+	TestFalse(TEXT("Empty channel"), ChunkSystem->FindNearest(Handle, FIntPoint(0, 0)).IsValid());
+
+	// A cluster plus a few cells far away, so both the rings and the direct scan of the index are used.
+	FRandomStream Random(777);
+	TArray<FIntPoint> Cells;
+	for (int32 Index = 0; Index < 150; ++Index)
+	{
+		Cells.AddUnique(FIntPoint(Random.RandRange(-20, 20), Random.RandRange(-20, 20)));
+	}
+
+	Cells.AddUnique(FIntPoint(500, -300));
+	Cells.AddUnique(FIntPoint(-1000, 1000));
+
+	for (const FIntPoint& Cell : Cells)
+	{
+		ChunkSystem->FindOrAddChannel(Handle, Cell);
+	}
+
+	const FIntPoint Origins[] = {FIntPoint(0, 0), FIntPoint(3, -7), FIntPoint(-19, 19), FIntPoint(60, 60),
+	                             FIntPoint(480, -290), FIntPoint(-5000, 5000)};
+	const int32 Counts[] = {1, 5, 40, 500};
+
+	for (const FIntPoint& Origin : Origins)
+	{
+		TArray<FChunkNearestCell> Expected;
+		for (const FIntPoint& Cell : Cells)
+		{
+			Expected.Emplace(Cell, static_cast<int64>((Cell - Origin).SizeSquared()));
+		}
+		Expected.Sort();
+
+		for (const int32 Count : Counts)
+		{
+			const TArray<FChunkNearestCell> Found = ChunkSystem->FindKNearest(Handle, Origin, Count);
+			const int32 NumExpected = FMath::Min(Count, Expected.Num());
+
+			bool bMatches = Found.Num() == NumExpected;
+			for (int32 Index = 0; bMatches && Index < NumExpected; ++Index)
+			{
+				bMatches = Found[Index].Cell == Expected[Index].Cell &&
+					Found[Index].DistanceSquared == Expected[Index].DistanceSquared;
+			}
+
+			TestTrue(FString::Printf(TEXT("%d nearest of %s"), Count, *Origin.ToString()), bMatches);
+		}
+
+		TestEqual(FString::Printf(TEXT("Nearest of %s"), *Origin.ToString()),
+		          ChunkSystem->FindNearest(Handle, Origin).Cell, Expected[0].Cell);
+	}
+
+	TestTrue(TEXT("Zero count"), ChunkSystem->FindKNearest(Handle, FIntPoint(0, 0), 0).IsEmpty());
+
+	// The world space overload goes through the grid conversion of the system.
+	const UWorld* World = ChunkSystem->GetWorld();
+	const FVector2D Location =
+		UChunkBlueprintFunctionLibrary::ConvertGridToGlobalLocationAtCenter(World, FIntPoint(3, -7));
+	TestEqual(TEXT("World space"), ChunkSystem->FindNearest(Handle, FVector(Location, 0.0)).Cell,
+	          ChunkSystem->FindNearest(Handle, FIntPoint(3, -7)).Cell);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_ComponentsTest,
+                                 "SimpleChunkSystem.System.Components",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_ComponentsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Components"));
+
+	TestTrue(TEXT("Empty channel"), ChunkSystem->LabelComponents(Handle).IsEmpty());
+
+	// Random blobs spanning many chunk borders, plus a snake crossing chunks back and forth.
+	FRandomStream Random(4242);
+	TSet<FIntPoint> Cells;
+	for (int32 Index = 0; Index < 900; ++Index)
+	{
+		Cells.Add(FIntPoint(Random.RandRange(-25, 25), Random.RandRange(-25, 25)));
+	}
+
+	for (int32 X = 40; X < 60; ++X)
+	{
+		Cells.Add(FIntPoint(X, (X / 3) % 2 == 0 ? 0 : 7));
+		for (int32 Y = 0; Y <= 7; ++Y)
+		{
+			if (X % 3 == 0)
+			{
+				Cells.Add(FIntPoint(X, Y));
+			}
+		}
+	}
+
+	for (const FIntPoint& Cell : Cells)
+	{
+		ChunkSystem->FindOrAddChannel(Handle, Cell);
+	}
+
+	const FChunkChannelComponents Components = ChunkSystem->LabelComponents(Handle);
+
+	// Flood fill as reference, each component must map to exactly one label.
+	TSet<FIntPoint> Visited;
+	TSet<int32> SeenLabels;
+	int32 NumExpected = 0;
+	bool bConsistent = true;
+
+	for (const FIntPoint& Seed : Cells)
+	{
+		if (Visited.Contains(Seed))
+		{
+			continue;
+		}
+
+		++NumExpected;
+		const int32 Label = Components.GetComponent(Seed);
+		bConsistent &= Label != INDEX_NONE && !SeenLabels.Contains(Label);
+		SeenLabels.Add(Label);
+
+		int32 Size = 0;
+		TArray<FIntPoint> Stack = {Seed};
+		Visited.Add(Seed);
+
+		while (!Stack.IsEmpty())
+		{
+			const FIntPoint Cell = Stack.Pop();
+			++Size;
+			bConsistent &= Components.GetComponent(Cell) == Label;
+
+			for (const FIntPoint& Offset : {FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1)})
+			{
+				const FIntPoint Next = Cell + Offset;
+				if (Cells.Contains(Next) && !Visited.Contains(Next))
+				{
+					Visited.Add(Next);
+					Stack.Add(Next);
+				}
+			}
+		}
+
+		bConsistent &= Components.GetComponentSize(Label) == Size;
+	}
+
+	TestTrue(TEXT("Components match the flood fill"), bConsistent);
+	TestEqual(TEXT("Number of components"), Components.Num(), NumExpected);
+	TestEqual(TEXT("Cell without the channel"), Components.GetComponent(FIntPoint(100, 100)), INDEX_NONE);
+
+	int32 NumCells = 0;
+	Components.ForEachCell([&NumCells](const FIntPoint&, const int32) { ++NumCells; });
+	TestEqual(TEXT("Every cell is labeled"), NumCells, Cells.Num());
+
+	// The snake is a single component across all its chunks.
+	TestEqual(TEXT("Snake"), Components.GetComponent(FIntPoint(40, 7)), Components.GetComponent(FIntPoint(59, 7)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_AggregateTest,
+                                 "SimpleChunkSystem.System.Aggregate",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_AggregateTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Aggregate"));
+
+	TestFalse(TEXT("Unknown field"), ChunkSystem->AddAggregateField(Handle, TEXT("Missing")));
+
+	FRandomStream Random(4242);
+	TMap<FIntPoint, int32> Values;
+
+	const auto SetValue = [&ChunkSystem, Handle, &Values](const FIntPoint& Cell, const int32 Value)
+	{
+		ChunkSystem->FindOrAddChannel(Handle, Cell).GetMutablePtr<FData_UnitTest>()->Value = Value;
+		Values.Add(Cell, Value);
+	};
+
+	// Half of the cells exist before the field is added, the rest land in existing and new chunks.
+	for (int32 Index = 0; Index < 200; ++Index)
+	{
+		SetValue(FIntPoint(Random.RandRange(-15, 15), Random.RandRange(-15, 15)), Random.RandRange(-100, 100));
+	}
+
+	TestTrue(TEXT("Numeric field"), ChunkSystem->AddAggregateField(Handle, TEXT("Value")));
+
+	for (int32 Index = 0; Index < 200; ++Index)
+	{
+		SetValue(FIntPoint(Random.RandRange(-30, 30), Random.RandRange(-30, 30)), Random.RandRange(-100, 100));
+	}
+
+	const FIntRect Regions[] = {FIntRect(-30, -30, 31, 31), FIntRect(-8, -8, 8, 8), FIntRect(-7, 3, 13, 9),
+	                            FIntRect(1, 1, 2, 2), FIntRect(100, 100, 120, 120)};
+
+	const auto CheckRegions = [this, &ChunkSystem, Handle, &Values, &Regions](const TCHAR* Step)
+	{
+		for (const FIntRect& Region : Regions)
+		{
+			FChunkChannelAggregate Expected;
+			for (const TPair<FIntPoint, int32>& Value : Values)
+			{
+				if (Region.Contains(Value.Key))
+				{
+					Expected.Add(Value.Value);
+				}
+			}
+
+			const FChunkChannelAggregate Found = ChunkSystem->AggregateRegion(Handle, Region);
+			const FChunkChannelAggregate FoundConst = AsConst(*ChunkSystem).AggregateRegion(Handle, Region);
+			const bool bMatches = Found.Count == Expected.Count && Found.Sum == Expected.Sum &&
+				(Expected.IsEmpty() || (Found.Min == Expected.Min && Found.Max == Expected.Max));
+			const bool bConstMatches = FoundConst.Count == Found.Count && FoundConst.Sum == Found.Sum &&
+				FoundConst.Min == Found.Min && FoundConst.Max == Found.Max;
+
+			TestTrue(FString::Printf(TEXT("%s, %s"), Step, *Region.ToString()), bMatches);
+			TestTrue(FString::Printf(TEXT("%s, const %s"), Step, *Region.ToString()), bConstMatches);
+		}
+	};
+
+	CheckRegions(TEXT("Added"));
+
+	// Writes through the returned pointer make the summary stale.
+	for (TPair<FIntPoint, int32>& Value : Values)
+	{
+		if (Random.FRand() < 0.3f)
+		{
+			Value.Value = Random.RandRange(-500, 500);
+			ChunkSystem->GetChannel(Handle, Value.Key)->GetMutablePtr<FData_UnitTest>()->Value = Value.Value;
+		}
+	}
+
+	CheckRegions(TEXT("Written"));
+
+	// Removals are taken out of the summaries, including the current extremes.
+	TArray<FIntPoint> Cells;
+	Values.GetKeys(Cells);
+	for (int32 Index = 0; Index < Cells.Num(); Index += 3)
+	{
+		ChunkSystem->TryRemoveChannel(Handle, Cells[Index]);
+		Values.Remove(Cells[Index]);
+	}
+
+	CheckRegions(TEXT("Removed"));
+
+	const FIntRect Cleared(-10, -10, 5, 5);
+	ChunkSystem->ClearRegion(Handle, Cleared);
+	for (auto It = Values.CreateIterator(); It; ++It)
+	{
+		if (Cleared.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	CheckRegions(TEXT("Cleared"));
+
+	// Values set by value update the kept summaries in place, const reads in between leave them alone.
+	FInstancedStruct Written = FInstancedStruct::Make<FData_UnitTest>();
+	for (int32 Index = 0; Index < 200; ++Index)
+	{
+		const FIntPoint Cell(Random.RandRange(-30, 30), Random.RandRange(-30, 30));
+		const int32 Value = Random.RandRange(-1000, 1000);
+		Written.GetMutablePtr<FData_UnitTest>()->Value = Value;
+		Values.Add(Cell, Value);
+
+		TestTrue(TEXT("Value is set"), ChunkSystem->SetChannelValue(Handle, Cell, Written));
+
+		const FInstancedStruct* const Read = AsConst(*ChunkSystem).GetChannel(Handle, Cell);
+		TestTrue(TEXT("Set value reads back"), Read && Read->Get<FData_UnitTest>().Value == Value);
+	}
+
+	CheckRegions(TEXT("Set"));
+
+	TestFalse(TEXT("Value of another type is rejected"),
+	          ChunkSystem->SetChannelValue(Handle, FIntPoint(0, 0), FInstancedStruct::Make<FData2_UnitTest>()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_OccupancyTest,
+                                 "SimpleChunkSystem.System.Occupancy",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_OccupancyTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Occupancy"));
+
+	TestTrue(TEXT("Empty channel"), ChunkSystem->IsRegionEmpty(Handle, FIntRect(-1000, -1000, 1000, 1000)));
+
+	// Sparse cells over many superchunks, on both sides of the origin.
+	FRandomStream Random(2024);
+	TSet<FIntPoint> Cells;
+	for (int32 Index = 0; Index < 120; ++Index)
+	{
+		const FIntPoint Cell(Random.RandRange(-300, 300), Random.RandRange(-300, 300));
+		Cells.Add(Cell);
+		ChunkSystem->FindOrAddChannel(Handle, Cell);
+	}
+
+	const auto CheckRegions = [this, &ChunkSystem, Handle, &Cells, &Random](const TCHAR* Step)
+	{
+		int32 NumMismatches = 0;
+		for (int32 Index = 0; Index < 300; ++Index)
+		{
+			const FIntPoint Min(Random.RandRange(-320, 320), Random.RandRange(-320, 320));
+			const int32 Extent = Index % 3 == 0 ? Random.RandRange(1, 6) : Random.RandRange(1, 200);
+			const FIntRect Region(Min, Min + FIntPoint(Extent, Random.RandRange(1, 200)));
+
+			bool bExpected = false;
+			for (const FIntPoint& Cell : Cells)
+			{
+				bExpected |= Region.Contains(Cell);
+			}
+
+			NumMismatches += ChunkSystem->HasAnyInRegion(Handle, Region) != bExpected;
+		}
+
+		TestEqual(FString::Printf(TEXT("%s, random regions"), Step), NumMismatches, 0);
+	};
+
+	CheckRegions(TEXT("Added"));
+
+	// A region holding a single cell, fully inside one chunk and across the borders of chunks.
+	const FIntPoint Single = *Cells.CreateConstIterator();
+	TestTrue(TEXT("Single cell"), ChunkSystem->HasAnyInRegion(Handle, FIntRect(Single, Single + FIntPoint(1, 1))));
+	TestTrue(TEXT("Around single cell"),
+	         ChunkSystem->HasAnyInRegion(Handle, FIntRect(Single - FIntPoint(5, 5), Single + FIntPoint(6, 6))));
+	TestFalse(TEXT("Empty region"), ChunkSystem->HasAnyInRegion(Handle, FIntRect(Single, Single)));
+
+	// Removing cells and whole chunks keeps the superchunk counts in step.
+	TArray<FIntPoint> CellArray = Cells.Array();
+	for (int32 Index = 0; Index < CellArray.Num(); Index += 2)
+	{
+		ChunkSystem->TryRemoveChannel(Handle, CellArray[Index]);
+		Cells.Remove(CellArray[Index]);
+	}
+
+	CheckRegions(TEXT("Removed cells"));
+
+	for (int32 Index = 1; Index < CellArray.Num(); Index += 4)
+	{
+		const FIntPoint ChunkPoint = ChunkSystem->ConvertGlobalToChunkGrid(CellArray[Index]);
+		ChunkSystem->TryRemoveChunkByGrid(CellArray[Index]);
+		for (auto It = Cells.CreateIterator(); It; ++It)
+		{
+			if (ChunkSystem->ConvertGlobalToChunkGrid(*It) == ChunkPoint)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	CheckRegions(TEXT("Removed chunks"));
+
+	TestEqual(TEXT("Count skips empty superchunks"), ChunkSystem->CountRegion(Handle, FIntRect(-400, -400, 400, 400)),
+	          Cells.Num());
+
+	ChunkSystem->Empty();
+	TestTrue(TEXT("Emptied"), ChunkSystem->IsRegionEmpty(Handle, FIntRect(-1000, -1000, 1000, 1000)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_FilterTest,
+                                 "SimpleChunkSystem.System.Filter",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_FilterTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Filter"));
+
+	const auto IsMultipleOfThree = [](const FIntPoint&, const FData_UnitTest& Data)
+	{
+		return Data.Value % 3 == 0;
+	};
+
+	TestTrue(TEXT("Empty channel"), ChunkSystem->FilterChannel<FData_UnitTest>(Handle, IsMultipleOfThree).IsEmpty());
+
+	FRandomStream Random(31337);
+	TMap<FIntPoint, int32> Values;
+	for (int32 Index = 0; Index < 2000; ++Index)
+	{
+		const FIntPoint Cell(Random.RandRange(-60, 60), Random.RandRange(-60, 60));
+		const int32 Value = Random.RandRange(0, 1000);
+		ChunkSystem->FindOrAddChannel(Handle, Cell).GetMutablePtr<FData_UnitTest>()->Value = Value;
+		Values.Add(Cell, Value);
+	}
+
+	TSet<FIntPoint> Expected;
+	for (const TPair<FIntPoint, int32>& Value : Values)
+	{
+		if (Value.Value % 3 == 0)
+		{
+			Expected.Add(Value.Key);
+		}
+	}
+
+	const TArray<FIntPoint> Found = ChunkSystem->FilterChannel<FData_UnitTest>(Handle, IsMultipleOfThree);
+	TestEqual(TEXT("Number of matches"), Found.Num(), Expected.Num());
+	TestTrue(TEXT("Same cells"), TSet<FIntPoint>(Found).Difference(Expected).IsEmpty());
+
+	// The order does not depend on how the chunks were scheduled.
+	const TArray<FIntPoint> Serial = ChunkSystem->FilterChannel<FData_UnitTest>(
+		Handle, IsMultipleOfThree, EParallelForFlags::ForceSingleThread);
+	TestTrue(TEXT("Deterministic order"), Found == Serial);
+
+	TestEqual(TEXT("Count"), ChunkSystem->CountChannelIf<FData_UnitTest>(Handle, IsMultipleOfThree), Expected.Num());
+
+	// The predicate sees the cell as well as the value.
+	const TArray<FIntPoint> Positive = ChunkSystem->FilterChannel<FData_UnitTest>(
+		Handle, [](const FIntPoint& Cell, const FData_UnitTest&) { return Cell.X > 0 && Cell.Y > 0; });
+	bool bAllPositive = true;
+	for (const FIntPoint& Cell : Positive)
+	{
+		bAllPositive &= Cell.X > 0 && Cell.Y > 0;
+	}
+	TestTrue(TEXT("Cell predicate"), bAllPositive && !Positive.IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_ParallelForEachTest,
+                                 "SimpleChunkSystem.System.ParallelForEach",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_ParallelForEachTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("ParallelForEach"));
+	ChunkSystem->AddAggregateField(Handle, TEXT("Value"));
+
+	FRandomStream Random(99);
+	TMap<FIntPoint, int32> Values;
+	for (int32 Index = 0; Index < 3000; ++Index)
+	{
+		const FIntPoint Cell(Random.RandRange(-80, 80), Random.RandRange(-80, 80));
+		const int32 Value = Random.RandRange(-50, 50);
+		ChunkSystem->FindOrAddChannel(Handle, Cell).GetMutablePtr<FData_UnitTest>()->Value = Value;
+		Values.Add(Cell, Value);
+	}
+
+	// Keeps the aggregates of every chunk before the sweep, the sweep has to mark them stale.
+	const FIntRect Everything(-100, -100, 100, 100);
+	ChunkSystem->AggregateRegion(Handle, Everything);
+
+	std::atomic<int32> NumVisited{0};
+	ChunkSystem->ParallelForEachChannel<FData_UnitTest>(Handle, [&NumVisited](const FIntPoint& Cell,
+	                                                                          FData_UnitTest& Data)
+	{
+		Data.Value += Cell.X * 2 - Cell.Y;
+		NumVisited.fetch_add(1, std::memory_order_relaxed);
+	});
+
+	TestEqual(TEXT("Every cell visited once"), NumVisited.load(), Values.Num());
+	TestTrue(TEXT("Directory unlocked after the sweep"), ChunkSystem->TryMakeChunkByGrid(FIntPoint(1000, 1000)));
+
+	int32 NumWrong = 0;
+	int64 ExpectedSum = 0;
+	for (const TPair<FIntPoint, int32>& Value : Values)
+	{
+		const int32 Expected = Value.Value + Value.Key.X * 2 - Value.Key.Y;
+		const FInstancedStruct* const Struct = ChunkSystem->GetChannel(Handle, Value.Key);
+		NumWrong += !Struct || Struct->Get<FData_UnitTest>().Value != Expected;
+		ExpectedSum += Expected;
+	}
+
+	TestEqual(TEXT("Values written"), NumWrong, 0);
+	TestEqual(TEXT("Aggregates see the writes"), ChunkSystem->AggregateRegion(Handle, Everything).Sum,
+	          static_cast<double>(ExpectedSum));
+
+	// A missing channel is a no-op.
+	ChunkSystem->ParallelForEachChannel<FData_UnitTest>(
+		FCellChannelHandle(), [&NumVisited](const FIntPoint&, FData_UnitTest&) { NumVisited.fetch_add(1); });
+	TestEqual(TEXT("Missing channel"), NumVisited.load(), Values.Num());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_FilterBenchmarkTest,
+                                 "SimpleChunkSystem.Benchmark.Filter",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+FORCEINLINE bool FChunk_FilterBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 16;
+	constexpr int32 Extent = 1024;
+	constexpr int32 NumPasses = 4;
+
+	// A million cells, one value each.
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("FilterBenchmark"));
+
+	FRandomStream Random(1337);
+	for (int32 X = 0; X < Extent; ++X)
+	{
+		for (int32 Y = 0; Y < Extent; ++Y)
+		{
+			ChunkSystem->FindOrAddChannel(Handle, FIntPoint(X, Y)).GetMutablePtr<FData_UnitTest>()->Value =
+				Random.RandRange(0, 1000);
+		}
+	}
+
+	const auto IsRare = [](const FIntPoint&, const FData_UnitTest& Data)
+	{
+		return Data.Value % 97 == 0;
+	};
+
+	const auto Run = [&ChunkSystem, Handle, &IsRare](const EParallelForFlags Flags, const int32 MaxTasks,
+	                                                 int32& OutNumFound)
+	{
+		const double Start = FPlatformTime::Seconds();
+
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			OutNumFound = ChunkSystem->FilterChannel<FData_UnitTest>(Handle, IsRare, Flags, MaxTasks).Num();
+		}
+
+		return (FPlatformTime::Seconds() - Start) * 1000.0 / NumPasses;
+	};
+
+	int32 NumSerial = 0;
+	const double SerialMs = Run(EParallelForFlags::ForceSingleThread, 0, NumSerial);
+
+	AddInfo(FString::Printf(TEXT("%d cells: single thread %.2f ms"), Extent * Extent, SerialMs));
+
+	// Scaling curve, the calling thread takes part next to the workers.
+	const int32 NumThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	TArray<int32> TaskLimits = {1, 2, 4};
+	TaskLimits.RemoveAll([NumThreads](const int32 Limit)
+	{
+		return Limit >= NumThreads;
+	});
+	TaskLimits.Add(NumThreads);
+
+	for (const int32 MaxTasks : TaskLimits)
+	{
+		int32 NumParallel = 0;
+		const double ParallelMs = Run(EParallelForFlags::None, MaxTasks, NumParallel);
+
+		TestEqual(FString::Printf(TEXT("%d tasks find the same cells"), MaxTasks), NumParallel, NumSerial);
+		AddInfo(FString::Printf(TEXT("%d cells, %d tasks: parallel %.2f ms, speedup %.2fx"), Extent * Extent,
+		                        MaxTasks, ParallelMs, ParallelMs > 0.0 ? SerialMs / ParallelMs : 0.0));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_LazyIteratorTest,
+                                 "SimpleChunkSystem.System.LazyIterator",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_LazyIteratorTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("LazyIterator"));
+
+	// The iterators only hold pointers and indices, nothing they could allocate or free.
+	using FRange = decltype(ChunkSystem->IterateChannel<FData_UnitTest>(Handle));
+	using FConstRange = decltype(AsConst(*ChunkSystem).IterateChannel<FData_UnitTest>(Handle));
+	static_assert(std::is_trivially_destructible_v<decltype(std::declval<FRange>().begin())>);
+	static_assert(std::is_trivially_destructible_v<decltype(std::declval<FConstRange>().begin())>);
+	static_assert(std::is_trivially_destructible_v<FRange> && std::is_trivially_destructible_v<FConstRange>);
+
+	{
+		auto Range = ChunkSystem->IterateChannel<FData_UnitTest>(Handle);
+		TestTrue(TEXT("Empty channel"), Range.IsEmpty() && !(Range.begin() != Range.end()));
+	}
+
+	// Cells in both the dense and the map layout of chunks, some chunks emptied again.
+	FRandomStream Random(5150);
+	TMap<FIntPoint, int32> Values;
+	for (int32 Index = 0; Index < 1500; ++Index)
+	{
+		const FIntPoint Cell(Random.RandRange(-40, 40), Random.RandRange(-40, 40));
+		const int32 Value = Random.RandRange(0, 1000);
+		ChunkSystem->FindOrAddChannel(Handle, Cell).GetMutablePtr<FData_UnitTest>()->Value = Value;
+		Values.Add(Cell, Value);
+	}
+
+	for (int32 Index = 0; Index < 30; ++Index)
+	{
+		const FIntPoint Cell(Random.RandRange(100, 200), Random.RandRange(100, 200));
+		ChunkSystem->FindOrAddChannel(Handle, Cell).GetMutablePtr<FData_UnitTest>()->Value = Index;
+		Values.Add(Cell, Index);
+	}
+
+	TArray<FIntPoint> Cells;
+	Values.GetKeys(Cells);
+	for (int32 Index = 0; Index < Cells.Num(); Index += 5)
+	{
+		ChunkSystem->TryRemoveChannel(Handle, Cells[Index]);
+		Values.Remove(Cells[Index]);
+	}
+
+	// Writes through the mutable range, then reads through the const one.
+	int32 NumVisited = 0;
+	for (const auto Entry : ChunkSystem->IterateChannel<FData_UnitTest>(Handle))
+	{
+		Entry.Value.Value += 1;
+		++NumVisited;
+	}
+
+	TestEqual(TEXT("Mutable range visits every cell"), NumVisited, Values.Num());
+
+	TSet<FIntPoint> Seen;
+	int32 NumWrong = 0;
+	for (const auto Entry : AsConst(*ChunkSystem).IterateChannel<FData_UnitTest>(Handle))
+	{
+		const int32* const Expected = Values.Find(Entry.Key);
+		NumWrong += !Expected || *Expected + 1 != Entry.Value.Value;
+
+		bool bAlreadySeen = false;
+		Seen.Add(Entry.Key, &bAlreadySeen);
+		NumWrong += bAlreadySeen;
+	}
+
+	TestEqual(TEXT("Const range reads the written values once each"), NumWrong, 0);
+	TestEqual(TEXT("Const range visits every cell"), Seen.Num(), Values.Num());
+
+	// Copies of an iterator advance independently.
+	{
+		auto Range = ChunkSystem->IterateChannel<FData_UnitTest>(Handle);
+		auto First = Range.begin();
+		auto Second = First;
+		++Second;
+		TestTrue(TEXT("Copied iterator keeps its position"), First != Second && (*First).Key != (*Second).Key);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_ChannelReferenceTest,
+                                 "SimpleChunkSystem.System.ChannelReference",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_ChannelReferenceTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Chunks start adaptive"), ChunkSystem->GetStorageSettings().Storage == EChunkCellStorage::Adaptive);
+
+	const FCellChannelHandle Handle = ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Reference"));
+	const FCellChannelHandle OtherHandles[] = {
+		ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Reference_A")),
+		ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Reference_B")),
+		ChunkSubsystemUnitTest::MakeUniqueChannel<FData_UnitTest>(TEXT("Reference_C")),
+	};
+
+	// Hold the struct memory of the channel, the FInstancedStruct wrapper itself is about to move.
+	FInstancedStruct& Channel = ChunkSystem->FindOrAddChannel(Handle, FIntPoint(0, 0));
+	FData_UnitTest* const Held = Channel.GetMutablePtr<FData_UnitTest>();
+	Held->Value = 42;
+
+	// Spill the cell past its inline channels, then occupy enough cells to promote the chunk to dense.
+	for (const FCellChannelHandle OtherHandle : OtherHandles)
+	{
+		ChunkSystem->FindOrAddChannel(OtherHandle, FIntPoint(0, 0));
+	}
+	for (int32 Index = 1; Index < ChunkSize * ChunkSize; ++Index)
+	{
+		ChunkSystem->FindOrAddChannel(Handle, FIntPoint(Index / ChunkSize, Index % ChunkSize));
+	}
+
+	FInstancedStruct* const Moved = ChunkSystem->GetChannel(Handle, FIntPoint(0, 0));
+	TestNotNull(TEXT("Channel survives the layout changes"), Moved);
+	TestTrue(TEXT("Struct memory did not move"), Moved && Moved->GetMutablePtr<FData_UnitTest>() == Held);
+	TestEqual(TEXT("Held value is intact"), Held->Value, 42);
+
+	// Demoting back to the map layout moves every cell again.
+	for (int32 Index = 1; Index < ChunkSize * ChunkSize; ++Index)
+	{
+		ChunkSystem->TryRemoveChannel(Handle, FIntPoint(Index / ChunkSize, Index % ChunkSize));
+	}
+
+	FInstancedStruct* const Demoted = ChunkSystem->GetChannel(Handle, FIntPoint(0, 0));
+	TestTrue(TEXT("Struct memory survives demotion"), Demoted && Demoted->GetMutablePtr<FData_UnitTest>() == Held);
+	TestEqual(TEXT("Held value survives demotion"), Held->Value, 42);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_ColumnIndexTest,
+                                 "SimpleChunkSystem.System.ColumnIndex",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_ColumnIndexTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<TChunkSystem_DynamicData<>> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	const FName ColumnName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("ColumnIndex"));
+	const FName ChannelName = ChunkSubsystemUnitTest::MakeUniqueKey(TEXT("ColumnIndex_Boxed"));
+
+	// Chunks with only boxed channels must not be visited by column sweeps.
+	for (int32 X = 0; X < 64; ++X)
+	{
+		ChunkSystem->FindOrAddChannel<FData_UnitTest>(ChannelName, FIntPoint(X * ChunkSize, 0));
+	}
+
+	ChunkSystem->FindOrAddColumnValue<FData_UnitTest>(ColumnName, FIntPoint(1, 1)).Value = 1;
+	ChunkSystem->FindOrAddColumnValue<FData_UnitTest>(ColumnName, FIntPoint(2, 1)).Value = 2;
+	ChunkSystem->FindOrAddColumnValue<FData_UnitTest>(ColumnName, FIntPoint(-9, 5)).Value = 3;
+
+	TestFalse(TEXT("Columns are a separate store"),
+	          ChunkSystem->HasChannel<FData_UnitTest>(ColumnName, FIntPoint(1, 1)));
+
+	int32 Sum = 0;
+	int32 Visited = 0;
+	ChunkSystem->ForEachColumnValue<FData_UnitTest>(ColumnName, [&Sum, &Visited](const FIntPoint&, FData_UnitTest& Value)
+	{
+		Sum += Value.Value;
+		++Visited;
+	});
+	TestEqual(TEXT("Sweep visits every column value"), Visited, 3);
+	TestEqual(TEXT("Sweep sees the written values"), Sum, 6);
+
+	// The chunk leaves the index with its last value, and with the chunk itself.
+	TestTrue(TEXT("Removed column value"),
+	         ChunkSystem->TryRemoveColumnValue<FData_UnitTest>(ColumnName, FIntPoint(-9, 5)));
+	TestTrue(TEXT("Removed chunk"), ChunkSystem->TryRemoveChunkByGrid(FIntPoint(1, 1)));
+
+	Visited = 0;
+	ChunkSystem->ForEachColumnValue<FData_UnitTest>(ColumnName, [&Visited](const FIntPoint&, FData_UnitTest&)
+	{
+		++Visited;
+	});
+	TestEqual(TEXT("Nothing left to visit"), Visited, 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkSystem_TypedTest,
+                                 "SimpleChunkSystem.System.Typed",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+FORCEINLINE bool FChunk_ChunkSystem_TypedTest::RunTest(const FString& Parameters)
+{
+	using FTypedSystem = TChunkSystem_Typed<FData_UnitTest, FData2_UnitTest, FDataArray_UnitTest>;
+
+	constexpr int32 ChunkSize = 4;
+	const TUniquePtr<FTypedSystem> ChunkSystem = ChunkSubsystemUnitTest::MakeTestSystem<FTypedSystem>(*this, ChunkSize);
+	if (!ChunkSystem)
+	{
+		return false;
+	}
+
+	for (int32 Index = -5; Index <= 5; ++Index)
+	{
+		ChunkSystem->FindOrAddChannel<FData_UnitTest>(FIntPoint(Index, -Index)).Value = Index;
+	}
+	ChunkSystem->FindOrAddChannel<FData2_UnitTest>(FIntPoint(2, -2)).Value2 = 22;
+	ChunkSystem->FindOrAddChannel<FDataArray_UnitTest>(FIntPoint(-3, 3)).Values = {1, 2, 3};
+
+	TestEqual(TEXT("Typed channel count"), ChunkSystem->NumChannels<FData_UnitTest>(), 11);
+	TestTrue(TEXT("Channels are per type"), ChunkSystem->HasChannel<FData2_UnitTest>(FIntPoint(2, -2)) &&
+	         !ChunkSystem->HasChannel<FData2_UnitTest>(FIntPoint(3, -3)));
+
+	const FData_UnitTest* Value = ChunkSystem->GetChannel<FData_UnitTest>(FIntPoint(-4, 4));
+	TestTrue(TEXT("Typed value"), Value && Value->Value == -4);
+
+	int32 Sum = 0;
+	ChunkSystem->ForEachChannel<FData_UnitTest>([&Sum](const FIntPoint& Cell, const FData_UnitTest& Data)
+	{
+		Sum += Data.Value + Cell.Y;
+	});
+	TestEqual(TEXT("Iteration visits each cell once with its location"), Sum, 0);
+
+	TestTrue(TEXT("Removed typed value"), ChunkSystem->TryRemoveChannel<FData_UnitTest>(FIntPoint(5, -5)));
+	TestFalse(TEXT("Removed once"), ChunkSystem->TryRemoveChannel<FData_UnitTest>(FIntPoint(5, -5)));
+	TestNull(TEXT("Removed value is gone"), ChunkSystem->GetChannel<FData_UnitTest>(FIntPoint(5, -5)));
+
+	TArray<uint8> Bytes;
+	{
+		FMemoryWriter Writer(Bytes, true);
+		ChunkSystem->Serialize(Writer);
+	}
+
+	const TUniquePtr<FTypedSystem> Loaded = ChunkSubsystemUnitTest::MakeTestSystem<FTypedSystem>(*this, ChunkSize);
+	{
+		FMemoryReader Reader(Bytes, true);
+		Loaded->Serialize(Reader);
+	}
+
+	TestEqual(TEXT("Loaded chunk count"), Loaded->Num(), ChunkSystem->Num());
+	TestEqual(TEXT("Loaded channel count"), Loaded->NumChannels<FData_UnitTest>(), 10);
+	const FData2_UnitTest* Loaded2 = Loaded->GetChannel<FData2_UnitTest>(FIntPoint(2, -2));
+	TestTrue(TEXT("Loaded second channel"), Loaded2 && Loaded2->Value2 == 22);
+	const FDataArray_UnitTest* LoadedArray = Loaded->GetChannel<FDataArray_UnitTest>(FIntPoint(-3, 3));
+	TestTrue(TEXT("Loaded array channel"), LoadedArray && LoadedArray->Values == TArray<int32>({1, 2, 3}));
+
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChunk_ChunkManager_DynamicDataTest,
                                  "SimpleChunkSystem.Manager.DynamicData",
                                  EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)